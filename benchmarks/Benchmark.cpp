@@ -0,0 +1,229 @@
+#include "Benchmark.h"
+#include "AllocTracker.h"
+#include "XZZPCBGenerator.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace {
+    std::atomic<uint64_t> consumed{0};
+
+    std::string EscapeJson(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    const size_t kTagCount = static_cast<size_t>(AllocTag::Count);
+    using TagStatsArray = std::array<AllocTracker::TagStats, kTagCount>;
+
+    TagStatsArray GetAllTagStats() {
+        TagStatsArray stats;
+        for (size_t i = 0; i < kTagCount; ++i) {
+            stats[i] = AllocTracker::GetTagStats(static_cast<AllocTag>(i));
+        }
+        return stats;
+    }
+
+    void AddTagStatsSince(const TagStatsArray& before, TagStatsArray& totals) {
+        TagStatsArray now = GetAllTagStats();
+        for (size_t i = 0; i < kTagCount; ++i) {
+            totals[i].allocations += now[i].allocations - before[i].allocations;
+            totals[i].bytes += now[i].bytes - before[i].bytes;
+        }
+    }
+}
+
+double BenchmarkResult::GetMegabytesPerSecond() const {
+    return median_ms > 0.0 ? bytes_per_iteration / (1024.0 * 1024.0) / (median_ms / 1000.0) : 0.0;
+}
+
+double BenchmarkResult::GetItemsPerSecond() const {
+    return median_ms > 0.0 ? items_per_iteration / (median_ms / 1000.0) : 0.0;
+}
+
+BenchmarkRunner::BenchmarkRunner(const Options& runner_options) : options(runner_options) {
+}
+
+bool BenchmarkRunner::IsSelected(const std::string& name) const {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+void BenchmarkRunner::Consume(uint64_t value) {
+    consumed.fetch_xor(value, std::memory_order_relaxed);
+}
+
+void BenchmarkRunner::AddNote(const std::string& key, const std::string& value) {
+    notes.push_back({key, value});
+}
+
+void BenchmarkRunner::Run(const std::string& name, const std::function<void()>& body,
+                          double bytes_per_iteration, double items_per_iteration, const char* item_unit,
+                          const std::function<void()>& setup) {
+    if (!IsSelected(name)) {
+        return;
+    }
+
+    // One warm-up iteration: first-touch page faults and cache growth are not measured
+    if (setup) {
+        setup();
+    }
+    body();
+
+    // Allocations of the timed bodies only; the counters are read outside the timed region
+    const bool track_allocations = AllocTracker::IsEnabled();
+    TagStatsArray allocated{};
+    TagStatsArray before{};
+
+    std::vector<double> samples;
+    double total_s = 0.0;
+    while ((total_s < options.min_time_s || samples.size() < options.min_iterations) &&
+           samples.size() < options.max_iterations) {
+        if (setup) {
+            setup();
+        }
+        if (track_allocations) {
+            before = GetAllTagStats();
+        }
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (track_allocations) {
+            AddTagStatsSince(before, allocated);
+        }
+        samples.push_back(elapsed_s * 1000.0);
+        total_s += elapsed_s;
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = samples.size();
+    result.bytes_per_iteration = bytes_per_iteration;
+    result.items_per_iteration = items_per_iteration;
+    result.item_unit = item_unit ? item_unit : "items";
+    std::sort(samples.begin(), samples.end());
+    result.min_ms = samples.front();
+    result.median_ms = samples[samples.size() / 2];
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    result.mean_ms = sum / samples.size();
+    for (size_t i = 0; i < kTagCount && track_allocations; ++i) {
+        if (allocated[i].allocations > 0) {
+            result.allocations.push_back({AllocTracker::GetTagName(static_cast<AllocTag>(i)),
+                                          static_cast<double>(allocated[i].allocations) / samples.size(),
+                                          static_cast<double>(allocated[i].bytes) / samples.size()});
+        }
+    }
+
+    std::printf("%-44s %8zu it  median %10.4f ms  min %10.4f ms", name.c_str(), result.iterations,
+                result.median_ms, result.min_ms);
+    if (bytes_per_iteration > 0.0) {
+        std::printf("  %9.1f MB/s", result.GetMegabytesPerSecond());
+    }
+    if (items_per_iteration > 0.0) {
+        std::printf("  %12.0f %s/s", result.GetItemsPerSecond(), result.item_unit.c_str());
+    }
+    std::printf("\n");
+    for (const auto& tag : result.allocations) {
+        std::printf("    %-12s %12.1f allocs/it  %14.0f bytes/it\n", tag.tag.c_str(), tag.allocations, tag.bytes);
+    }
+    std::fflush(stdout);
+
+    results.push_back(result);
+}
+
+bool BenchmarkRunner::WriteJson(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "{\n  \"context\": {";
+    for (size_t i = 0; i < notes.size(); ++i) {
+        file << (i ? "," : "") << "\n    \"" << EscapeJson(notes[i].first) << "\": \"" << EscapeJson(notes[i].second) << "\"";
+    }
+    file << "\n  },\n  \"results\": [";
+    char line[512];
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        std::snprintf(line, sizeof(line),
+                      "%s\n    {\"name\": \"%s\", \"iterations\": %zu, \"median_ms\": %.6f, \"min_ms\": %.6f, \"mean_ms\": %.6f, "
+                      "\"bytes\": %.0f, \"mb_per_s\": %.3f, \"items\": %.0f, \"item_unit\": \"%s\", \"items_per_s\": %.1f",
+                      i ? "," : "", EscapeJson(r.name).c_str(), r.iterations, r.median_ms, r.min_ms, r.mean_ms,
+                      r.bytes_per_iteration, r.GetMegabytesPerSecond(), r.items_per_iteration, r.item_unit.c_str(),
+                      r.GetItemsPerSecond());
+        file << line;
+        if (!r.allocations.empty()) {
+            file << ", \"allocations\": {";
+            for (size_t t = 0; t < r.allocations.size(); ++t) {
+                std::snprintf(line, sizeof(line), "%s\"%s\": {\"count\": %.1f, \"bytes\": %.0f}", t ? ", " : "",
+                              EscapeJson(r.allocations[t].tag).c_str(), r.allocations[t].allocations, r.allocations[t].bytes);
+                file << line;
+            }
+            file << "}";
+        }
+        file << "}";
+    }
+    file << "\n  ]\n}\n";
+    return !file.fail();
+}
+
+bool BenchmarkRunner::CompareWith(const std::string& baseline_path) const {
+    std::ifstream file(baseline_path);
+    if (!file.is_open()) {
+        std::fprintf(stderr, "Cannot read baseline %s\n", baseline_path.c_str());
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    // Only reads back what WriteJson writes: "name" followed by "median_ms" in each result
+    std::map<std::string, double> baseline;
+    size_t pos = 0;
+    const std::string name_key = "\"name\": \"";
+    const std::string median_key = "\"median_ms\": ";
+    while ((pos = text.find(name_key, pos)) != std::string::npos) {
+        pos += name_key.size();
+        size_t name_end = text.find('"', pos);
+        size_t median = text.find(median_key, name_end);
+        if (name_end == std::string::npos || median == std::string::npos) {
+            break;
+        }
+        baseline[text.substr(pos, name_end - pos)] = std::atof(text.c_str() + median + median_key.size());
+        pos = median;
+    }
+
+    std::printf("\nComparison with %s (baseline / current median; > 1 is faster)\n", baseline_path.c_str());
+    for (const auto& result : results) {
+        auto it = baseline.find(result.name);
+        if (it == baseline.end() || result.median_ms <= 0.0) {
+            std::printf("%-44s %10s\n", result.name.c_str(), "new");
+            continue;
+        }
+        std::printf("%-44s %9.2fx  (%.4f -> %.4f ms)\n", result.name.c_str(), it->second / result.median_ms,
+                    it->second, result.median_ms);
+    }
+    return true;
+}
+
+std::vector<char> GenerateBenchmarkBoard(uint64_t pin_count, bool json_trailer, uint32_t net_count) {
+    XZZPCBGenerator::Options options;
+    options.pin_count = pin_count;
+    options.net_count = net_count ? net_count : static_cast<uint32_t>(std::max<uint64_t>(pin_count / 5, 16));
+    options.test_pad_count = static_cast<uint32_t>(std::min<uint64_t>(pin_count / 20, 5000));
+    options.json_trailer = json_trailer;
+    XZZPCBGenerator generator(options);
+    return generator.Generate();
+}
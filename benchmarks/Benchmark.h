@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness: repeats a body until a minimum time has passed, reports the
+// median/min/mean iteration time and throughput, and writes everything to JSON so runs of
+// different builds can be compared (--compare).
+struct BenchmarkResult {
+    std::string name;
+    size_t iterations = 0;
+    double min_ms = 0.0;
+    double median_ms = 0.0;
+    double mean_ms = 0.0;
+    double bytes_per_iteration = 0.0;   // 0 = no byte throughput
+    double items_per_iteration = 0.0;   // 0 = no item throughput
+    std::string item_unit;
+
+    // Heap allocations per measured iteration by PCB_ALLOC_SCOPE tag; empty unless the build
+    // tracks allocations (PCB_ALLOC_TRACKING)
+    struct TagAllocations {
+        std::string tag;
+        double allocations = 0.0;
+        double bytes = 0.0;
+    };
+    std::vector<TagAllocations> allocations;
+
+    double GetMegabytesPerSecond() const;
+    double GetItemsPerSecond() const;
+};
+
+class BenchmarkRunner {
+public:
+    struct Options {
+        double min_time_s = 0.5;
+        size_t min_iterations = 3;
+        size_t max_iterations = 10000;
+        std::string filter;             // Substring; empty runs everything
+    };
+
+    explicit BenchmarkRunner(const Options& options);
+
+    bool IsSelected(const std::string& name) const;
+
+    // Times `body` per iteration. `setup`, when given, runs untimed before every iteration.
+    void Run(const std::string& name, const std::function<void()>& body,
+             double bytes_per_iteration = 0.0, double items_per_iteration = 0.0, const char* item_unit = "items",
+             const std::function<void()>& setup = nullptr);
+
+    void AddNote(const std::string& key, const std::string& value);
+
+    const std::vector<BenchmarkResult>& GetResults() const { return results; }
+    bool WriteJson(const std::string& path) const;
+
+    // Prints median-time ratios against a JSON file written by an earlier run
+    bool CompareWith(const std::string& baseline_path) const;
+
+    // Keeps a computed value alive so the optimiser cannot drop the work
+    static void Consume(uint64_t value);
+
+private:
+    Options options;
+    std::vector<BenchmarkResult> results;
+    std::vector<std::pair<std::string, std::string>> notes;
+};
+
+// Generated input boards (fixed seed, so every run and build times the same bytes).
+// `net_count` 0 picks one net per five pins.
+std::vector<char> GenerateBenchmarkBoard(uint64_t pin_count, bool json_trailer, uint32_t net_count = 0);
+
+// Suites
+void RunParserBenchmarks(BenchmarkRunner& runner, const std::vector<uint64_t>& pin_counts);
+void RunRendererBenchmarks(BenchmarkRunner& runner, uint64_t pin_count, bool with_frames);
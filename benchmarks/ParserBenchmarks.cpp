@@ -0,0 +1,157 @@
+// Parser benchmarks: DES, the whole XZZPCB parse by board size, the net block and JSON aliases
+#include "Benchmark.h"
+#include "XZZPCBGenerator.h"
+#include "XZZPCBFile.h"
+#include "des.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+// Reaches the private parse stages (friend of XZZPCBFile)
+class ParserBenchmarkAccess {
+public:
+    static bool ParseXZZPCBOriginal(XZZPCBFile& file, std::vector<char>& buf) { return file.ParseXZZPCBOriginal(buf); }
+    static void DesDecrypt(XZZPCBFile& file, std::vector<char>& buf) { file.des_decrypt(buf); }
+    static void ParseNetBlock(XZZPCBFile& file, std::vector<char>& buf) { file.ParseNetBlockOriginal(buf); }
+    static void ParseJsonData(XZZPCBFile& file, std::vector<char>::iterator json_start, std::vector<char>& buf) {
+        file.ParseJsonData(json_start, buf);
+    }
+    static size_t GetNetCount(const XZZPCBFile& file) { return file.net_dict.size(); }
+    static size_t GetAliasCount(const XZZPCBFile& file) { return file.part_alias_dict.size(); }
+};
+
+namespace {
+    const uint64_t kDesKey = 0xDCFC12AC00000000ULL;
+
+    uint32_t ReadU32(const std::vector<char>& buf, size_t pos) {
+        uint32_t value = 0;
+        std::memcpy(&value, &buf[pos], sizeof(value));
+        return value;
+    }
+
+    // Undoes the header XOR of a generated board (no post-v6 trailer, so the whole file is XORed)
+    std::vector<char> DecodeXor(std::vector<char> buf) {
+        char key = buf[0x10];
+        if (key != 0) {
+            for (char& c : buf) {
+                c ^= key;
+            }
+        }
+        return buf;
+    }
+
+    void RunDesBenchmarks(BenchmarkRunner& runner) {
+        const size_t block_count = 65536;
+        runner.Run("des/block", [&] {
+            uint64_t value = 0x0123456789ABCDEFULL;
+            for (size_t i = 0; i < block_count; ++i) {
+                value = des(value, kDesKey, 'd');
+            }
+            BenchmarkRunner::Consume(value);
+        }, block_count * 8.0, static_cast<double>(block_count), "blocks");
+
+        // des_decrypt on 1 MB (content does not matter for the cipher's cost)
+        std::vector<char> source(1 << 20);
+        for (size_t i = 0; i < source.size(); ++i) {
+            source[i] = static_cast<char>(i * 131 + (i >> 8));
+        }
+        XZZPCBFile file;
+        std::vector<char> buf;
+        runner.Run("des/bulk_decrypt_1mb", [&] {
+            ParserBenchmarkAccess::DesDecrypt(file, buf);
+            BenchmarkRunner::Consume(static_cast<uint8_t>(buf[buf.size() / 2]));
+        }, static_cast<double>(source.size()), source.size() / 8.0, "blocks", [&] { buf = source; });
+    }
+
+    void RunParseBenchmarks(BenchmarkRunner& runner, uint64_t pin_count) {
+        std::string suffix = "/pins_" + std::to_string(pin_count);
+        if (!runner.IsSelected("parse/xzzpcb" + suffix) && !runner.IsSelected("parse/load" + suffix)) {
+            return;
+        }
+
+        std::vector<char> board = GenerateBenchmarkBoard(pin_count, false);
+        double board_bytes = static_cast<double>(board.size());
+        double pins = 0.0;
+        {
+            XZZPCBFile probe;
+            probe.Load(board);
+            pins = static_cast<double>(probe.pins.size());
+        }
+
+        // The parse proper on a fresh object and buffer copy (both prepared untimed)
+        std::unique_ptr<XZZPCBFile> file;
+        std::vector<char> buf;
+        runner.Run("parse/xzzpcb" + suffix, [&] {
+            BenchmarkRunner::Consume(ParserBenchmarkAccess::ParseXZZPCBOriginal(*file, buf));
+        }, board_bytes, pins, "pins", [&] {
+            file.reset();
+            file.reset(new XZZPCBFile());
+            buf = board;
+        });
+
+        // What the viewer pays: format check, buffer copy, parse and report
+        runner.Run("parse/load" + suffix, [&] {
+            BenchmarkRunner::Consume(file->Load(board));
+        }, board_bytes, pins, "pins", [&] {
+            file.reset();
+            file.reset(new XZZPCBFile());
+        });
+    }
+
+    void RunNetBlockBenchmark(BenchmarkRunner& runner) {
+        if (!runner.IsSelected("parse/net_block_20k")) {
+            return;
+        }
+        std::vector<char> board = DecodeXor(GenerateBenchmarkBoard(10000, false, 20000));
+        uint32_t net_start = ReadU32(board, 0x28) + 0x20;
+        uint32_t net_size = ReadU32(board, net_start);
+        std::vector<char> net_block(board.begin() + net_start + 4, board.begin() + net_start + 4 + net_size);
+
+        std::unique_ptr<XZZPCBFile> file;
+        std::vector<char> buf;
+        runner.Run("parse/net_block_20k", [&] {
+            ParserBenchmarkAccess::ParseNetBlock(*file, buf);
+            BenchmarkRunner::Consume(ParserBenchmarkAccess::GetNetCount(*file));
+        }, static_cast<double>(net_block.size()), 20000.0, "nets", [&] {
+            file.reset(new XZZPCBFile());
+            buf = net_block;
+        });
+    }
+
+    void RunJsonBenchmark(BenchmarkRunner& runner) {
+        if (!runner.IsSelected("parse/json_aliases")) {
+            return;
+        }
+        std::vector<char> board = DecodeXor(GenerateBenchmarkBoard(50000, true));
+        const unsigned char pattern[] = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, 0xB8, 0xBD, 0xBC, 0xD3, 0x0A};
+        auto found = std::search(board.begin(), board.end(), std::begin(pattern), std::end(pattern),
+                                 [](char a, unsigned char b) { return static_cast<unsigned char>(a) == b; });
+        if (found == board.end()) {
+            return;
+        }
+        size_t json_offset = static_cast<size_t>(found - board.begin()) + sizeof(pattern);
+        double json_bytes = static_cast<double>(board.size() - json_offset);
+
+        std::unique_ptr<XZZPCBFile> file(new XZZPCBFile());
+        ParserBenchmarkAccess::ParseJsonData(*file, board.begin() + json_offset, board);
+        double aliases = static_cast<double>(ParserBenchmarkAccess::GetAliasCount(*file));
+        runner.Run("parse/json_aliases", [&] {
+            ParserBenchmarkAccess::ParseJsonData(*file, board.begin() + json_offset, board);
+            BenchmarkRunner::Consume(ParserBenchmarkAccess::GetAliasCount(*file));
+        }, json_bytes, aliases, "aliases", [&] { file.reset(new XZZPCBFile()); });
+    }
+}
+
+void RunParserBenchmarks(BenchmarkRunner& runner, const std::vector<uint64_t>& pin_counts) {
+    // The DES key table is set up by the first Load
+    {
+        XZZPCBFile warm_up;
+        warm_up.Load(GenerateBenchmarkBoard(100, false));
+    }
+    RunDesBenchmarks(runner);
+    for (uint64_t pin_count : pin_counts) {
+        RunParseBenchmarks(runner, pin_count);
+    }
+    RunNetBlockBenchmark(runner);
+    RunJsonBenchmark(runner);
+}
@@ -0,0 +1,182 @@
+// Renderer benchmarks: cache builds, pin picking, label collection and whole frames into the
+// ImGui draw list. Frames need a GL context (hidden window); without one only the CPU-side
+// benchmarks run.
+#include "Benchmark.h"
+#include "PCBRenderer.h"
+#include "XZZPCBFile.h"
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <imgui.h>
+#include <cstdio>
+#include <memory>
+
+// Reaches the private cache builders (friend of PCBRenderer)
+class RendererBenchmarkAccess {
+public:
+    static void BuildPinGeometryCache(PCBRenderer& renderer) { renderer.BuildPinGeometryCache(); }
+    static size_t GetPartNameCount(const PCBRenderer& renderer) { return renderer.part_names_to_render.size(); }
+};
+
+namespace {
+    const int kWindowWidth = 1920;
+    const int kWindowHeight = 1080;
+    const size_t kPickQueries = 1024;
+
+    // Hidden window with a current GL 3.3 context; null when none can be created
+    GLFWwindow* CreateHiddenContext() {
+        if (!glfwInit()) {
+            return nullptr;
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+        GLFWwindow* window = glfwCreateWindow(kWindowWidth, kWindowHeight, "pcb_benchmarks", nullptr, nullptr);
+        if (!window) {
+            glfwTerminate();
+            return nullptr;
+        }
+        glfwMakeContextCurrent(window);
+        if (glewInit() != GLEW_OK) {
+            glfwDestroyWindow(window);
+            glfwTerminate();
+            return nullptr;
+        }
+        return window;
+    }
+
+    // ImGui without a platform/renderer backend: frames are built and finalised, never drawn
+    void CreateImGuiContext() {
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = ImVec2(static_cast<float>(kWindowWidth), static_cast<float>(kWindowHeight));
+        io.DeltaTime = 1.0f / 60.0f;
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    }
+
+    // Fixed pseudo-random screen positions, so every run picks at the same places
+    std::vector<ImVec2> MakePickPositions() {
+        std::vector<ImVec2> positions(kPickQueries);
+        uint32_t state = 12345;
+        for (auto& position : positions) {
+            state = state * 1664525u + 1013904223u;
+            position.x = static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * kWindowWidth;
+            state = state * 1664525u + 1013904223u;
+            position.y = static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * kWindowHeight;
+        }
+        return positions;
+    }
+
+    // Zooms so one board unit covers `pixels_per_unit` pixels, keeping the camera centre
+    void SetZoom(PCBRenderer& renderer, float pixels_per_unit) {
+        renderer.Zoom(pixels_per_unit / renderer.GetCamera().zoom);
+    }
+}
+
+void RunRendererBenchmarks(BenchmarkRunner& runner, uint64_t pin_count, bool with_frames) {
+    std::string suffix = "/pins_" + std::to_string(pin_count);
+    bool any_selected = false;
+    for (const char* name : {"render/pin_geometry_cache", "render/hovered_pin", "render/mouse_click",
+                             "render/collect_labels", "render/frame_fit", "render/frame_zoomed"}) {
+        any_selected = any_selected || runner.IsSelected(name + suffix);
+    }
+    if (!any_selected) {
+        return;
+    }
+
+    GLFWwindow* window = with_frames ? CreateHiddenContext() : nullptr;
+    if (with_frames && !window) {
+        std::printf("No GL context available: skipping the frame benchmarks\n");
+    }
+    runner.AddNote("render_gl_context", window ? "yes" : "no");
+    CreateImGuiContext();
+
+    auto board = std::make_shared<XZZPCBFile>();
+    if (!board->Load(GenerateBenchmarkBoard(pin_count, false))) {
+        std::printf("Benchmark board failed to load: %s\n", board->GetErrorMessage().c_str());
+        ImGui::DestroyContext();
+        return;
+    }
+    double pins = static_cast<double>(board->pins.size());
+
+    {
+        // Only the draw-list paths are measured: no pan cache (it would replay an image) and
+        // pads through the CPU passes, not the instanced GL renderer
+        PCBRenderer renderer;
+        renderer.GetSettings().pan_cache = false;
+        renderer.GetSettings().gpu_pads = false;
+        if (window) {
+            renderer.Initialize();
+        }
+        renderer.SetPCBData(board);
+        renderer.ZoomToFit(kWindowWidth, kWindowHeight);
+
+        runner.Run("render/pin_geometry_cache" + suffix, [&] {
+            RendererBenchmarkAccess::BuildPinGeometryCache(renderer);
+        }, 0.0, pins, "pins");
+
+        std::vector<ImVec2> positions = MakePickPositions();
+        SetZoom(renderer, 1.0f);
+        runner.Run("render/hovered_pin" + suffix, [&] {
+            int hits = 0;
+            for (const ImVec2& position : positions) {
+                hits += renderer.GetHoveredPin(position.x, position.y, kWindowWidth, kWindowHeight) >= 0;
+            }
+            BenchmarkRunner::Consume(static_cast<uint64_t>(hits));
+        }, 0.0, static_cast<double>(positions.size()), "queries");
+
+        runner.Run("render/mouse_click" + suffix, [&] {
+            int hits = 0;
+            for (const ImVec2& position : positions) {
+                hits += renderer.HandleMouseClick(position.x, position.y, kWindowWidth, kWindowHeight);
+            }
+            BenchmarkRunner::Consume(static_cast<uint64_t>(hits));
+        }, 0.0, static_cast<double>(positions.size()), "queries");
+
+        // Label collection measures text sizes, so it runs inside an ImGui frame
+        ImGui::NewFrame();
+        const Camera& camera = renderer.GetCamera();
+        float offset_x = kWindowWidth * 0.5f - camera.x * camera.zoom;
+        float offset_y = kWindowHeight * 0.5f + camera.y * camera.zoom;
+        runner.Run("render/collect_labels" + suffix, [&] {
+            renderer.CollectPartNamesForRendering(camera.zoom, offset_x, offset_y);
+            BenchmarkRunner::Consume(RendererBenchmarkAccess::GetPartNameCount(renderer));
+        }, 0.0, static_cast<double>(board->parts.size()), "parts");
+        ImGui::EndFrame();
+
+        if (window) {
+            // One ImGui frame per iteration; starting and finalising it is untimed
+            bool frame_open = false;
+            auto next_frame = [&] {
+                if (frame_open) {
+                    ImGui::Render();
+                }
+                ImGui::NewFrame();
+                frame_open = true;
+            };
+            auto frame = [&] {
+                renderer.Render(kWindowWidth, kWindowHeight);
+            };
+
+            renderer.ZoomToFit(kWindowWidth, kWindowHeight);
+            runner.Run("render/frame_fit" + suffix, frame, 0.0, pins, "pins", next_frame);
+            SetZoom(renderer, 1.0f);
+            runner.Run("render/frame_zoomed" + suffix, frame, 0.0, 0.0, "items", next_frame);
+            if (frame_open) {
+                ImGui::Render();
+            }
+        }
+    }
+
+    ImGui::DestroyContext();
+    if (window) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
+}
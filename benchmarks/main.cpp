@@ -0,0 +1,129 @@
+// pcb_benchmarks: times the parser and renderer hot paths on generated boards
+#include "AllocTracker.h"
+#include "Benchmark.h"
+#include "Log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void PrintUsage() {
+    std::printf(
+        "Usage: pcb_benchmarks [options]\n"
+        "  --filter <text>      Run only benchmarks whose name contains <text>\n"
+        "  --min-time <s>       Minimum measured time per benchmark (default 0.5)\n"
+        "  --sizes <n,n,...>    Pin counts of the parse benchmarks (default 1000,10000,100000)\n"
+        "  --render-pins <n>    Pin count of the renderer benchmark board (default 100000)\n"
+        "  --no-render          Skip the renderer benchmarks\n"
+        "  --no-frames          Skip the benchmarks that need a GL context\n"
+        "  --json <path>        Write the results as JSON\n"
+        "  --compare <path>     Compare with the JSON of an earlier run\n");
+}
+
+static std::vector<uint64_t> ParseSizes(const std::string& text) {
+    std::vector<uint64_t> sizes;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        uint64_t size = std::strtoull(item.c_str(), nullptr, 10);
+        if (size > 0) {
+            sizes.push_back(size);
+        }
+    }
+    return sizes;
+}
+
+static std::string GetCompilerName() {
+#if defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+    return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("gcc ") + __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner::Options options;
+    std::vector<uint64_t> sizes = {1000, 10000, 100000};
+    uint64_t render_pins = 100000;
+    bool run_render = true;
+    bool run_frames = true;
+    std::string json_path;
+    std::string compare_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && has_value) {
+            options.min_time_s = std::atof(argv[++i]);
+        } else if (arg == "--sizes" && has_value) {
+            sizes = ParseSizes(argv[++i]);
+        } else if (arg == "--render-pins" && has_value) {
+            render_pins = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--no-render") {
+            run_render = false;
+        } else if (arg == "--no-frames") {
+            run_frames = false;
+        } else if (arg == "--json" && has_value) {
+            json_path = argv[++i];
+        } else if (arg == "--compare" && has_value) {
+            compare_path = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // Per-load summaries would otherwise be printed (and timed) on every iteration
+    Log::SetLevel(LogLevel::Warning);
+
+    BenchmarkRunner runner(options);
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    runner.AddNote("timestamp", timestamp);
+    runner.AddNote("compiler", GetCompilerName());
+#ifdef NDEBUG
+    runner.AddNote("build", "release");
+#else
+    runner.AddNote("build", "debug");
+#endif
+    runner.AddNote("alloc_tracking", AllocTracker::IsEnabled() ? "on" : "off");
+    runner.AddNote("hardware_threads", std::to_string(std::thread::hardware_concurrency()));
+    runner.AddNote("min_time_s", std::to_string(options.min_time_s));
+
+    RunParserBenchmarks(runner, sizes);
+    if (run_render && render_pins > 0) {
+        RunRendererBenchmarks(runner, render_pins, run_frames);
+    }
+
+    if (!json_path.empty()) {
+        if (!runner.WriteJson(json_path)) {
+            std::fprintf(stderr, "Failed to write %s\n", json_path.c_str());
+            return 1;
+        }
+        std::printf("Results written to %s\n", json_path.c_str());
+    }
+    if (AllocTracker::IsEnabled()) {
+        // Whole run, per PCB_ALLOC_SCOPE tag, including the untimed setup and peak live bytes
+        std::printf("\n%s\n", AllocTracker::FormatReport("pcb_benchmarks").c_str());
+    }
+    if (!compare_path.empty() && !runner.CompareWith(compare_path)) {
+        return 1;
+    }
+    Log::Flush();
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include "pcbcore.h"
+#include "BoardIndex.h"
+#include "Log.h"
+#include "XZZPCBFile.h"
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+struct pcb_board {
+    std::unique_ptr<XZZPCBFile> file;
+    std::unique_ptr<BoardIndex> index;     // Only for loaded boards
+    std::string error;
+    std::string report_json;               // Built on first request
+};
+
+namespace {
+    int32_t ToSide(BRDPartMountingSide side) {
+        switch (side) {
+            case BRDPartMountingSide::Bottom: return PCB_SIDE_BOTTOM;
+            case BRDPartMountingSide::Top: return PCB_SIDE_TOP;
+            default: return PCB_SIDE_BOTH;
+        }
+    }
+
+    int32_t ToSide(BRDPinSide side) {
+        switch (side) {
+            case BRDPinSide::Bottom: return PCB_SIDE_BOTTOM;
+            case BRDPinSide::Top: return PCB_SIDE_TOP;
+            default: return PCB_SIDE_BOTH;
+        }
+    }
+
+    // Parses `buffer` into a new handle; exceptions never cross the C boundary
+    pcb_board* OpenBuffer(const std::vector<char>& buffer, const std::string& path) {
+        pcb_board* board = new (std::nothrow) pcb_board();
+        if (!board) {
+            return nullptr;
+        }
+        try {
+            board->file.reset(new XZZPCBFile());
+            if (board->file->Load(buffer, path)) {
+                board->index.reset(new BoardIndex(*board->file));
+            } else {
+                board->error = board->file->GetErrorMessage().empty() ? "Load failed" : board->file->GetErrorMessage();
+            }
+        } catch (const std::exception& e) {
+            board->index.reset();
+            board->error = std::string("Exception: ") + e.what();
+        }
+        return board;
+    }
+
+    bool IsLoaded(const pcb_board* board) {
+        return board && board->index;
+    }
+}
+
+extern "C" {
+
+const char* pcb_get_version(void) {
+    return "1.0.0";
+}
+
+void pcb_set_log_level(int level) {
+    if (level >= static_cast<int>(LogLevel::Debug) && level <= static_cast<int>(LogLevel::Off)) {
+        Log::SetLevel(static_cast<LogLevel>(level));
+    }
+}
+
+pcb_board* pcb_open_file(const char* path) {
+    if (!path) {
+        return nullptr;
+    }
+    std::unique_ptr<XZZPCBFile> file;
+    LoadReport report;
+    try {
+        file = XZZPCBFile::LoadFromFile(path, &report);
+    } catch (const std::exception& e) {
+        file.reset();
+        report.error = std::string("Exception: ") + e.what();
+    }
+
+    pcb_board* board = new (std::nothrow) pcb_board();
+    if (!board) {
+        return nullptr;
+    }
+    try {
+        if (file) {
+            board->file = std::move(file);
+            board->index.reset(new BoardIndex(*board->file));
+        } else {
+            board->error = report.error.empty() ? "Load failed" : report.error;
+            board->report_json = report.ToJson();
+        }
+    } catch (const std::exception& e) {
+        board->index.reset();
+        board->error = std::string("Exception: ") + e.what();
+    }
+    return board;
+}
+
+pcb_board* pcb_open_memory(const void* data, size_t size) {
+    if (!data && size > 0) {
+        return nullptr;
+    }
+    try {
+        const char* bytes = static_cast<const char*>(data);
+        return OpenBuffer(std::vector<char>(bytes, bytes + size), "");
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+void pcb_close(pcb_board* board) {
+    delete board;
+}
+
+int pcb_is_loaded(const pcb_board* board) {
+    return IsLoaded(board) ? 1 : 0;
+}
+
+const char* pcb_get_error(const pcb_board* board) {
+    return board ? board->error.c_str() : nullptr;
+}
+
+const char* pcb_get_load_report_json(pcb_board* board) {
+    if (!board) {
+        return nullptr;
+    }
+    if (board->report_json.empty() && board->file) {
+        try {
+            board->report_json = board->file->GetLoadReport().ToJson();
+        } catch (const std::exception&) {
+            return nullptr;
+        }
+    }
+    return board->report_json.c_str();
+}
+
+uint32_t pcb_get_part_count(const pcb_board* board) {
+    return IsLoaded(board) ? static_cast<uint32_t>(board->file->parts.size()) : 0;
+}
+
+uint32_t pcb_get_pin_count(const pcb_board* board) {
+    return IsLoaded(board) ? static_cast<uint32_t>(board->file->pins.size()) : 0;
+}
+
+uint32_t pcb_get_net_count(const pcb_board* board) {
+    return IsLoaded(board) ? board->index->GetNetCount() : 0;
+}
+
+int pcb_get_part(const pcb_board* board, uint32_t part, pcb_part_info* out) {
+    if (!IsLoaded(board) || !out || part >= board->file->parts.size()) {
+        return 0;
+    }
+    const BRDPart& source = board->file->parts[part];
+    out->name = board->file->GetCString(source.name);
+    out->mfgcode = board->file->GetCString(source.mfgcode);
+    out->x1 = source.p1.x;
+    out->y1 = source.p1.y;
+    out->x2 = source.p2.x;
+    out->y2 = source.p2.y;
+    BoardIndex::PinRange pins = board->index->GetPartPins(part);
+    if (source.p1.x == source.p2.x && source.p1.y == source.p2.y && pins.count > 0) {
+        // No box in the file (XZZPCB): use the extent of the pin centres
+        const BRDPoint& first = board->file->pins[pins.pins[0]].pos;
+        out->x1 = out->x2 = first.x;
+        out->y1 = out->y2 = first.y;
+        for (uint32_t i = 1; i < pins.count; ++i) {
+            const BRDPoint& pos = board->file->pins[pins.pins[i]].pos;
+            out->x1 = std::min(out->x1, pos.x);
+            out->y1 = std::min(out->y1, pos.y);
+            out->x2 = std::max(out->x2, pos.x);
+            out->y2 = std::max(out->y2, pos.y);
+        }
+    }
+    out->side = ToSide(source.mounting_side);
+    out->type = source.part_type == BRDPartType::ThroughHole ? PCB_PART_THROUGH_HOLE : PCB_PART_SMD;
+    out->pin_count = pins.count;
+    return 1;
+}
+
+int pcb_get_pin(const pcb_board* board, uint32_t pin, pcb_pin_info* out) {
+    if (!IsLoaded(board) || !out || pin >= board->file->pins.size()) {
+        return 0;
+    }
+    // Boards opened here keep their text, so the views stay valid until pcb_close()
+    const BRDPin& source = board->file->pins[pin];
+    out->name = board->file->GetPinName(pin).data();
+    out->net = board->file->GetCString(source.net);
+    out->comment = board->file->GetPinComment(pin).data();
+    out->x = source.pos.x;
+    out->y = source.pos.y;
+    out->radius = source.radius;
+    out->part = source.part >= 1 && source.part <= board->file->parts.size() ? source.part - 1 : PCB_NO_PART;
+    out->net_index = board->index->GetPinNet(pin);
+    out->side = ToSide(source.side);
+    return 1;
+}
+
+const char* pcb_get_net_name(const pcb_board* board, uint32_t net) {
+    if (!IsLoaded(board) || net >= board->index->GetNetCount()) {
+        return nullptr;
+    }
+    return board->index->GetNetName(net).c_str();
+}
+
+int64_t pcb_find_part(const pcb_board* board, const char* name) {
+    if (!IsLoaded(board) || !name) {
+        return -1;
+    }
+    uint32_t part = board->index->FindPart(name);
+    return part == BoardIndex::kNotFound ? -1 : static_cast<int64_t>(part);
+}
+
+int64_t pcb_find_net(const pcb_board* board, const char* name) {
+    if (!IsLoaded(board) || !name) {
+        return -1;
+    }
+    uint32_t net = board->index->FindNet(name);
+    return net == BoardIndex::kNotFound ? -1 : static_cast<int64_t>(net);
+}
+
+uint32_t pcb_get_part_pins(const pcb_board* board, uint32_t part, const uint32_t** pins) {
+    if (!IsLoaded(board) || !pins) {
+        return 0;
+    }
+    BoardIndex::PinRange range = board->index->GetPartPins(part);
+    *pins = range.pins;
+    return range.count;
+}
+
+uint32_t pcb_get_net_pins(const pcb_board* board, uint32_t net, const uint32_t** pins) {
+    if (!IsLoaded(board) || !pins) {
+        return 0;
+    }
+    BoardIndex::PinRange range = board->index->GetNetPins(net);
+    *pins = range.pins;
+    return range.count;
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ * pcbcore C interface: load a board and query its parts, pins and nets in-process.
+ *
+ * - Every function accepts a NULL board and then returns 0 / NULL / -1.
+ * - Strings returned by the library stay valid until pcb_close() and must not be freed.
+ * - Boards are independent: separate boards can be used from separate threads, but a
+ *   single board must not be used from several threads at once.
+ */
+#ifndef PCBCORE_H
+#define PCBCORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct pcb_board pcb_board;
+
+/* Mounting side (parts) / probe side (pins) */
+#define PCB_SIDE_BOTH   0
+#define PCB_SIDE_BOTTOM 1
+#define PCB_SIDE_TOP    2
+
+#define PCB_PART_SMD          0
+#define PCB_PART_THROUGH_HOLE 1
+
+/* pcb_pin_info.part of a pin that belongs to no part */
+#define PCB_NO_PART 0xFFFFFFFFu
+
+typedef struct pcb_part_info {
+    const char* name;
+    const char* mfgcode;
+    int32_t x1, y1, x2, y2;     /* Bounding box (board units); pin extent when the file has none */
+    int32_t side;               /* PCB_SIDE_* */
+    int32_t type;               /* PCB_PART_* */
+    uint32_t pin_count;
+} pcb_part_info;
+
+typedef struct pcb_pin_info {
+    const char* name;           /* Pin number or name */
+    const char* net;
+    const char* comment;        /* Diode reading or other note, "" when none */
+    int32_t x, y;               /* Centre (board units) */
+    double radius;
+    uint32_t part;              /* Part index, or PCB_NO_PART */
+    uint32_t net_index;         /* Index for pcb_get_net_name / pcb_get_net_pins */
+    int32_t side;               /* PCB_SIDE_* */
+} pcb_pin_info;
+
+/* Version of the library, e.g. "1.0.0" */
+const char* pcb_get_version(void);
+
+/* Loader log output: 0 debug, 1 info, 2 warning, 3 error, 4 off (process-wide) */
+void pcb_set_log_level(int level);
+
+/*
+ * Loads a board. A handle is returned even when loading fails (check pcb_is_loaded and
+ * pcb_get_error); NULL only when memory runs out. Release it with pcb_close.
+ */
+pcb_board* pcb_open_file(const char* path);
+pcb_board* pcb_open_memory(const void* data, size_t size);
+void pcb_close(pcb_board* board);
+
+int pcb_is_loaded(const pcb_board* board);
+const char* pcb_get_error(const pcb_board* board);          /* "" when loaded */
+const char* pcb_get_load_report_json(pcb_board* board);     /* Timings and counters of the load */
+
+uint32_t pcb_get_part_count(const pcb_board* board);
+uint32_t pcb_get_pin_count(const pcb_board* board);
+uint32_t pcb_get_net_count(const pcb_board* board);
+
+/* 1 and *out filled for a valid index, else 0 */
+int pcb_get_part(const pcb_board* board, uint32_t part, pcb_part_info* out);
+int pcb_get_pin(const pcb_board* board, uint32_t pin, pcb_pin_info* out);
+const char* pcb_get_net_name(const pcb_board* board, uint32_t net);
+
+/* Index of the first part / the net with this name, or -1 */
+int64_t pcb_find_part(const pcb_board* board, const char* name);
+int64_t pcb_find_net(const pcb_board* board, const char* name);
+
+/* Pin indices of a part or net: returns the count and points *pins at them */
+uint32_t pcb_get_part_pins(const pcb_board* board, uint32_t part, const uint32_t** pins);
+uint32_t pcb_get_net_pins(const pcb_board* board, uint32_t net, const uint32_t** pins);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCBCORE_H */
@@ -0,0 +1,36 @@
+#include "AllocTracker.h"
+#include <new>
+
+// Global allocation hooks for AllocTracker. Only executables that want the whole process
+// instrumented compile this file (the viewer and pcb_benchmarks); the pcbcore library never
+// replaces the allocator of the program it is linked into.
+#if PCB_ALLOC_TRACKING || PCB_FRAME_ALLOC_CHECK
+namespace {
+    const bool hooks_marked = (AllocTracker::Detail::MarkHooksInstalled(), true);
+}
+
+// Replacements for the global (non-aligned) allocation functions.
+// Over-aligned types keep using the library's aligned operators, which pair up on their own.
+void* operator new(size_t size) {
+    void* pointer = AllocTracker::Detail::Allocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+void* operator new[](size_t size) {
+    void* pointer = AllocTracker::Detail::Allocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return AllocTracker::Detail::Allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return AllocTracker::Detail::Allocate(size); }
+void operator delete(void* pointer) noexcept { AllocTracker::Detail::Free(pointer); }
+void operator delete[](void* pointer) noexcept { AllocTracker::Detail::Free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { AllocTracker::Detail::Free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { AllocTracker::Detail::Free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { AllocTracker::Detail::Free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { AllocTracker::Detail::Free(pointer); }
+#endif
@@ -0,0 +1,228 @@
+#include "AllocTracker.h"
+#include "Utils.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    const char* const kTagNames[static_cast<size_t>(AllocTag::Count)] = {
+        "untagged", "parse", "des", "json", "cache build", "frame", "labels"
+    };
+
+    thread_local AllocTag current_tag = AllocTag::Untagged;
+    std::atomic<bool> hooks_installed{false};
+
+#if PCB_ALLOC_TRACKING || PCB_FRAME_ALLOC_CHECK
+    std::atomic<uint64_t> allocation_count{0};
+    thread_local uint64_t thread_allocation_count = 0;
+#endif
+
+#if PCB_ALLOC_TRACKING
+    struct AtomicTagStats {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<int64_t> live_bytes{0};
+        std::atomic<int64_t> peak_live_bytes{0};
+    };
+    AtomicTagStats tag_stats[static_cast<size_t>(AllocTag::Count)];
+    std::atomic<int64_t> live_bytes{0};
+    std::atomic<int64_t> peak_live_bytes{0};
+
+    // Every tracked block starts with this header; 16 bytes keeps the user pointer aligned
+    struct alignas(16) BlockHeader {
+        uint64_t size;
+        AllocTag tag;
+    };
+
+    void UpdatePeak(std::atomic<int64_t>& peak, int64_t value) {
+        int64_t current = peak.load(std::memory_order_relaxed);
+        while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void* TrackedAllocate(size_t size) noexcept {
+        BlockHeader* header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+        if (!header) {
+            return nullptr;
+        }
+        header->size = size;
+        header->tag = current_tag;
+
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        thread_allocation_count++;
+        AtomicTagStats& stats = tag_stats[static_cast<size_t>(header->tag)];
+        stats.allocations.fetch_add(1, std::memory_order_relaxed);
+        stats.bytes.fetch_add(size, std::memory_order_relaxed);
+        UpdatePeak(stats.peak_live_bytes, stats.live_bytes.fetch_add(size, std::memory_order_relaxed) + static_cast<int64_t>(size));
+        UpdatePeak(peak_live_bytes, live_bytes.fetch_add(size, std::memory_order_relaxed) + static_cast<int64_t>(size));
+        return header + 1;
+    }
+
+    void TrackedFree(void* pointer) noexcept {
+        if (!pointer) {
+            return;
+        }
+        BlockHeader* header = static_cast<BlockHeader*>(pointer) - 1;
+        int64_t size = static_cast<int64_t>(header->size);
+        tag_stats[static_cast<size_t>(header->tag)].live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        std::free(header);
+    }
+#elif PCB_FRAME_ALLOC_CHECK
+    void* TrackedAllocate(size_t size) noexcept {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        thread_allocation_count++;
+        return std::malloc(size ? size : 1);
+    }
+
+    void TrackedFree(void* pointer) noexcept {
+        std::free(pointer);
+    }
+#endif
+}
+
+namespace AllocTracker {
+
+bool IsEnabled() {
+    return PCB_ALLOC_TRACKING != 0 && hooks_installed.load(std::memory_order_relaxed);
+}
+
+const char* GetTagName(AllocTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return index < static_cast<size_t>(AllocTag::Count) ? kTagNames[index] : "?";
+}
+
+AllocTag GetCurrentTag() {
+    return current_tag;
+}
+
+void SetCurrentTag(AllocTag tag) {
+    current_tag = tag;
+}
+
+uint64_t GetAllocationCount() {
+#if PCB_ALLOC_TRACKING || PCB_FRAME_ALLOC_CHECK
+    return allocation_count.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+uint64_t GetThreadAllocationCount() {
+#if PCB_ALLOC_TRACKING || PCB_FRAME_ALLOC_CHECK
+    return thread_allocation_count;
+#else
+    return 0;
+#endif
+}
+
+#if PCB_ALLOC_TRACKING
+TagStats GetTagStats(AllocTag tag) {
+    const AtomicTagStats& source = tag_stats[static_cast<size_t>(tag)];
+    TagStats stats;
+    stats.allocations = source.allocations.load(std::memory_order_relaxed);
+    stats.bytes = source.bytes.load(std::memory_order_relaxed);
+    stats.live_bytes = source.live_bytes.load(std::memory_order_relaxed);
+    stats.peak_live_bytes = source.peak_live_bytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+int64_t GetLiveBytes() {
+    return live_bytes.load(std::memory_order_relaxed);
+}
+
+int64_t GetPeakLiveBytes() {
+    return peak_live_bytes.load(std::memory_order_relaxed);
+}
+
+void ResetPeak() {
+    for (auto& stats : tag_stats) {
+        stats.peak_live_bytes.store(stats.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    peak_live_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+static std::string FormatBytes(int64_t bytes) {
+    char text[32];
+    double value = static_cast<double>(bytes);
+    if (bytes >= 1024 * 1024 || bytes <= -1024 * 1024) {
+        std::snprintf(text, sizeof(text), "%.1f MB", value / (1024.0 * 1024.0));
+    } else if (bytes >= 1024 || bytes <= -1024) {
+        std::snprintf(text, sizeof(text), "%.1f KB", value / 1024.0);
+    } else {
+        std::snprintf(text, sizeof(text), "%lld B", static_cast<long long>(bytes));
+    }
+    return text;
+}
+
+std::string FormatReport(const std::string& title) {
+    std::string report = "Allocations (" + title + "): live " + FormatBytes(GetLiveBytes()) +
+                         ", peak live " + FormatBytes(GetPeakLiveBytes()) +
+                         ", " + std::to_string(GetAllocationCount()) + " allocations";
+    for (size_t i = 0; i < static_cast<size_t>(AllocTag::Count); ++i) {
+        TagStats stats = GetTagStats(static_cast<AllocTag>(i));
+        if (stats.allocations == 0) {
+            continue;
+        }
+        char line[160];
+        std::snprintf(line, sizeof(line), "\n  %-12s %10llu allocs %12s total %12s live %12s peak",
+                      kTagNames[i], static_cast<unsigned long long>(stats.allocations),
+                      FormatBytes(static_cast<int64_t>(stats.bytes)).c_str(), FormatBytes(stats.live_bytes).c_str(),
+                      FormatBytes(stats.peak_live_bytes).c_str());
+        report += line;
+    }
+    return report;
+}
+#else
+TagStats GetTagStats(AllocTag) {
+    return TagStats();
+}
+
+int64_t GetLiveBytes() {
+    return 0;
+}
+
+int64_t GetPeakLiveBytes() {
+    return 0;
+}
+
+void ResetPeak() {
+}
+
+std::string FormatReport(const std::string&) {
+    return std::string();
+}
+#endif
+
+namespace Detail {
+
+void* Allocate(size_t size) noexcept {
+#if PCB_ALLOC_TRACKING || PCB_FRAME_ALLOC_CHECK
+    return TrackedAllocate(size);
+#else
+    return std::malloc(size ? size : 1);
+#endif
+}
+
+void Free(void* pointer) noexcept {
+#if PCB_ALLOC_TRACKING || PCB_FRAME_ALLOC_CHECK
+    TrackedFree(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+void MarkHooksInstalled() {
+    hooks_installed.store(true, std::memory_order_relaxed);
+}
+
+}
+
+void LogReport(const std::string& title) {
+    if (!IsEnabled()) {
+        return;
+    }
+    LOG_INFO(FormatReport(title));
+}
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Heap allocation instrumentation.
+// - PCB_ALLOC_TRACKING (CMake option of the same name): global operator new/delete hooks
+//   that attribute allocation counts, bytes and live bytes to the innermost PCB_ALLOC_SCOPE
+//   and track the peak live heap. Compiled out by default; the scopes then cost nothing.
+// - PCB_FRAME_ALLOC_CHECK (debug builds by default): counting-only hooks so the frame
+//   profiler can check that steady-state frames do not allocate.
+// The hooks themselves (AllocHooks.cpp) are linked into the viewer and pcb_benchmarks only:
+// pcbcore is embedded in other programs and must not replace their allocator. Elsewhere the
+// counters stay at zero.
+#ifndef PCB_ALLOC_TRACKING
+#define PCB_ALLOC_TRACKING 0
+#endif
+
+#ifndef PCB_FRAME_ALLOC_CHECK
+#ifdef NDEBUG
+#define PCB_FRAME_ALLOC_CHECK 0
+#else
+#define PCB_FRAME_ALLOC_CHECK 1
+#endif
+#endif
+
+enum class AllocTag : uint8_t {
+    Untagged = 0,
+    Parse,       // XZZPCB file parsing
+    DES,         // Part block decryption
+    JSON,        // JSON trailer (diode readings, aliases)
+    CacheBuild,  // Renderer caches built per board
+    Frame,       // Per-frame rendering
+    Labels,      // Part names and pin labels
+    Count
+};
+
+namespace AllocTracker {
+    struct TagStats {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;          // Total bytes requested
+        int64_t live_bytes = 0;      // Allocated in this scope and not yet freed
+        int64_t peak_live_bytes = 0;
+    };
+
+    // True when tracking is compiled in and the executable links the hooks
+    bool IsEnabled();
+
+    const char* GetTagName(AllocTag tag);
+    TagStats GetTagStats(AllocTag tag);
+
+    // Totals over all tags (allocation count is also available with PCB_FRAME_ALLOC_CHECK only)
+    uint64_t GetAllocationCount();
+    // Allocations made by the calling thread only (not the log writer, pool workers, ...)
+    uint64_t GetThreadAllocationCount();
+    int64_t GetLiveBytes();
+    int64_t GetPeakLiveBytes();
+
+    // Restarts peak tracking (global and per tag) from the current live bytes
+    void ResetPeak();
+
+    // Per-tag table; empty string when tracking is compiled out
+    std::string FormatReport(const std::string& title);
+    void LogReport(const std::string& title);
+
+    // Tag used by allocations on the calling thread (innermost scope)
+    AllocTag GetCurrentTag();
+    void SetCurrentTag(AllocTag tag);
+
+    namespace Detail {
+        // Accounting behind the operator new/delete replacements in AllocHooks.cpp;
+        // Allocate returns nullptr when out of memory
+        void* Allocate(size_t size) noexcept;
+        void Free(void* pointer) noexcept;
+        void MarkHooksInstalled();
+    }
+}
+
+// Attributes allocations on this thread to `tag` until the scope ends
+class AllocScope {
+public:
+    explicit AllocScope(AllocTag tag) : previous(AllocTracker::GetCurrentTag()) { AllocTracker::SetCurrentTag(tag); }
+    ~AllocScope() { AllocTracker::SetCurrentTag(previous); }
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+    AllocTag previous;
+};
+
+#define PCB_ALLOC_CONCAT_INNER(a, b) a##b
+#define PCB_ALLOC_CONCAT(a, b) PCB_ALLOC_CONCAT_INNER(a, b)
+
+#if PCB_ALLOC_TRACKING
+#define PCB_ALLOC_SCOPE(tag) AllocScope PCB_ALLOC_CONCAT(alloc_scope_, __LINE__)(AllocTag::tag)
+#else
+#define PCB_ALLOC_SCOPE(tag) ((void)0)
+#endif
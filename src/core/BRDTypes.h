@@ -1,5 +1,6 @@
 #pragma once
 
+#include "StringArena.h"
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -24,10 +25,13 @@ struct BRDPoint {
 enum class BRDPartMountingSide { Both, Bottom, Top };
 enum class BRDPartType { SMD, ThroughHole };
 
+// Text fields of parts, pins and nails are handles into the owning board's string arena
+// (BRDFileBase::strings / GetString)
+
 // PCB Part structure
 struct BRDPart {
-    std::string name;
-    std::string mfgcode;
+    StringRef name;
+    StringRef mfgcode;
     BRDPartMountingSide mounting_side = BRDPartMountingSide::Top;
     BRDPartType part_type = BRDPartType::SMD;
     unsigned int end_of_pins = 0;
@@ -38,21 +42,22 @@ struct BRDPart {
 // Pin sides
 enum class BRDPinSide { Both, Bottom, Top };
 
-// PCB Pin structure
+// PCB Pin structure. Its text lives apart (BRDPinText), so the geometry the renderer walks
+// every frame stays compact and boards loaded with lazy text need not hold the text at all.
 struct BRDPin {
     BRDPoint pos;
     int probe = 0;
-    unsigned int part = 0;
+    unsigned int part = 0;       // 1-based index into parts; 0 = no part
     BRDPinSide side = BRDPinSide::Top;
-    std::string net = "UNCONNECTED";
+    StringRef net;
     double radius = 0.5f;
-    std::string snum;
-    std::string name;
-    std::string comment;
+};
 
-    bool operator<(const BRDPin &p) const {
-        return part == p.part ? (snum < p.snum) : (part < p.part);
-    }
+// Text of a pin (BRDFileBase::pin_texts, parallel to pins)
+struct BRDPinText {
+    StringRef snum;
+    StringRef name;
+    StringRef comment;
 };
 
 // PCB Nail structure
@@ -60,42 +65,34 @@ struct BRDNail {
     unsigned int probe = 0;
     BRDPoint pos;
     BRDPartMountingSide side = BRDPartMountingSide::Top;
-    std::string net = "UNCONNECTED";
+    StringRef net;
 };
 
-// PCB Circle structure for rendering filled circles
-struct BRDCircle {
-    BRDPoint center;
-    float radius = 0.0f;
-    float r = 1.0f, g = 0.0f, b = 0.0f, a = 1.0f; // Default red color
-    
-    BRDCircle() = default;
-    BRDCircle(BRDPoint center, float radius, float r = 1.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f) 
-        : center(center), radius(radius), r(r), g(g), b(b), a(a) {}
-};
+// Pad outline kinds
+enum class BRDPadShape : uint8_t { Circle, Rectangle, Oval };
 
-// PCB Rectangle structure for rendering filled rectangles
-struct BRDRectangle {
-    BRDPoint center;
-    float width = 0.0f;
+// Pad geometry shared by every pad with the same shape, size and rotation. A board has a
+// few dozen of these against tens of thousands of pads.
+struct BRDPadStack {
+    BRDPadShape shape = BRDPadShape::Circle;
+    float width = 0.0f;           // Diameter for circles
     float height = 0.0f;
-    float rotation = 0.0f; // Rotation in degrees
-    float r = 1.0f, g = 0.0f, b = 0.0f, a = 1.0f; // Default red color
-    
-    BRDRectangle() = default;
-    BRDRectangle(BRDPoint center, float width, float height, float rotation = 0.0f, float r = 1.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f) 
-        : center(center), width(width), height(height), rotation(rotation), r(r), g(g), b(b), a(a) {}
+    float rotation = 0.0f;        // Degrees
+
+    // Derived from the above once per stack
+    float cos_rotation = 1.0f;
+    float sin_rotation = 0.0f;
+    float extent_x = 0.0f;        // Half extents with the rotation applied
+    float extent_y = 0.0f;
+
+    float GetRadius() const { return width * 0.5f; }
 };
 
-// PCB Oval structure for rendering filled ovals/ellipses
-struct BRDOval {
+// A placed pad: where it is, which pad stack it uses and which pin it belongs to
+struct BRDPad {
+    static const uint32_t kNoPin = 0xFFFFFFFFu;
+
     BRDPoint center;
-    float width = 0.0f;   // Width of the oval
-    float height = 0.0f;  // Height of the oval
-    float rotation = 0.0f; // Rotation in degrees
-    float r = 1.0f, g = 0.0f, b = 0.0f, a = 1.0f; // Default red color
-    
-    BRDOval() = default;
-    BRDOval(BRDPoint center, float width, float height, float rotation = 0.0f, float r = 1.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f) 
-        : center(center), width(width), height(height), rotation(rotation), r(r), g(g), b(b), a(a) {}
+    uint32_t stack = 0;           // Index into BRDFileBase::pad_stacks
+    uint32_t pin = kNoPin;        // Index into BRDFileBase::pins
 };
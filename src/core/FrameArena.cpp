@@ -0,0 +1,66 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+FrameArena::FrameArena(size_t initial_capacity)
+    : block(new char[initial_capacity]), capacity(initial_capacity) {
+}
+
+static size_t AlignPadding(const char* pointer, size_t alignment) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    return (alignment - (address & (alignment - 1))) & (alignment - 1);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    if (overflow.empty()) {
+        size_t padding = AlignPadding(block.get() + used, alignment);
+        if (used + padding + size <= capacity) {
+            char* result = block.get() + used + padding;
+            used += padding + size;
+            return result;
+        }
+    } else {
+        size_t padding = AlignPadding(overflow_cursor, alignment);
+        if (padding + size <= overflow_remaining) {
+            char* result = overflow_cursor + padding;
+            overflow_cursor += padding + size;
+            overflow_remaining -= padding + size;
+            overflow_used += padding + size;
+            return result;
+        }
+    }
+
+    // Out of space: chain a new block (merged into the main block on the next Reset)
+    size_t block_size = std::max(capacity, size + alignment);
+    overflow.emplace_back(new char[block_size]);
+    overflow_cursor = overflow.back().get();
+    overflow_remaining = block_size;
+    size_t padding = AlignPadding(overflow_cursor, alignment);
+    char* result = overflow_cursor + padding;
+    overflow_cursor += padding + size;
+    overflow_remaining -= padding + size;
+    overflow_used += padding + size;
+    return result;
+}
+
+std::string_view FrameArena::CopyString(std::string_view text) {
+    char* copy = static_cast<char*>(Allocate(text.size() + 1, 1));
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+    return std::string_view(copy, text.size());
+}
+
+void FrameArena::Reset() {
+    if (!overflow.empty()) {
+        // Grow to this frame's peak so the same workload fits in one block next time
+        size_t peak = used + overflow_used;
+        overflow.clear();
+        capacity = peak + peak / 2;
+        block.reset(new char[capacity]);
+        overflow_used = 0;
+        overflow_remaining = 0;
+        overflow_cursor = nullptr;
+    }
+    used = 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for data that lives for one frame (label line splits and similar scratch).
+// Allocation is a pointer bump; Reset() releases everything at once. When a frame overflows
+// the main block, the next Reset() replaces it with one block sized to the peak, so frames
+// doing the same amount of work allocate nothing from the heap.
+class FrameArena {
+public:
+    explicit FrameArena(size_t initial_capacity = 64 * 1024);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialised storage for `count` objects; only for trivially destructible types
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Copy of `text` valid until the next Reset()
+    std::string_view CopyString(std::string_view text);
+
+    void Reset();
+
+    size_t GetUsed() const { return used + overflow_used; }
+    size_t GetCapacity() const { return capacity; }
+
+private:
+    std::unique_ptr<char[]> block;
+    size_t capacity = 0;
+    size_t used = 0;
+
+    // Blocks added when the main block runs out during a frame
+    std::vector<std::unique_ptr<char[]>> overflow;
+    size_t overflow_used = 0;
+    size_t overflow_remaining = 0;
+    char* overflow_cursor = nullptr;
+};
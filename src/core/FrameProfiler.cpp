@@ -0,0 +1,32 @@
+#include "FrameProfiler.h"
+#include "Utils.h"
+#include <cassert>
+#include <chrono>
+
+static double NowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FrameProfiler::BeginFrame() {
+    frame_start = NowSeconds();
+    frame_thread = std::this_thread::get_id();
+    allocations_at_start = AllocTracker::GetThreadAllocationCount();
+}
+
+void FrameProfiler::EndFrame(bool steady_state) {
+    if (std::this_thread::get_id() != frame_thread) {
+        return;
+    }
+    last_frame_ms = (NowSeconds() - frame_start) * 1000.0;
+    last_frame_allocations = static_cast<size_t>(AllocTracker::GetThreadAllocationCount() - allocations_at_start);
+    frame_count++;
+
+#if PCB_FRAME_ALLOC_CHECK
+    if (steady_state && last_frame_allocations != 0) {
+        LOG_ERROR("Steady-state frame made " + std::to_string(last_frame_allocations) + " heap allocations");
+        assert(last_frame_allocations == 0 && "steady-state frames must not allocate");
+    }
+#else
+    (void)steady_state;
+#endif
+}
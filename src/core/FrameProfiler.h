@@ -0,0 +1,30 @@
+#pragma once
+
+#include "AllocTracker.h"
+#include <cstddef>
+#include <thread>
+
+// Per-frame timing and heap allocation counts for the render loop. Allocations are counted
+// on the thread that runs the frame only: the log writer, pool workers and background loads
+// allocate on their own threads and do not count against the frame.
+class FrameProfiler {
+public:
+    void BeginFrame();
+
+    // steady_state: the frame redrew an unchanged scene, so it must not touch the heap
+    // (asserted when PCB_FRAME_ALLOC_CHECK is on, i.e. debug builds). Ignored when called
+    // on another thread than BeginFrame.
+    void EndFrame(bool steady_state);
+
+    double GetLastFrameMs() const { return last_frame_ms; }
+    size_t GetLastFrameAllocations() const { return last_frame_allocations; }
+    unsigned long long GetFrameCount() const { return frame_count; }
+
+private:
+    double frame_start = 0.0;
+    std::thread::id frame_thread;
+    uint64_t allocations_at_start = 0;
+    double last_frame_ms = 0.0;
+    size_t last_frame_allocations = 0;
+    unsigned long long frame_count = 0;
+};
@@ -0,0 +1,270 @@
+#include "Log.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Log {
+    namespace Detail {
+        std::atomic<uint8_t> active_level{static_cast<uint8_t>(PCB_LOG_MIN_LEVEL < 4 ? PCB_LOG_MIN_LEVEL : 4)};
+    }
+}
+
+namespace {
+    const size_t kQueueCapacity = 4096;   // Power of two
+
+    const char* GetPrefix(LogLevel level) {
+        switch (level) {
+            case LogLevel::Debug: return "DEBUG: ";
+            case LogLevel::Info: return "INFO: ";
+            case LogLevel::Warning: return "WARNING: ";
+            case LogLevel::Error: return "ERROR: ";
+            default: return "";
+        }
+    }
+
+    // Bounded multi-producer queue (sequence-numbered ring). Producers claim a slot with one
+    // CAS; the single writer thread consumes in order.
+    class MessageQueue {
+    public:
+        MessageQueue() : slots(kQueueCapacity) {
+            for (size_t i = 0; i < kQueueCapacity; ++i) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // False when the queue is full
+        bool TryPush(LogLevel level, std::string& message) {
+            size_t position = enqueue_position.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            for (;;) {
+                slot = &slots[position & (kQueueCapacity - 1)];
+                size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                if (difference == 0) {
+                    if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+            slot->level = level;
+            slot->message = std::move(message);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Writer thread only
+        bool TryPop(LogLevel& level, std::string& message) {
+            Slot& slot = slots[dequeue_position & (kQueueCapacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeue_position + 1) {
+                return false;
+            }
+            level = slot.level;
+            message = std::move(slot.message);
+            slot.message.clear();
+            slot.sequence.store(dequeue_position + kQueueCapacity, std::memory_order_release);
+            dequeue_position++;
+            popped.store(dequeue_position, std::memory_order_release);
+            return true;
+        }
+
+        size_t GetPushedCount() const { return enqueue_position.load(std::memory_order_acquire); }
+        size_t GetPoppedCount() const { return popped.load(std::memory_order_acquire); }
+
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence{0};
+            LogLevel level = LogLevel::Info;
+            std::string message;
+        };
+
+        std::vector<Slot> slots;
+        alignas(64) std::atomic<size_t> enqueue_position{0};
+        alignas(64) size_t dequeue_position = 0;
+        std::atomic<size_t> popped{0};
+    };
+
+    class Logger {
+    public:
+        Logger() : writer(&Logger::WriterLoop, this) {}
+        ~Logger() { Shutdown(); }
+
+        void Write(LogLevel level, std::string& message) {
+            if (!running.load(std::memory_order_acquire)) {
+                WriteNow(level, message);
+                return;
+            }
+            while (!queue.TryPush(level, message)) {
+                // Debug output is dropped under pressure; anything else waits for the writer
+                // so that no message is lost and each thread's messages stay in order
+                if (level == LogLevel::Debug) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                Wake();
+                std::this_thread::yield();
+                if (!running.load(std::memory_order_acquire)) {
+                    WriteNow(level, message);
+                    return;
+                }
+            }
+            if (!wake_pending.load(std::memory_order_relaxed)) {
+                Wake();
+            }
+        }
+
+        void Flush() {
+            if (!running.load(std::memory_order_acquire)) {
+                return;
+            }
+            size_t target = queue.GetPushedCount();
+            std::unique_lock<std::mutex> lock(mutex);
+            wake_pending.store(true, std::memory_order_release);
+            wake_cv.notify_one();
+            drained_cv.wait(lock, [&] { return queue.GetPoppedCount() >= target || !running.load(); });
+        }
+
+        void Shutdown() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (stopping) {
+                    return;
+                }
+                stopping = true;
+            }
+            wake_cv.notify_one();
+            if (writer.joinable()) {
+                writer.join();
+            }
+        }
+
+        uint64_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        void Wake() {
+            if (!wake_pending.exchange(true, std::memory_order_acq_rel)) {
+                wake_cv.notify_one();
+            }
+        }
+
+        void WriteNow(LogLevel level, const std::string& message) {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            FILE* stream = level >= LogLevel::Warning ? stderr : stdout;
+            std::fputs(GetPrefix(level), stream);
+            std::fwrite(message.data(), 1, message.size(), stream);
+            std::fputc('\n', stream);
+            std::fflush(stream);
+        }
+
+        // Writes everything currently queued; true if anything was written
+        bool Drain() {
+            LogLevel level;
+            bool wrote_out = false;
+            bool wrote_err = false;
+            std::lock_guard<std::mutex> lock(output_mutex);
+            while (queue.TryPop(level, scratch)) {
+                FILE* stream = level >= LogLevel::Warning ? stderr : stdout;
+                std::fputs(GetPrefix(level), stream);
+                std::fwrite(scratch.data(), 1, scratch.size(), stream);
+                std::fputc('\n', stream);
+                (stream == stderr ? wrote_err : wrote_out) = true;
+            }
+            if (wrote_out) std::fflush(stdout);
+            if (wrote_err) std::fflush(stderr);
+            return wrote_out || wrote_err;
+        }
+
+        void WriterLoop() {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                lock.unlock();
+                Drain();
+                lock.lock();
+                drained_cv.notify_all();
+                if (stopping && queue.GetPoppedCount() == queue.GetPushedCount()) {
+                    break;
+                }
+                // The timeout covers a wake-up racing with the wait
+                wake_cv.wait_for(lock, std::chrono::milliseconds(50), [this] {
+                    return stopping || wake_pending.load(std::memory_order_acquire);
+                });
+                wake_pending.store(false, std::memory_order_release);
+            }
+            running.store(false, std::memory_order_release);
+            lock.unlock();
+            // Producers that saw `running` just before it was cleared
+            Drain();
+            drained_cv.notify_all();
+        }
+
+        MessageQueue queue;
+        std::string scratch;
+        std::mutex mutex;                  // Writer sleep/wake and shutdown state
+        std::mutex output_mutex;           // Serialises writes to stdout/stderr
+        std::condition_variable wake_cv;
+        std::condition_variable drained_cv;
+        std::atomic<bool> wake_pending{false};
+        std::atomic<bool> running{true};
+        std::atomic<uint64_t> dropped{0};
+        bool stopping = false;
+        std::thread writer;                // Last: started once everything above exists
+    };
+
+    Logger& GetLogger() {
+        static Logger logger;
+        return logger;
+    }
+}
+
+namespace Log {
+    void SetLevel(LogLevel level) {
+        Detail::active_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    LogLevel GetLevel() {
+        return static_cast<LogLevel>(Detail::active_level.load(std::memory_order_relaxed));
+    }
+
+    bool ParseLevel(const std::string& text, LogLevel& level) {
+        for (uint8_t i = 0; i <= static_cast<uint8_t>(LogLevel::Off); ++i) {
+            if (text == GetLevelName(static_cast<LogLevel>(i))) {
+                level = static_cast<LogLevel>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* GetLevelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::Debug: return "debug";
+            case LogLevel::Info: return "info";
+            case LogLevel::Warning: return "warning";
+            case LogLevel::Error: return "error";
+            case LogLevel::Off: return "off";
+            default: return "?";
+        }
+    }
+
+    void Write(LogLevel level, std::string message) {
+        GetLogger().Write(level, message);
+    }
+
+    void Flush() {
+        GetLogger().Flush();
+    }
+
+    void Shutdown() {
+        GetLogger().Shutdown();
+    }
+
+    uint64_t GetDroppedCount() {
+        return GetLogger().GetDropped();
+    }
+}
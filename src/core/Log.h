@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+// Asynchronous, level-filtered logging.
+// - PCB_LOG_MIN_LEVEL (0 = debug .. 4 = off) removes the statements below it at compile
+//   time; by default debug messages are kept in debug builds only.
+// - Log::SetLevel filters at runtime. A disabled statement costs one relaxed atomic load:
+//   its message expression is not evaluated.
+// - Enabled messages are formatted on the calling thread, pushed onto a lock-free queue
+//   and written by a background thread; output is flushed per batch, not per line.
+enum class LogLevel : uint8_t {
+    Debug = 0,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+#ifndef PCB_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define PCB_LOG_MIN_LEVEL 1
+#else
+#define PCB_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+namespace Log {
+    namespace Detail {
+        extern std::atomic<uint8_t> active_level;
+    }
+
+    void SetLevel(LogLevel level);
+    LogLevel GetLevel();
+
+    inline bool IsEnabled(LogLevel level) {
+        return static_cast<uint8_t>(level) >= Detail::active_level.load(std::memory_order_relaxed) &&
+               level != LogLevel::Off;
+    }
+
+    // "debug", "info", "warning", "error" or "off"; false for anything else
+    bool ParseLevel(const std::string& text, LogLevel& level);
+    const char* GetLevelName(LogLevel level);
+
+    // Queues a message for the writer thread (started on first use)
+    void Write(LogLevel level, std::string message);
+
+    // Blocks until everything queued so far has been written
+    void Flush();
+
+    // Writes what is left and stops the writer; later messages are written synchronously
+    void Shutdown();
+
+    // Debug messages dropped because the queue was full (other levels wait for space)
+    uint64_t GetDroppedCount();
+}
+
+#define PCB_LOG_STATEMENT(level, msg) \
+    do { \
+        if (Log::IsEnabled(level)) { \
+            std::ostringstream pcb_log_stream; \
+            pcb_log_stream << msg; \
+            Log::Write(level, pcb_log_stream.str()); \
+        } \
+    } while (0)
+
+#if PCB_LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(msg) PCB_LOG_STATEMENT(LogLevel::Debug, msg)
+#else
+#define LOG_DEBUG(msg) ((void)0)
+#endif
+
+#if PCB_LOG_MIN_LEVEL <= 1
+#define LOG_INFO(msg) PCB_LOG_STATEMENT(LogLevel::Info, msg)
+#else
+#define LOG_INFO(msg) ((void)0)
+#endif
+
+#if PCB_LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(msg) PCB_LOG_STATEMENT(LogLevel::Warning, msg)
+#else
+#define LOG_WARNING(msg) ((void)0)
+#endif
+
+#if PCB_LOG_MIN_LEVEL <= 3
+#define LOG_ERROR(msg) PCB_LOG_STATEMENT(LogLevel::Error, msg)
+#else
+#define LOG_ERROR(msg) ((void)0)
+#endif
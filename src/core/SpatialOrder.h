@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Z-order (Morton) layout: sorted by this key, elements that are close on the board are
+// close in memory, so a viewport maps to a few contiguous runs of a geometry array
+namespace SpatialOrder {
+    // Interleaves the bits of two 16-bit grid coordinates (x in the even bits)
+    inline uint32_t MortonKey(uint32_t x, uint32_t y) {
+        auto spread = [](uint32_t v) {
+            v &= 0xFFFFu;
+            v = (v | (v << 8)) & 0x00FF00FFu;
+            v = (v | (v << 4)) & 0x0F0F0F0Fu;
+            v = (v | (v << 2)) & 0x33333333u;
+            v = (v | (v << 1)) & 0x55555555u;
+            return v;
+        };
+        return spread(x) | (spread(y) << 1);
+    }
+
+    // Permutation that visits `count` points in Morton order over their bounding box; equal
+    // keys keep their input order. point(i) returns the i-th position (anything with .x/.y).
+    template <typename PointFn>
+    std::vector<uint32_t> MortonOrder(size_t count, PointFn point) {
+        std::vector<uint32_t> order(count);
+        if (count == 0) {
+            return order;
+        }
+
+        double min_x = point(0).x, max_x = min_x;
+        double min_y = point(0).y, max_y = min_y;
+        for (size_t i = 1; i < count; ++i) {
+            const auto& p = point(i);
+            min_x = std::min(min_x, static_cast<double>(p.x));
+            max_x = std::max(max_x, static_cast<double>(p.x));
+            min_y = std::min(min_y, static_cast<double>(p.y));
+            max_y = std::max(max_y, static_cast<double>(p.y));
+        }
+        // One grid for both axes keeps the cells square
+        double extent = std::max(max_x - min_x, max_y - min_y);
+        double scale = extent > 0.0 ? 65535.0 / extent : 0.0;
+
+        // Key in the high half, index in the low half: one plain sort is stable
+        std::vector<uint64_t> keyed(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto& p = point(i);
+            uint32_t gx = static_cast<uint32_t>((p.x - min_x) * scale);
+            uint32_t gy = static_cast<uint32_t>((p.y - min_y) * scale);
+            keyed[i] = (static_cast<uint64_t>(MortonKey(gx, gy)) << 32) | static_cast<uint32_t>(i);
+        }
+        std::sort(keyed.begin(), keyed.end());
+        for (size_t i = 0; i < count; ++i) {
+            order[i] = static_cast<uint32_t>(keyed[i]);
+        }
+        return order;
+    }
+}
@@ -0,0 +1,105 @@
+#include "StringArena.h"
+#include <cstring>
+#include <stdexcept>
+
+StringArena::StringArena() {
+    Clear();
+}
+
+uint32_t StringArena::Hash(std::string_view text) {
+    // FNV-1a: board strings are short (pin numbers, net and part names)
+    uint32_t hash = 2166136261u;
+    for (char c : text) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+StringRef StringArena::Intern(std::string_view text) {
+    if (text.empty()) {
+        return StringRef();
+    }
+
+    uint32_t hash = Hash(text);
+    size_t mask = table.size() - 1;
+    size_t index = hash & mask;
+    while (table[index].offset != kEmptySlot) {
+        const Slot& slot = table[index];
+        if (slot.hash == hash && slot.length == text.size() &&
+            std::memcmp(GetCString(StringRef{slot.offset, slot.length}), text.data(), text.size()) == 0) {
+            return StringRef{slot.offset, slot.length};
+        }
+        index = (index + 1) & mask;
+    }
+
+    if (end + text.size() + 1 > limit) {
+        AddBlock(text.size() + 1);
+    }
+    StringRef ref{static_cast<uint32_t>(end), static_cast<uint32_t>(text.size())};
+    char* copy = chunks[ref.offset >> kChunkShift] + (ref.offset & (kChunkBytes - 1));
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+    end += text.size() + 1;
+    byte_count += text.size() + 1;
+
+    table[index] = Slot{ref.offset, ref.length, hash};
+    if (++count * 4 >= table.size() * 3) {
+        Grow();
+    }
+    return ref;
+}
+
+void StringArena::Grow() {
+    std::vector<Slot> old_table;
+    old_table.swap(table);
+    table.assign(old_table.size() * 2, Slot());
+    size_t mask = table.size() - 1;
+    for (const Slot& slot : old_table) {
+        if (slot.offset == kEmptySlot) {
+            continue;
+        }
+        size_t index = slot.hash & mask;
+        while (table[index].offset != kEmptySlot) {
+            index = (index + 1) & mask;
+        }
+        table[index] = slot;
+    }
+}
+
+void StringArena::AddBlock(size_t bytes) {
+    size_t chunk_count = (bytes + kChunkBytes - 1) / kChunkBytes;
+    // 32-bit handles address at most 4 GB of text
+    if (limit + chunk_count * kChunkBytes > 0xFFFFFFFFu) {
+        throw std::length_error("StringArena: more than 4 GB of text");
+    }
+    blocks.emplace_back(new char[chunk_count * kChunkBytes]);
+    for (size_t i = 0; i < chunk_count; ++i) {
+        chunks.push_back(blocks.back().get() + i * kChunkBytes);
+    }
+    block_bytes += chunk_count * kChunkBytes;
+    end = limit;
+    limit += chunk_count * kChunkBytes;
+}
+
+void StringArena::Reserve(size_t bytes, size_t strings) {
+    // One block for the expected text; the rest of the current block is given up
+    if (limit - end < bytes) {
+        AddBlock(bytes);
+    }
+    while (table.size() * 3 < strings * 4) {
+        Grow();
+    }
+}
+
+void StringArena::Clear() {
+    std::vector<std::unique_ptr<char[]>>().swap(blocks);
+    std::vector<char*>().swap(chunks);
+    std::vector<Slot>().swap(table);
+    end = limit = 0;
+    block_bytes = 0;
+    AddBlock(1);
+    chunks[0][0] = '\0';
+    end = byte_count = 1;
+    table.assign(64, Slot());
+    count = 0;
+}
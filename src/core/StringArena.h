@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Handle to a string in a StringArena (8 bytes instead of a 32-byte std::string plus a heap
+// block). The default handle is the empty string.
+struct StringRef {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+
+    bool empty() const { return length == 0; }
+
+    // The arena stores each distinct string once, so equal handles mean equal text
+    // (for handles from the same arena)
+    bool operator==(const StringRef& other) const { return offset == other.offset && length == other.length; }
+    bool operator!=(const StringRef& other) const { return !(*this == other); }
+};
+
+// Append-only, deduplicating storage for all text of one board. Every string is stored once,
+// NUL-terminated, in blocks that are never moved or resized, so views and C strings stay valid
+// until Clear() even while deferred parts intern more text.
+class StringArena {
+public:
+    StringArena();
+
+    // Stores `text` (or finds the stored copy) and returns its handle
+    StringRef Intern(std::string_view text);
+
+    std::string_view Get(StringRef ref) const { return std::string_view(GetCString(ref), ref.length); }
+    const char* GetCString(StringRef ref) const {
+        return chunks[ref.offset >> kChunkShift] + (ref.offset & (kChunkBytes - 1));
+    }
+
+    size_t GetByteCount() const { return byte_count; }
+    size_t GetStringCount() const { return count; }
+    size_t GetMemoryUsage() const {
+        return block_bytes + chunks.capacity() * sizeof(char*) + table.capacity() * sizeof(Slot);
+    }
+
+    void Reserve(size_t bytes, size_t strings);
+    void Clear();
+
+private:
+    struct Slot {
+        uint32_t offset = kEmptySlot;
+        uint32_t length = 0;
+        uint32_t hash = 0;
+    };
+    static const uint32_t kEmptySlot = 0xFFFFFFFFu;
+
+    // Offsets are split into fixed-size chunks so a handle finds its block in O(1). A string
+    // never spans two blocks; a block holds one or more whole chunks.
+    static const uint32_t kChunkShift = 16;
+    static const size_t kChunkBytes = size_t(1) << kChunkShift;
+
+    static uint32_t Hash(std::string_view text);
+    void Grow();
+    // Starts a block of at least `bytes` at the next chunk boundary
+    void AddBlock(size_t bytes);
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::vector<char*> chunks;  // Start of each chunk; offset 0 is the shared empty string
+    uint64_t end = 0;           // Offset of the next string
+    uint64_t limit = 0;         // End of the last block
+    size_t byte_count = 0;      // Stored text, terminators included
+    size_t block_bytes = 0;
+    std::vector<Slot> table;    // Open addressing, power-of-two size
+    size_t count = 0;
+};
@@ -0,0 +1,124 @@
+#include "ThreadPool.h"
+#include "Trace.h"
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        thread_count = hardware > 1 ? hardware - 1 : 0;
+    }
+    workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_cv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Enqueue(std::function<void()> task) {
+    if (workers.empty()) {
+        // No workers: run inline so callers still make progress
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    work_cv.notify_one();
+}
+
+void ThreadPool::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle_cv.wait(lock, [this] { return tasks.empty() && active_tasks == 0; });
+}
+
+void ThreadPool::RunParallel(size_t task_count, void (*invoke)(void*, size_t), void* context) {
+    if (task_count == 0) {
+        return;
+    }
+    if (task_count == 1 || workers.empty()) {
+        for (size_t i = 0; i < task_count; ++i) {
+            invoke(context, i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> serial(parallel_mutex);
+    ParallelJob current;
+    current.invoke = invoke;
+    current.context = context;
+    current.count = task_count;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &current;
+    }
+    work_cv.notify_all();
+
+    // The calling thread works too
+    WorkOnJob(current);
+
+    // Wait for the last task and for every worker to let go of the job before it goes out of scope
+    std::unique_lock<std::mutex> lock(mutex);
+    idle_cv.wait(lock, [&] { return current.done.load() == task_count && job_workers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::WorkOnJob(ParallelJob& current) {
+    for (;;) {
+        size_t index = current.next.fetch_add(1);
+        if (index >= current.count) {
+            break;
+        }
+        current.invoke(current.context, index);
+        current.done.fetch_add(1);
+    }
+}
+
+void ThreadPool::WorkerLoop(size_t worker_index) {
+    Trace::SetThreadName("worker " + std::to_string(worker_index + 1));
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        work_cv.wait(lock, [this] {
+            return stopping || !tasks.empty() || (job && job->next.load() < job->count);
+        });
+
+        if (job && job->next.load() < job->count) {
+            ParallelJob* current = job;
+            job_workers++;
+            lock.unlock();
+            WorkOnJob(*current);
+            lock.lock();
+            job_workers--;
+            idle_cv.notify_all();
+            continue;
+        }
+
+        if (!tasks.empty()) {
+            std::function<void()> task = std::move(tasks.front());
+            tasks.pop_front();
+            active_tasks++;
+            lock.unlock();
+            task();
+            lock.lock();
+            active_tasks--;
+            if (tasks.empty() && active_tasks == 0) {
+                idle_cv.notify_all();
+            }
+            continue;
+        }
+
+        if (stopping) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Fixed-size worker pool.
+// - Enqueue/WaitIdle: fire-and-forget tasks (used for batch jobs such as loading files)
+// - ParallelFor: fork/join over task indices on the calling thread plus the workers;
+//   it does not allocate, so it can be used from the per-frame render path
+class ThreadPool {
+public:
+    // thread_count == 0 picks hardware_concurrency() - 1 workers (the caller is the extra thread)
+    explicit ThreadPool(size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t GetWorkerCount() const { return workers.size(); }
+
+    // Threads that take part in ParallelFor (workers + caller)
+    size_t GetConcurrency() const { return workers.size() + 1; }
+
+    void Enqueue(std::function<void()> task);
+    void WaitIdle();
+
+    // Runs fn(task_index) for every index in [0, task_count) and returns when all are done
+    template <typename Fn>
+    void ParallelFor(size_t task_count, Fn&& fn) {
+        using FnType = typename std::remove_reference<Fn>::type;
+        RunParallel(task_count, [](void* context, size_t index) { (*static_cast<FnType*>(context))(index); }, &fn);
+    }
+
+private:
+    struct ParallelJob {
+        void (*invoke)(void*, size_t) = nullptr;
+        void* context = nullptr;
+        size_t count = 0;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+    };
+
+    void RunParallel(size_t task_count, void (*invoke)(void*, size_t), void* context);
+    void WorkOnJob(ParallelJob& job);
+    void WorkerLoop(size_t worker_index);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_cv;   // Workers wait for tasks or a parallel job
+    std::condition_variable idle_cv;   // WaitIdle / RunParallel wait for completion
+    std::deque<std::function<void()>> tasks;
+    size_t active_tasks = 0;
+    bool stopping = false;
+
+    std::mutex parallel_mutex;         // One ParallelFor at a time
+    ParallelJob* job = nullptr;
+    size_t job_workers = 0;            // Workers currently inside WorkOnJob
+};
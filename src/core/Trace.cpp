@@ -0,0 +1,178 @@
+#include "Trace.h"
+#include "Utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // Events per thread; a power of two so the ring index is a mask
+    const uint64_t kRingCapacity = 1 << 16;
+
+    struct TraceEvent {
+        const char* name;
+        uint64_t timestamp_ns;
+        double value;
+        char phase;  // 'B', 'E' or 'C'
+    };
+
+    struct ThreadBuffer {
+        std::unique_ptr<TraceEvent[]> events;  // Allocated on the first event
+        std::atomic<uint64_t> head{0};  // Events written so far; only the owning thread writes
+        std::atomic<uint64_t> start{0}; // First event kept; only Clear() writes (never the owner)
+        unsigned int thread_id = 0;
+        std::string thread_name;
+    };
+
+    std::atomic<bool> enabled{false};
+    const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+    // Buffers outlive their threads so their events can still be written out
+    std::mutex registry_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+    thread_local ThreadBuffer* thread_buffer = nullptr;
+
+    ThreadBuffer& GetThreadBuffer() {
+        if (!thread_buffer) {
+            std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            buffer->thread_id = static_cast<unsigned int>(registry.size() + 1);
+            thread_buffer = buffer.get();
+            registry.push_back(std::move(buffer));
+        }
+        return *thread_buffer;
+    }
+
+    void Record(const char* name, char phase, double value) {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        if (!buffer.events) {
+            buffer.events.reset(new TraceEvent[kRingCapacity]);
+        }
+        uint64_t index = buffer.head.load(std::memory_order_relaxed);
+        TraceEvent& event = buffer.events[index & (kRingCapacity - 1)];
+        event.name = name;
+        event.timestamp_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count());
+        event.value = value;
+        event.phase = phase;
+        buffer.head.store(index + 1, std::memory_order_release);
+    }
+
+    void WriteJsonString(FILE* file, const char* text) {
+        std::fputc('"', file);
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                std::fputc('\\', file);
+                std::fputc(*c, file);
+            } else if (static_cast<unsigned char>(*c) < 0x20) {
+                std::fprintf(file, "\\u%04x", static_cast<unsigned char>(*c));
+            } else {
+                std::fputc(*c, file);
+            }
+        }
+        std::fputc('"', file);
+    }
+}
+
+namespace Trace {
+
+void SetEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool IsEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void SetThreadName(const std::string& name) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffer.thread_name = name;
+}
+
+void Begin(const char* name) {
+    Record(name, 'B', 0.0);
+}
+
+void End(const char* name) {
+    Record(name, 'E', 0.0);
+}
+
+void Counter(const char* name, double value) {
+    Record(name, 'C', value);
+}
+
+bool WriteChromeTrace(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR("Cannot write trace file: " + path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    size_t event_count = 0;
+    for (const auto& buffer : registry) {
+        if (!buffer->thread_name.empty()) {
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                         first ? "" : ",\n", buffer->thread_id);
+            WriteJsonString(file, buffer->thread_name.c_str());
+            std::fprintf(file, "}}");
+            first = false;
+        }
+
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = std::max(buffer->start.load(std::memory_order_relaxed), head > kRingCapacity ? head - kRingCapacity : 0);
+        // Spans that began before the kept events (overwritten or cleared) have no 'B': their
+        // 'E' is dropped so every written span is balanced
+        uint64_t depth = 0;
+        for (uint64_t index = begin; index < head; ++index) {
+            const TraceEvent& event = buffer->events[index & (kRingCapacity - 1)];
+            if (event.phase == 'B') {
+                depth++;
+            } else if (event.phase == 'E') {
+                if (depth == 0) {
+                    continue;
+                }
+                depth--;
+            }
+            std::fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+            WriteJsonString(file, event.name);
+            std::fprintf(file, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u", event.phase,
+                         event.timestamp_ns / 1000.0, buffer->thread_id);
+            if (event.phase == 'C') {
+                std::fprintf(file, ",\"args\":{\"value\":%.6g}", event.value);
+            }
+            std::fputc('}', file);
+            first = false;
+            event_count++;
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+    bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+
+    if (ok) {
+        LOG_INFO("Wrote " + std::to_string(event_count) + " trace events to " + path);
+    } else {
+        LOG_ERROR("Failed while writing trace file: " + path);
+    }
+    return ok;
+}
+
+void Clear() {
+    // Moves each buffer's start up to its head instead of resetting the head, so recording
+    // threads keep sole ownership of their head and slots
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (const auto& buffer : registry) {
+        buffer->start.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+}
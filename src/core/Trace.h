@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+
+// Lightweight event tracing exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+// Every thread records into its own fixed-size ring buffer without locks; the oldest events
+// are overwritten when a buffer is full. Recording is off until SetEnabled(true), and a
+// disabled scope costs one relaxed atomic load.
+// Event names must have static storage duration (string literals).
+namespace Trace {
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    // Name shown for the calling thread in the trace viewer
+    void SetThreadName(const std::string& name);
+
+    void Begin(const char* name);
+    void End(const char* name);
+    void Counter(const char* name, double value);
+
+    // Writes every buffered event. Call it while other threads are not recording
+    // (e.g. between frames) so no ring slot is overwritten during the copy.
+    bool WriteChromeTrace(const std::string& path);
+
+    // Drops all buffered events; safe while other threads record (their later events are kept)
+    void Clear();
+}
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name(Trace::IsEnabled() ? name : nullptr) {
+        if (this->name) {
+            Trace::Begin(this->name);
+        }
+    }
+    ~TraceScope() {
+        if (name) {
+            Trace::End(name);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+};
+
+#define PCB_TRACE_CONCAT_INNER(a, b) a##b
+#define PCB_TRACE_CONCAT(a, b) PCB_TRACE_CONCAT_INNER(a, b)
+#define PCB_TRACE_SCOPE(name) TraceScope PCB_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define PCB_TRACE_COUNTER(name, value) \
+    do { if (Trace::IsEnabled()) Trace::Counter(name, static_cast<double>(value)); } while (0)
@@ -1,14 +1,11 @@
 #pragma once
 
+// Logging macros (LOG_DEBUG/LOG_INFO/LOG_WARNING/LOG_ERROR)
+#include "Log.h"
 #include <string>
 #include <vector>
 #include <iostream>
 
-// Simple logging macros
-#define LOG_ERROR(msg) std::cerr << "ERROR: " << msg << std::endl
-#define LOG_INFO(msg) std::cout << "INFO: " << msg << std::endl
-#define LOG_DEBUG(msg) std::cout << "DEBUG: " << msg << std::endl
-
 // Simple assertion macro
 #define ENSURE(condition, error_msg) \
     if (!(condition)) { \
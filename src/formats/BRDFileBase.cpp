@@ -1,9 +1,15 @@
 #include "BRDFileBase.h"
+#include "SpatialOrder.h"
 #include <limits>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
 
 void BRDFileBase::GetBoundingBox(BRDPoint& min_point, BRDPoint& max_point) const {
-    if (pins.empty() && parts.empty() && format.empty()) {
+    BRDPoint pending_min, pending_max;
+    bool has_pending = GetPendingPartBounds(pending_min, pending_max);
+    if (pins.empty() && parts.empty() && format.empty() && !has_pending) {
         min_point = {0, 0};
         max_point = {0, 0};
         return;
@@ -14,6 +20,14 @@ void BRDFileBase::GetBoundingBox(BRDPoint& min_point, BRDPoint& max_point) const
     int min_y = std::numeric_limits<int>::max();
     int max_y = std::numeric_limits<int>::min();
 
+    // Parts that are not parsed yet still belong to the board
+    if (has_pending) {
+        min_x = pending_min.x;
+        max_x = pending_max.x;
+        min_y = pending_min.y;
+        max_y = pending_max.y;
+    }
+
     // Check pins
     for (const auto& pin : pins) {
         min_x = std::min(min_x, pin.pos.x);
@@ -52,16 +66,158 @@ BRDPoint BRDFileBase::GetCenter() const {
     };
 }
 
+size_t BRDFileBase::PadStackKeyHash::operator()(const PadStackKey& key) const {
+    uint32_t bits[3];
+    std::memcpy(&bits[0], &key.width, 4);
+    std::memcpy(&bits[1], &key.height, 4);
+    std::memcpy(&bits[2], &key.rotation, 4);
+    size_t hash = static_cast<size_t>(key.shape);
+    for (uint32_t word : bits) {
+        hash = hash * 1000003u ^ word;
+    }
+    return hash;
+}
+
+uint32_t BRDFileBase::AddPadStack(BRDPadShape shape, float width, float height, float rotation) {
+    PadStackKey key{shape, width, height, rotation};
+    auto it = pad_stack_lookup.find(key);
+    if (it != pad_stack_lookup.end()) {
+        return it->second;
+    }
+
+    BRDPadStack stack;
+    stack.shape = shape;
+    stack.width = width;
+    stack.height = height;
+    stack.rotation = rotation;
+    if (shape == BRDPadShape::Circle) {
+        stack.extent_x = stack.extent_y = stack.GetRadius();
+    } else {
+        float rot_rad = rotation * 3.14159265f / 180.0f;
+        stack.cos_rotation = std::cos(rot_rad);
+        stack.sin_rotation = std::sin(rot_rad);
+        float cos_abs = std::abs(stack.cos_rotation);
+        float sin_abs = std::abs(stack.sin_rotation);
+        stack.extent_x = width * 0.5f * cos_abs + height * 0.5f * sin_abs;
+        stack.extent_y = width * 0.5f * sin_abs + height * 0.5f * cos_abs;
+    }
+
+    uint32_t index = static_cast<uint32_t>(pad_stacks.size());
+    pad_stacks.push_back(stack);
+    pad_stack_lookup.emplace(key, index);
+    return index;
+}
+
+void BRDFileBase::AddPad(BRDPoint center, uint32_t stack, uint32_t pin) {
+    BRDPad pad;
+    pad.center = center;
+    pad.stack = stack;
+    pad.pin = pin;
+    switch (pad_stacks[stack].shape) {
+        case BRDPadShape::Circle: circles.push_back(pad); break;
+        case BRDPadShape::Rectangle: rectangles.push_back(pad); break;
+        case BRDPadShape::Oval: ovals.push_back(pad); break;
+    }
+}
+
+void BRDFileBase::SortPadsSpatially(size_t first_circle, size_t first_rectangle, size_t first_oval) {
+    auto sort_pads = [](std::vector<BRDPad>& pads, size_t first) {
+        if (first >= pads.size()) {
+            return;
+        }
+        std::vector<uint32_t> order = SpatialOrder::MortonOrder(pads.size() - first, [&](size_t i) { return pads[first + i].center; });
+        std::vector<BRDPad> sorted;
+        sorted.reserve(order.size());
+        for (uint32_t i : order) {
+            sorted.push_back(pads[first + i]);
+        }
+        std::copy(sorted.begin(), sorted.end(), pads.begin() + first);
+    };
+    sort_pads(circles, first_circle);
+    sort_pads(rectangles, first_rectangle);
+    sort_pads(ovals, first_oval);
+}
+
+const size_t BRDFileBase::kTextCacheGroups;
+
+std::string_view BRDFileBase::GetPinText(size_t pin, int field) const {
+    if (pin < pin_texts.size()) {
+        const BRDPinText& text = pin_texts[pin];
+        return strings.Get(field == 0 ? text.snum : field == 1 ? text.name : text.comment);
+    }
+
+    uint32_t group = 0;
+    uint32_t first_pin = 0;
+    if (pin >= pins.size() || !FindPinTextGroup(pin, group, first_pin)) {
+        return strings.Get(StringRef());
+    }
+    auto it = text_cache.find(group);
+    if (it == text_cache.end()) {
+        TextCacheEntry entry;
+        entry.first_pin = first_pin;
+        if (!ReadPinTextGroup(group, entry.text)) {
+            // Cached empty, so a missing file is not read again on every frame
+            LOG_WARNING("Pin text of group " << group << " could not be read");
+            entry.text.clear();
+        }
+        it = text_cache.emplace(group, std::move(entry)).first;
+    }
+    it->second.last_use = ++text_cache_clock;
+    size_t index = (pin - it->second.first_pin) * 3 + field;
+    return index < it->second.text.size() ? std::string_view(it->second.text[index]) : strings.Get(StringRef());
+}
+
+std::string_view BRDFileBase::GetPinNumber(size_t pin) const {
+    std::string_view number = GetPinText(pin, 0);
+    return number.empty() ? GetPinText(pin, 1) : number;
+}
+
+std::string_view BRDFileBase::GetPinName(size_t pin) const {
+    return GetPinText(pin, 1);
+}
+
+std::string_view BRDFileBase::GetPinComment(size_t pin) const {
+    return GetPinText(pin, 2);
+}
+
+void BRDFileBase::TrimTextCache(size_t groups) {
+    if (text_cache.size() <= groups) {
+        return;
+    }
+    // Oldest use first; everything up to the cut goes
+    std::vector<uint64_t> uses;
+    uses.reserve(text_cache.size());
+    for (const auto& entry : text_cache) {
+        uses.push_back(entry.second.last_use);
+    }
+    size_t drop = text_cache.size() - groups;
+    std::nth_element(uses.begin(), uses.begin() + (drop - 1), uses.end());
+    uint64_t cut = uses[drop - 1];
+    for (auto it = text_cache.begin(); it != text_cache.end();) {
+        it = it->second.last_use <= cut ? text_cache.erase(it) : std::next(it);
+    }
+}
+
+void BRDFileBase::ClearTextCache() {
+    text_cache.clear();
+    text_cache_clock = 0;
+}
+
 void BRDFileBase::ClearData() {
     format.clear();
     outline_segments.clear();
     part_outline_segments.clear();
     parts.clear();
     pins.clear();
+    pin_texts.clear();
+    ClearTextCache();
     nails.clear();
+    pad_stacks.clear();
+    pad_stack_lookup.clear();
     circles.clear();
     rectangles.clear();
     ovals.clear();
+    strings.Clear();
     
     num_format = 0;
     num_parts = 0;
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "BRDTypes.h"
+#include "LoadReport.h"
 #include "Utils.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 // Base class for all PCB file formats
 class BRDFileBase {
@@ -21,15 +24,21 @@ public:
     std::vector<std::pair<BRDPoint, BRDPoint>> part_outline_segments; // Part outline segments
     std::vector<BRDPart> parts;                                     // Components
     std::vector<BRDPin> pins;                                       // Pins/pads
+    std::vector<BRDPinText> pin_texts;                              // Text of each pin (empty with lazy text)
     std::vector<BRDNail> nails;                                     // Test points
-    std::vector<BRDCircle> circles;                                 // Circles for rendering
-    std::vector<BRDRectangle> rectangles;                           // Rectangles for rendering
-    std::vector<BRDOval> ovals;                                     // Ovals for rendering
+    std::vector<BRDPadStack> pad_stacks;                            // Unique pad geometries
+    std::vector<BRDPad> circles;                                    // Pads by shape, for rendering
+    std::vector<BRDPad> rectangles;
+    std::vector<BRDPad> ovals;
+    StringArena strings;                                            // All part/pin/nail text
 
     // Status
     bool valid = false;
     std::string error_msg = "";
 
+    // Timings and counters of the last Load()
+    LoadReport load_report;
+
     // Constructor/Destructor
     BRDFileBase() = default;
     virtual ~BRDFileBase() = default;
@@ -40,6 +49,47 @@ public:
     bool IsValid() const { return valid; }
     const std::string& GetErrorMessage() const { return error_msg; }
     void SetValid(bool v) { valid = v; }
+
+    // Text of a part/pin/nail field
+    std::string_view GetString(StringRef ref) const { return strings.Get(ref); }
+    const char* GetCString(StringRef ref) const { return strings.GetCString(ref); }
+    StringRef Intern(std::string_view text) { return strings.Intern(text); }
+    const LoadReport& GetLoadReport() const { return load_report; }
+
+    // Text of a pin, from pin_texts or, for boards loaded with lazy text, read back from the
+    // file the first time a pin of its group is asked for and kept in a bounded cache. Views are
+    // NUL-terminated and stay valid until the next TrimTextCache().
+    std::string_view GetPinNumber(size_t pin) const;    // snum, falling back to the name
+    std::string_view GetPinName(size_t pin) const;
+    std::string_view GetPinComment(size_t pin) const;
+    // Drops the least recently used groups of lazily read text beyond `groups`. Called between
+    // frames, so the labels of one frame are never dropped while it is drawn.
+    static const size_t kTextCacheGroups = 4096;
+    void TrimTextCache(size_t groups = kTextCacheGroups);
+    size_t GetCachedTextGroups() const { return text_cache.size(); }
+
+    // Pad stack with this geometry, added to pad_stacks the first time it is seen
+    uint32_t AddPadStack(BRDPadShape shape, float width, float height, float rotation);
+    // Places a pad of an existing stack into circles/rectangles/ovals by the stack's shape
+    void AddPad(BRDPoint center, uint32_t stack, uint32_t pin);
+    const BRDPadStack& GetPadStack(const BRDPad& pad) const { return pad_stacks[pad.stack]; }
+    // Reorders circles/rectangles/ovals along a Z-order curve once the board is in place.
+    // Pads are referenced only through their pin, so no other index changes. Pads before the
+    // given indices keep their places: parts parsed later sort only the pads they appended.
+    void SortPadsSpatially(size_t first_circle = 0, size_t first_rectangle = 0, size_t first_oval = 0);
+
+    // Parts whose blocks were indexed but not parsed yet (index-only loads). Formats that
+    // always parse everything keep the defaults. The Load* calls parse the pending parts that
+    // overlap a region / carry a name, append them to parts/pins/pads and return how many
+    // part blocks they parsed. A region load takes at most `limit` parts, nearest its centre first.
+    virtual size_t GetPendingPartCount() const { return 0; }
+    virtual size_t LoadPendingParts(BRDPoint min_point, BRDPoint max_point, size_t limit = SIZE_MAX) {
+        (void)min_point; (void)max_point; (void)limit; return 0;
+    }
+    virtual size_t LoadPendingPartsNamed(std::string_view name) { (void)name; return 0; }
+    virtual size_t LoadAllPendingParts() { return 0; }
+    // Extent of the pending parts; false when there are none
+    virtual bool GetPendingPartBounds(BRDPoint& min_point, BRDPoint& max_point) const { (void)min_point; (void)max_point; return false; }
     
     // Get bounding box of the PCB
     void GetBoundingBox(BRDPoint& min_point, BRDPoint& max_point) const;
@@ -51,4 +101,37 @@ protected:
     // Helper functions for derived classes
     void ClearData();
     bool ValidateData();
+
+    // Lazy text: formats that leave pin_texts empty split their pins into groups of consecutive
+    // pins whose text is read together. FindPinTextGroup() names the group of a pin and its first
+    // pin; ReadPinTextGroup() returns three strings per pin of the group (number, name, comment).
+    virtual bool FindPinTextGroup(size_t pin, uint32_t& group, uint32_t& first_pin) const {
+        (void)pin; (void)group; (void)first_pin; return false;
+    }
+    virtual bool ReadPinTextGroup(uint32_t group, std::vector<std::string>& text) const { (void)group; (void)text; return false; }
+    void ClearTextCache();
+
+private:
+    struct PadStackKey {
+        BRDPadShape shape;
+        float width, height, rotation;
+        bool operator==(const PadStackKey& other) const {
+            return shape == other.shape && width == other.width && height == other.height && rotation == other.rotation;
+        }
+    };
+    struct PadStackKeyHash {
+        size_t operator()(const PadStackKey& key) const;
+    };
+    std::unordered_map<PadStackKey, uint32_t, PadStackKeyHash> pad_stack_lookup;
+
+    // Text of a pin from pin_texts or the lazy text cache: field 0 number, 1 name, 2 comment
+    std::string_view GetPinText(size_t pin, int field) const;
+
+    struct TextCacheEntry {
+        uint32_t first_pin = 0;
+        uint64_t last_use = 0;
+        std::vector<std::string> text;
+    };
+    mutable std::unordered_map<uint32_t, TextCacheEntry> text_cache;    // By group
+    mutable uint64_t text_cache_clock = 0;
 };
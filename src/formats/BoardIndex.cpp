@@ -0,0 +1,92 @@
+#include "BoardIndex.h"
+#include <algorithm>
+
+BoardIndex::BoardIndex(const BRDFileBase& source) : board(source) {
+    const size_t part_count = board.parts.size();
+    const size_t pin_count = board.pins.size();
+
+    parts_by_name.resize(part_count);
+    for (size_t i = 0; i < part_count; ++i) {
+        parts_by_name[i] = static_cast<uint32_t>(i);
+    }
+    std::stable_sort(parts_by_name.begin(), parts_by_name.end(), [&](uint32_t a, uint32_t b) {
+        return board.GetString(board.parts[a].name) < board.GetString(board.parts[b].name);
+    });
+
+    // Distinct net names, then each pin's position in that list
+    std::vector<std::string_view> names;
+    names.reserve(pin_count);
+    for (const BRDPin& pin : board.pins) {
+        names.push_back(board.GetString(pin.net));
+    }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    net_names.assign(names.begin(), names.end());
+
+    pin_net.resize(pin_count);
+    std::vector<uint32_t> pin_part(pin_count);
+    for (size_t i = 0; i < pin_count; ++i) {
+        const BRDPin& pin = board.pins[i];
+        pin_net[i] = static_cast<uint32_t>(std::lower_bound(names.begin(), names.end(), board.GetString(pin.net)) - names.begin());
+        // BRDPin::part is 1-based with 0 for no part
+        pin_part[i] = pin.part >= 1 && pin.part <= part_count ? pin.part - 1 : static_cast<uint32_t>(part_count);
+    }
+
+    // Pins without a part (or with an out-of-range one) land in one extra bucket that is never returned
+    BuildRanges(pin_part, part_count + 1, part_offsets, part_pins);
+    BuildRanges(pin_net, net_names.size(), net_offsets, net_pins);
+}
+
+void BoardIndex::BuildRanges(const std::vector<uint32_t>& pin_keys, size_t key_count,
+                             std::vector<uint32_t>& offsets, std::vector<uint32_t>& pins) {
+    offsets.assign(key_count + 1, 0);
+    for (uint32_t key : pin_keys) {
+        offsets[key + 1]++;
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+    pins.resize(pin_keys.size());
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t pin = 0; pin < pin_keys.size(); ++pin) {
+        pins[cursor[pin_keys[pin]]++] = static_cast<uint32_t>(pin);
+    }
+}
+
+uint32_t BoardIndex::FindPart(std::string_view name) const {
+    auto it = std::lower_bound(parts_by_name.begin(), parts_by_name.end(), name, [&](uint32_t part, std::string_view key) {
+        return board.GetString(board.parts[part].name) < key;
+    });
+    if (it == parts_by_name.end() || board.GetString(board.parts[*it].name) != name) {
+        return kNotFound;
+    }
+    return *it;
+}
+
+BoardIndex::PinRange BoardIndex::GetPartPins(uint32_t part) const {
+    PinRange range;
+    if (part < board.parts.size()) {
+        range.pins = part_pins.data() + part_offsets[part];
+        range.count = part_offsets[part + 1] - part_offsets[part];
+    }
+    return range;
+}
+
+uint32_t BoardIndex::FindNet(std::string_view name) const {
+    auto it = std::lower_bound(net_names.begin(), net_names.end(), name, [](const std::string& net, std::string_view key) {
+        return std::string_view(net) < key;
+    });
+    if (it == net_names.end() || *it != name) {
+        return kNotFound;
+    }
+    return static_cast<uint32_t>(it - net_names.begin());
+}
+
+BoardIndex::PinRange BoardIndex::GetNetPins(uint32_t net) const {
+    PinRange range;
+    if (net < net_names.size()) {
+        range.pins = net_pins.data() + net_offsets[net];
+        range.count = net_offsets[net + 1] - net_offsets[net];
+    }
+    return range;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "BRDFileBase.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Lookups over a loaded board that the flat part/pin arrays do not answer directly:
+// parts by name, the net list, and the pins of each part and each net.
+// Built once after loading; the board must outlive the index.
+class BoardIndex {
+public:
+    static const uint32_t kNotFound = 0xFFFFFFFFu;
+
+    // Pin indices of one part or net
+    struct PinRange {
+        const uint32_t* pins = nullptr;
+        uint32_t count = 0;
+    };
+
+    explicit BoardIndex(const BRDFileBase& board);
+
+    // First part with this name, or kNotFound
+    uint32_t FindPart(std::string_view name) const;
+    PinRange GetPartPins(uint32_t part) const;
+
+    // Nets are the distinct pin net names, sorted by name
+    uint32_t GetNetCount() const { return static_cast<uint32_t>(net_names.size()); }
+    const std::string& GetNetName(uint32_t net) const { return net_names[net]; }
+    uint32_t FindNet(std::string_view name) const;
+    PinRange GetNetPins(uint32_t net) const;
+
+    // Net index of a pin
+    uint32_t GetPinNet(uint32_t pin) const { return pin_net[pin]; }
+
+private:
+    // Groups pin indices by key (counting sort): offsets has keys + 1 entries
+    static void BuildRanges(const std::vector<uint32_t>& pin_keys, size_t key_count,
+                            std::vector<uint32_t>& offsets, std::vector<uint32_t>& pins);
+
+    const BRDFileBase& board;
+    std::vector<uint32_t> parts_by_name;     // Part indices sorted by name
+    std::vector<std::string> net_names;
+    std::vector<uint32_t> pin_net;
+    std::vector<uint32_t> part_offsets;
+    std::vector<uint32_t> part_pins;
+    std::vector<uint32_t> net_offsets;
+    std::vector<uint32_t> net_pins;
+};
@@ -0,0 +1,168 @@
+#include "BoardSource.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+const uint64_t BoardSource::kNotFound;
+const size_t FileBoardSource::kDefaultWindowBytes;
+const size_t FileBoardSource::kSeekFillBytes;
+
+// Searches read this much at a time (plus the pattern overlap)
+static const size_t kSearchChunk = 64 * 1024;
+
+bool BoardSource::Read(uint64_t pos, void* out, size_t count) {
+    if (pos > size || count > size - pos) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    if (!ReadRaw(pos, out, count)) {
+        return false;
+    }
+    if (xor_key != 0 && pos < xor_end) {
+        char* bytes = static_cast<char*>(out);
+        size_t xor_count = static_cast<size_t>(std::min<uint64_t>(count, xor_end - pos));
+        for (size_t i = 0; i < xor_count; ++i) {
+            bytes[i] ^= static_cast<char>(xor_key);
+        }
+    }
+    return true;
+}
+
+bool BoardSource::ReadInto(uint64_t pos, size_t count, std::vector<char>& out) {
+    size_t old_size = out.size();
+    out.resize(old_size + count);
+    if (!Read(pos, out.data() + old_size, count)) {
+        out.resize(old_size);
+        return false;
+    }
+    return true;
+}
+
+void BoardSource::SetXor(uint8_t key, uint64_t end) {
+    xor_key = key;
+    xor_end = std::min(end, size);
+}
+
+uint64_t BoardSource::Find(const char* pattern, size_t length, uint64_t from, uint64_t to) {
+    return FindEach({std::string_view(pattern, length)}, from, to)[0];
+}
+
+std::vector<uint64_t> BoardSource::FindEach(const std::vector<std::string_view>& patterns, uint64_t from, uint64_t to) {
+    std::vector<uint64_t> found(patterns.size(), kNotFound);
+    size_t longest = 0;
+    for (std::string_view pattern : patterns) {
+        longest = std::max(longest, pattern.size());
+    }
+    to = std::min(to, size);
+    if (longest == 0 || from >= to) {
+        return found;
+    }
+
+    // Consecutive chunks overlap by longest - 1 bytes so a match across a boundary is seen
+    std::vector<char> chunk(kSearchChunk + longest - 1);
+    size_t remaining = patterns.size();
+    for (uint64_t pos = from; pos < to && remaining > 0; pos += kSearchChunk) {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(chunk.size(), to - pos));
+        if (!Read(pos, chunk.data(), count)) {
+            break;
+        }
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            if (found[i] != kNotFound || patterns[i].empty()) {
+                continue;
+            }
+            auto match = std::search(chunk.begin(), chunk.begin() + count, patterns[i].begin(), patterns[i].end());
+            if (match != chunk.begin() + count) {
+                found[i] = pos + static_cast<uint64_t>(match - chunk.begin());
+                remaining--;
+            }
+        }
+    }
+    return found;
+}
+
+uint64_t BoardSource::FindLast(char byte, uint64_t before) {
+    before = std::min(before, size);
+    std::vector<char> chunk(kSearchChunk);
+    while (before > 0) {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(chunk.size(), before));
+        uint64_t start = before - count;
+        if (!Read(start, chunk.data(), count)) {
+            return kNotFound;
+        }
+        for (size_t i = count; i-- > 0;) {
+            if (chunk[i] == byte) {
+                return start + i;
+            }
+        }
+        before = start;
+    }
+    return kNotFound;
+}
+
+MemoryBoardSource::MemoryBoardSource(const char* data, size_t length) : data(data) {
+    size = length;
+}
+
+bool MemoryBoardSource::ReadRaw(uint64_t pos, void* out, size_t count) {
+    std::memcpy(out, data + pos, count);
+    return true;
+}
+
+FileBoardSource::FileBoardSource(size_t window_bytes) : window(std::max<size_t>(window_bytes, 4096)) {}
+
+bool FileBoardSource::Open(const std::string& path) {
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    std::streamoff end = file.tellg();
+    if (end < 0) {
+        return false;
+    }
+    size = static_cast<uint64_t>(end);
+    window_fill = 0;
+    return true;
+}
+
+bool FileBoardSource::Fetch(uint64_t pos, char* out, size_t count) {
+    auto start = std::chrono::steady_clock::now();
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(pos), std::ios::beg);
+    file.read(out, static_cast<std::streamsize>(count));
+    bool ok = file.gcount() == static_cast<std::streamsize>(count);
+    bytes_fetched += static_cast<uint64_t>(file.gcount());
+    fetch_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return ok;
+}
+
+bool FileBoardSource::ReadRaw(uint64_t pos, void* out, size_t count) {
+    if (count > window.size()) {
+        return Fetch(pos, static_cast<char*>(out), count);
+    }
+    uint64_t window_end = window_start + window_fill;
+    if (pos < window_start || pos + count > window_end) {
+        // A read running on past either edge of the window refills a whole window in that
+        // direction; a jump elsewhere (header fields, the net block) takes only kSeekFillBytes
+        uint64_t start = pos;
+        uint64_t end = pos + std::max(count, std::min(kSeekFillBytes, window.size()));
+        if (window_fill > 0 && pos >= window_start && pos <= window_end) {
+            end = pos + window.size();
+        } else if (window_fill > 0 && pos < window_start && pos + count >= window_start) {
+            end = pos + count;
+            start = end - std::min<uint64_t>(end, window.size());
+        }
+        end = std::min(end, size);
+        size_t fill = static_cast<size_t>(end - start);
+        window_fill = 0;
+        if (!Fetch(start, window.data(), fill)) {
+            return false;
+        }
+        window_start = start;
+        window_fill = fill;
+    }
+    std::memcpy(out, window.data() + (pos - window_start), count);
+    return true;
+}
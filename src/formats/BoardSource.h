@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Random access to the bytes of a board file with 64-bit positions, so the parser can walk
+// files of any size without holding them. Bytes before the XOR end are de-obfuscated as they
+// are read; nothing is modified in place.
+class BoardSource {
+public:
+    static const uint64_t kNotFound = ~0ull;
+
+    virtual ~BoardSource() = default;
+
+    uint64_t GetSize() const { return size; }
+
+    // Copies [pos, pos + count) to `out`; false when the range leaves the source or a read fails
+    bool Read(uint64_t pos, void* out, size_t count);
+    bool ReadU32(uint64_t pos, uint32_t& value) { return Read(pos, &value, sizeof(value)); }
+    // Appends [pos, pos + count) to `out`
+    bool ReadInto(uint64_t pos, size_t count, std::vector<char>& out);
+
+    // XOR key applied to every byte before `end` from now on
+    void SetXor(uint8_t key, uint64_t end);
+
+    // First position in [from, to) where `pattern` starts, or kNotFound
+    uint64_t Find(const char* pattern, size_t length, uint64_t from = 0, uint64_t to = kNotFound);
+    // First position of each pattern in one pass over [from, to); kNotFound where absent
+    std::vector<uint64_t> FindEach(const std::vector<std::string_view>& patterns, uint64_t from = 0, uint64_t to = kNotFound);
+    // Last position before `before` holding `byte`, or kNotFound
+    uint64_t FindLast(char byte, uint64_t before);
+
+    // Bytes fetched from the backing store and the time spent doing so
+    uint64_t GetBytesFetched() const { return bytes_fetched; }
+    double GetFetchMs() const { return fetch_ms; }
+
+protected:
+    virtual bool ReadRaw(uint64_t pos, void* out, size_t count) = 0;
+
+    uint64_t size = 0;
+    uint64_t bytes_fetched = 0;
+    double fetch_ms = 0.0;
+
+private:
+    uint8_t xor_key = 0;
+    uint64_t xor_end = 0;
+};
+
+// A board already in memory (Load() from a buffer)
+class MemoryBoardSource : public BoardSource {
+public:
+    MemoryBoardSource(const char* data, size_t length);
+    explicit MemoryBoardSource(const std::vector<char>& buffer) : MemoryBoardSource(buffer.data(), buffer.size()) {}
+
+protected:
+    bool ReadRaw(uint64_t pos, void* out, size_t count) override;
+
+private:
+    const char* data;
+};
+
+// A board file read through one fixed-size window: memory use does not depend on the file
+// size. Reads larger than the window bypass it; reads that jump away from the window fetch
+// only kSeekFillBytes, so scattered header reads do not cost a whole window each.
+class FileBoardSource : public BoardSource {
+public:
+    static const size_t kDefaultWindowBytes = 1 << 20;
+    static const size_t kSeekFillBytes = 64 * 1024;
+
+    explicit FileBoardSource(size_t window_bytes = kDefaultWindowBytes);
+
+    bool Open(const std::string& path);
+    size_t GetWindowBytes() const { return window.size(); }
+
+protected:
+    bool ReadRaw(uint64_t pos, void* out, size_t count) override;
+
+private:
+    bool Fetch(uint64_t pos, char* out, size_t count);
+
+    std::ifstream file;
+    std::vector<char> window;
+    uint64_t window_start = 0;
+    size_t window_fill = 0;
+};
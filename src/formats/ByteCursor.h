@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// Builds with PCB_CHECKED_CURSOR (CMake option) verify every unchecked load as well and abort
+// on one that leaves the range, so fuzzing finds a decoder whose hoisted check is too short
+#ifndef PCB_CHECKED_CURSOR
+#define PCB_CHECKED_CURSOR 0
+#endif
+
+// Little-endian reads from a byte range, with fields at any alignment (loads are memcpy).
+// A decoder checks the extent of a record once with Has() and then loads its fields with
+// Peek() at record-relative offsets, branch-free; Read*/Skip check and advance. Failed calls
+// leave the position unchanged.
+class ByteCursor {
+public:
+    ByteCursor() = default;
+    ByteCursor(const void* data, size_t size) : data(static_cast<const uint8_t*>(data)), size(size) {}
+
+    size_t GetPosition() const { return pos; }
+    size_t GetSize() const { return size; }
+    size_t GetRemaining() const { return size - pos; }
+    bool AtEnd() const { return pos >= size; }
+
+    // True when [position + offset, position + offset + count) is in range
+    bool Has(size_t count, size_t offset = 0) const {
+        return offset <= size - pos && count <= size - pos - offset;
+    }
+
+    bool Seek(size_t position) {
+        if (position > size) {
+            return false;
+        }
+        pos = position;
+        return true;
+    }
+    bool Skip(size_t count) {
+        if (!Has(count)) {
+            return false;
+        }
+        pos += count;
+        return true;
+    }
+    // Skips `count` bytes, stopping at the end when fewer are left
+    void SkipClamped(size_t count) { pos += count < size - pos ? count : size - pos; }
+
+    // Field at position + offset; the caller has checked the range with Has()
+    template <typename T>
+    T Peek(size_t offset = 0) const {
+        static_assert(std::is_integral<T>::value, "ByteCursor loads integers");
+        Verify(offset, sizeof(T));
+        T value;
+        std::memcpy(&value, data + pos + offset, sizeof(T));
+        return FromLittleEndian(value);
+    }
+    std::string_view PeekBytes(size_t offset, size_t count) const {
+        Verify(offset, count);
+        return std::string_view(reinterpret_cast<const char*>(data + pos + offset), count);
+    }
+
+    template <typename T>
+    bool Read(T& value) {
+        if (!Has(sizeof(T))) {
+            return false;
+        }
+        value = Peek<T>();
+        pos += sizeof(T);
+        return true;
+    }
+    bool ReadBytes(size_t count, std::string_view& out) {
+        if (!Has(count)) {
+            return false;
+        }
+        out = PeekBytes(0, count);
+        pos += count;
+        return true;
+    }
+    // Bytes preceded by their 32-bit length
+    bool ReadString32(std::string_view& out) {
+        if (!Has(4)) {
+            return false;
+        }
+        uint32_t length = Peek<uint32_t>();
+        if (!Has(length, 4)) {
+            return false;
+        }
+        out = PeekBytes(4, length);
+        pos += 4 + static_cast<size_t>(length);
+        return true;
+    }
+
+private:
+    template <typename T>
+    static T FromLittleEndian(T value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        typename std::make_unsigned<T>::type bits = static_cast<typename std::make_unsigned<T>::type>(value);
+        typename std::make_unsigned<T>::type swapped = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            swapped = static_cast<typename std::make_unsigned<T>::type>((swapped << 8) | (bits & 0xFF));
+            bits = static_cast<typename std::make_unsigned<T>::type>(bits >> 8);
+        }
+        return static_cast<T>(swapped);
+#else
+        return value;
+#endif
+    }
+
+    void Verify(size_t offset, size_t count) const {
+#if PCB_CHECKED_CURSOR
+        if (!Has(count, offset)) {
+            std::fprintf(stderr, "ByteCursor: unchecked load of %zu bytes at %zu + %zu leaves a %zu-byte range\n",
+                         count, pos, offset, size);
+            std::abort();
+        }
+#else
+        (void)offset;
+        (void)count;
+#endif
+    }
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+};
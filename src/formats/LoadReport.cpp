@@ -0,0 +1,218 @@
+#include "LoadReport.h"
+#include <cstdio>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+    std::string EscapeJson(const std::string& text) {
+        std::string out;
+        out.reserve(text.size() + 2);
+        for (char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                        out += escaped;
+                    } else {
+                        out += c;
+                    }
+                    break;
+            }
+        }
+        return out;
+    }
+
+    const char* GetBlockTypeName(int type) {
+        switch (type) {
+            case 0x01: return "arc";
+            case 0x02: return "via";
+            case 0x05: return "line";
+            case 0x06: return "text";
+            case 0x07: return "part";
+            case 0x09: return "test_pad";
+            default: return nullptr;
+        }
+    }
+
+    // Minimal writer for the report: tracks commas and indentation
+    class JsonWriter {
+    public:
+        explicit JsonWriter(int indent_width) : indent(indent_width) {}
+
+        void BeginObject(const char* key = nullptr) { Key(key); out << '{'; depth++; first = true; }
+        void EndObject() { depth--; if (!first) NewLine(); out << '}'; first = false; }
+
+        void Value(const char* key, const std::string& value) { Key(key); out << '"' << EscapeJson(value) << '"'; }
+        void Value(const char* key, bool value) { Key(key); out << (value ? "true" : "false"); }
+        void Value(const char* key, double value) {
+            Key(key);
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.3f", value);
+            out << text;
+        }
+        template <typename T>
+        void Integer(const char* key, T value) { Key(key); out << value; }
+
+        std::string Str() const { return out.str(); }
+
+    private:
+        void NewLine() {
+            if (indent > 0) {
+                out << '\n' << std::string(static_cast<size_t>(depth * indent), ' ');
+            }
+        }
+        void Key(const char* key) {
+            if (depth > 0) {
+                if (!first) out << ',';
+                NewLine();
+            }
+            first = false;
+            if (key) {
+                out << '"' << key << "\":" << (indent > 0 ? " " : "");
+            }
+        }
+
+        std::ostringstream out;
+        int indent = 2;
+        int depth = 0;
+        bool first = true;
+    };
+}
+
+const char* LoadReport::GetPhaseName(LoadPhase phase) {
+    switch (phase) {
+        case LoadPhase::Read: return "read";
+        case LoadPhase::Xor: return "xor";
+        case LoadPhase::MarkerSearch: return "marker_search";
+        case LoadPhase::NetBlock: return "net_block";
+        case LoadPhase::DES: return "des";
+        case LoadPhase::ArcBlocks: return "arc_blocks";
+        case LoadPhase::LineBlocks: return "line_blocks";
+        case LoadPhase::PartBlocks: return "part_blocks";
+        case LoadPhase::PartIndex: return "part_index";
+        case LoadPhase::TestPadBlocks: return "test_pad_blocks";
+        case LoadPhase::Json: return "json";
+        case LoadPhase::Translate: return "translate";
+        case LoadPhase::SpatialSort: return "spatial_sort";
+        default: return "?";
+    }
+}
+
+std::string LoadReport::ToJson(int indent) const {
+    JsonWriter json(indent);
+    json.BeginObject();
+    json.Value("file", file_path);
+    json.Value("success", success);
+    if (!error.empty()) {
+        json.Value("error", error);
+    }
+    json.Value("total_ms", total_ms);
+
+    json.BeginObject("phases_ms");
+    for (size_t i = 0; i < phase_ms.size(); ++i) {
+        json.Value(GetPhaseName(static_cast<LoadPhase>(i)), phase_ms[i]);
+    }
+    json.EndObject();
+
+    json.BeginObject("bytes");
+    json.Integer("file", file_bytes);
+    json.Integer("read", read_bytes);
+    json.Integer("xor", xor_bytes);
+    json.Integer("net_block", net_block_bytes);
+    json.Integer("main_blocks", main_block_bytes);
+    json.Integer("des", des_bytes);
+    json.Integer("json", json_bytes);
+    json.EndObject();
+
+    json.BeginObject("blocks");
+    for (int type = 0; type < 256; ++type) {
+        if (block_counts[type] == 0) {
+            continue;
+        }
+        char key[24];
+        const char* name = GetBlockTypeName(type);
+        if (name) {
+            std::snprintf(key, sizeof(key), "%s", name);
+        } else {
+            std::snprintf(key, sizeof(key), "0x%02X", type);
+        }
+        json.Integer(key, block_counts[type]);
+    }
+    json.EndObject();
+    json.Integer("unknown_blocks", unknown_blocks);
+    json.Integer("truncated_blocks", truncated_blocks);
+    json.Integer("skipped_sub_blocks", skipped_sub_blocks);
+    json.Integer("unknown_sub_blocks", unknown_sub_blocks);
+    json.Integer("malformed_records", malformed_records);
+    json.Integer("deferred_parts", deferred_parts);
+    json.Integer("stored_part_boxes", stored_part_boxes);
+    json.Integer("pin_text_groups", pin_text_groups);
+
+    json.BeginObject("output");
+    json.Integer("nets", nets);
+    json.Integer("parts", parts);
+    json.Integer("pins", pins);
+    json.Integer("outline_segments", outline_segments);
+    json.Integer("part_outline_segments", part_outline_segments);
+    json.Integer("pad_shapes", pad_shapes);
+    json.Integer("pad_stacks", pad_stacks);
+    json.Integer("part_aliases", part_aliases);
+    json.Integer("diode_readings", diode_readings);
+    json.EndObject();
+
+    json.BeginObject("memory");
+    json.Integer("strings", strings);
+    json.Integer("string_bytes", string_bytes);
+    json.Integer("peak_heap_bytes", peak_heap_bytes);
+    json.Integer("peak_resident_bytes", peak_resident_bytes);
+    json.EndObject();
+
+    json.EndObject();
+    return json.Str();
+}
+
+std::string LoadReport::Summary() const {
+    char text[256];
+    std::snprintf(text, sizeof(text),
+                  "%s in %.1f ms: %u parts, %u pins, %u nets, %u outline segments (%u unknown blocks, %u unknown sub-blocks)",
+                  success ? "loaded" : "failed", total_ms, parts, pins, nets, outline_segments,
+                  unknown_blocks, unknown_sub_blocks);
+    return text;
+}
+
+namespace LoadReportUtil {
+    uint64_t QueryPeakResidentBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+        }
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+#ifdef __APPLE__
+        return static_cast<uint64_t>(usage.ru_maxrss);          // bytes
+#else
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;   // kilobytes
+#endif
+#endif
+    }
+}
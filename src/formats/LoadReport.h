@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Parse phases timed by the loader. Times are wall clock and inclusive: the part block
+// phase contains the DES time of those blocks, JSON contains nothing else.
+enum class LoadPhase : uint8_t {
+    Read = 0,        // File reads (file loads stream, so this overlaps the phases below)
+    Xor,             // XOR de-obfuscation; undone as bytes are read, so its time is in the other phases
+    MarkerSearch,    // v6v6555v6v6 marker and JSON trailer search
+    NetBlock,        // Net name table
+    DES,             // Part block decryption
+    ArcBlocks,
+    LineBlocks,
+    PartBlocks,
+    PartIndex,       // Index-only loads: part names and pin extents of deferred part blocks
+    TestPadBlocks,
+    Json,            // JSON trailer (aliases, diode readings)
+    Translate,       // Moving the board to the origin
+    SpatialSort,     // Morton ordering of the pad arrays
+    Count
+};
+
+// Machine-readable summary of one Load() call, kept with the board so the viewer
+// and the command line tools can show or export it
+struct LoadReport {
+    std::string file_path;
+    bool success = false;
+    std::string error;
+
+    double total_ms = 0.0;
+    std::array<double, static_cast<size_t>(LoadPhase::Count)> phase_ms{};
+
+    // Bytes
+    uint64_t file_bytes = 0;
+    uint64_t read_bytes = 0;         // Fetched from disk by streaming loads (searches re-read)
+    uint64_t xor_bytes = 0;
+    uint64_t net_block_bytes = 0;
+    uint64_t main_block_bytes = 0;   // Payload of all main blocks walked
+    uint64_t des_bytes = 0;
+    uint64_t json_bytes = 0;
+
+    // Main blocks by type byte; types the parser has no case for are also counted as unknown
+    std::array<uint32_t, 256> block_counts{};
+    uint32_t unknown_blocks = 0;
+    uint32_t truncated_blocks = 0;   // Main blocks whose size ran past the buffer
+
+    // Part block sub-blocks
+    uint32_t skipped_sub_blocks = 0; // Known sub-block types that are not used (0x01, 0x06)
+    uint32_t unknown_sub_blocks = 0;
+    uint32_t malformed_records = 0;  // Arc/line/pin/test pad records too short for their fields
+    uint32_t deferred_parts = 0;     // Part blocks indexed but left encrypted (index-only loads)
+    uint32_t stored_part_boxes = 0;  // Of those, boxes taken from the part index file
+    uint32_t pin_text_groups = 0;    // Groups of pins whose text is read back on demand (lazy text)
+
+    // Output
+    uint32_t nets = 0;
+    uint32_t parts = 0;
+    uint32_t pins = 0;
+    uint32_t outline_segments = 0;
+    uint32_t part_outline_segments = 0;
+    uint32_t pad_shapes = 0;
+    uint32_t pad_stacks = 0;         // Distinct pad geometries behind pad_shapes
+    uint32_t part_aliases = 0;
+    uint32_t diode_readings = 0;
+
+    // Text of the board (part, pin and net names, comments) in the string arena
+    uint32_t strings = 0;
+    uint64_t string_bytes = 0;
+
+    // Peak tracked heap during the load (PCB_ALLOC_TRACKING with the hooks linked), otherwise 0
+    int64_t peak_heap_bytes = 0;
+    // Peak resident set of the process after the load (0 where the platform does not report it)
+    uint64_t peak_resident_bytes = 0;
+
+    void Reset() { *this = LoadReport(); }
+
+    double& Phase(LoadPhase phase) { return phase_ms[static_cast<size_t>(phase)]; }
+    double GetPhaseMs(LoadPhase phase) const { return phase_ms[static_cast<size_t>(phase)]; }
+
+    static const char* GetPhaseName(LoadPhase phase);
+
+    // Single JSON object; `indent` > 0 pretty-prints
+    std::string ToJson(int indent = 2) const;
+
+    // One line for the log
+    std::string Summary() const;
+};
+
+// Adds the lifetime of the scope to a phase of the report
+class LoadPhaseTimer {
+public:
+    LoadPhaseTimer(LoadReport& report, LoadPhase phase)
+        : target(report.Phase(phase)), start(std::chrono::steady_clock::now()) {}
+    ~LoadPhaseTimer() {
+        target += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    LoadPhaseTimer(const LoadPhaseTimer&) = delete;
+    LoadPhaseTimer& operator=(const LoadPhaseTimer&) = delete;
+
+private:
+    double& target;
+    std::chrono::steady_clock::time_point start;
+};
+
+namespace LoadReportUtil {
+    // Peak resident set size of this process in bytes, 0 if unavailable
+    uint64_t QueryPeakResidentBytes();
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ByteCursor.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Compile-time descriptions of binary records. A layout names the member each field is
+// stored in and its byte offset; its decoder checks the extent of the record once and then
+// loads every field with an unaligned little-endian load, with no branch per field. A field
+// that leaves its record or overlaps another one does not compile.
+//
+//     using ArcLayout = RecordLayout::Fixed<24, RecordLayout::Field<&ArcRecord::layer, 0>, ...>;
+//     ArcRecord arc;
+//     if (ArcLayout::Decode(cursor, arc)) ...
+namespace RecordLayout {
+    template <typename Member>
+    struct MemberTraits;
+    template <typename R, typename T>
+    struct MemberTraits<T R::*> {
+        using Record = R;
+        using Type = T;
+    };
+
+    // Integer member `Member`, stored `Offset` bytes into its record
+    template <auto Member, size_t Offset>
+    struct Field {
+        using Record = typename MemberTraits<decltype(Member)>::Record;
+        using Type = typename MemberTraits<decltype(Member)>::Type;
+        static constexpr size_t offset = Offset;
+        static constexpr size_t end = Offset + sizeof(Type);
+
+        static void Load(const ByteCursor& cursor, size_t base, Record& record) {
+            record.*Member = cursor.Peek<Type>(base + Offset);
+        }
+    };
+
+    template <typename... Fields>
+    constexpr bool FieldsDisjoint() {
+        if constexpr (sizeof...(Fields) < 2) {
+            return true;
+        } else {
+            constexpr size_t begins[] = {Fields::offset...};
+            constexpr size_t ends[] = {Fields::end...};
+            for (size_t i = 0; i < sizeof...(Fields); ++i) {
+                for (size_t j = i + 1; j < sizeof...(Fields); ++j) {
+                    if (begins[i] < ends[j] && begins[j] < ends[i]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    // A record of `Size` bytes; bytes no field covers are skipped
+    template <size_t Size, typename... Fields>
+    struct Fixed {
+        static constexpr size_t size = Size;
+        static_assert(((Fields::end <= Size) && ...), "field outside its record");
+        static_assert(FieldsDisjoint<Fields...>(), "fields overlap");
+
+        // Fields of a record at position + base; the caller has checked the extent
+        template <typename Record>
+        static void Load(const ByteCursor& cursor, size_t base, Record& record) {
+            (Fields::Load(cursor, base, record), ...);
+            (void)cursor;
+            (void)base;
+            (void)record;
+        }
+
+        // Record at the position; false when it does not fit
+        template <typename Record>
+        static bool Decode(const ByteCursor& cursor, Record& record) {
+            if (!cursor.Has(Size)) {
+                return false;
+            }
+            Load(cursor, 0, record);
+            return true;
+        }
+        // Decode() and step over the record
+        template <typename Record>
+        static bool Read(ByteCursor& cursor, Record& record) {
+            return Decode(cursor, record) && cursor.Skip(Size);
+        }
+    };
+
+    // A fixed head, a 32-bit byte count, that many bytes (viewed by string_view member
+    // `Bytes`), then a fixed tail whose offsets start after the bytes
+    template <typename Head, auto Bytes, typename Tail>
+    struct Counted {
+        static constexpr size_t count_offset = Head::size;
+        static constexpr size_t bytes_offset = Head::size + 4;
+
+        template <typename Record>
+        static bool Decode(const ByteCursor& cursor, Record& record) {
+            size_t length = 0;
+            return Decode(cursor, record, length);
+        }
+        template <typename Record>
+        static bool Read(ByteCursor& cursor, Record& record) {
+            size_t length = 0;
+            return Decode(cursor, record, length) && cursor.Skip(length);
+        }
+
+    private:
+        template <typename Record>
+        static bool Decode(const ByteCursor& cursor, Record& record, size_t& length) {
+            if (!cursor.Has(bytes_offset)) {
+                return false;
+            }
+            size_t count = cursor.Peek<uint32_t>(count_offset);
+            if (!cursor.Has(count, bytes_offset) || !cursor.Has(Tail::size, bytes_offset + count)) {
+                return false;
+            }
+            Head::Load(cursor, 0, record);
+            record.*Bytes = cursor.PeekBytes(bytes_offset, count);
+            Tail::Load(cursor, bytes_offset + count, record);
+            length = bytes_offset + count + Tail::size;
+            return true;
+        }
+    };
+}
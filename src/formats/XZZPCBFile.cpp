@@ -1,12 +1,19 @@
 #include "XZZPCBFile.h"
+#include "BoardSource.h"
+#include "ByteCursor.h"
+#include "RecordLayout.h"
 #include "des.h"
+#include "AllocTracker.h"
+#include "Trace.h"
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <sstream>
 #include <string>
@@ -20,242 +27,664 @@
  */
 
 static unsigned char hexconv[256] = {0}; // Initialize all to 0
-// Set up the hex conversion lookup table
+// Set up the hex conversion lookup table (once, also when boards are loaded on several threads)
 void init_hexconv() {
-    static bool initialized = false;
-    if (!initialized) {
+    static const bool initialized = [] {
         for (int i = '0'; i <= '9'; i++) hexconv[i] = i - '0';
         for (int i = 'A'; i <= 'F'; i++) hexconv[i] = i - 'A' + 10;
         for (int i = 'a'; i <= 'f'; i++) hexconv[i] = i - 'a' + 10;
-        initialized = true;
+        return true;
+    }();
+    (void)initialized;
+}
+
+// Up to `limit` characters with non-printable bytes shown as [0xNN] (debug output)
+[[maybe_unused]] static std::string FormatPrintable(const std::string& text, size_t limit) {
+    std::ostringstream out;
+    for (size_t i = 0; i < std::min(limit, text.length()); i++) {
+        char c = text[i];
+        if (c >= 32 && c <= 126) {  // Printable ASCII
+            out << c;
+        } else {
+            out << "[0x" << std::hex << static_cast<int>(static_cast<unsigned char>(c)) << std::dec << "]";
+        }
     }
+    return out.str();
 }
 
-std::unique_ptr<XZZPCBFile> XZZPCBFile::LoadFromFile(const std::string& filepath) {
-    std::cout << "LoadFromFile: Opening " << filepath << std::endl;
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << filepath << std::endl;
-        return nullptr;
+// DES key of the part blocks
+static uint64_t GetPartBlockKey() {
+    static const uint64_t key = [] {
+        init_hexconv();
+        std::vector<uint16_t> byteList = {0xE0, 0xCF, 0x2E, 0x9F, 0x3C, 0x33, 0x3C, 0x33};
+
+        std::ostringstream a;
+        for (size_t i = 0; i < byteList.size(); i += 2) {
+            uint16_t value = (byteList[i] << 8) | byteList[i + 1];
+            value ^= 0x3C33; // <3
+            a << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << value;
+        }
+        std::string b = a.str();
+
+        uint64_t k = 0x0000000000000000;
+        const char* kp = b.c_str();
+        for (int i = 0; i < 8; i++) {
+            uint64_t v = hexconv[(int)*kp] * 16 + hexconv[(int)*(kp + 1)];
+            k |= (v << ((7 - i) * 8));
+            kp += 2;
+        }
+        return k;
+    }();
+    return key;
+}
+
+// Decrypts one 8-byte block (the file stores them big-endian); `out` may be `in`
+static void DecryptPartBlock(const uint8_t* in, uint8_t* out, uint64_t key) {
+    uint64_t e64 = 0;
+    for (int i = 0; i < 8; i++) {
+        e64 = (e64 << 8) | in[i];
+    }
+    uint64_t d64 = des(e64, key, 'd');
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<uint8_t>(d64 >> ((7 - i) * 8));
     }
+}
 
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+// Typed records of the XZZ blocks and their layouts. Offsets are from the start of the
+// record; the fields of a Counted tail are from the end of its name.
+namespace {
+    using RecordLayout::Field;
+    using RecordLayout::Fixed;
+    using RecordLayout::Counted;
+
+    // Main 0x01 block: an outline arc (the scale field after it is always 10000)
+    struct ArcRecord {
+        uint32_t layer = 0;
+        uint32_t x = 0;
+        uint32_t y = 0;
+        int32_t radius = 0;
+        int32_t angle_start = 0;
+        int32_t angle_end = 0;
+    };
+    using ArcLayout = Fixed<24,
+        Field<&ArcRecord::layer, 0>,
+        Field<&ArcRecord::x, 4>,
+        Field<&ArcRecord::y, 8>,
+        Field<&ArcRecord::radius, 12>,
+        Field<&ArcRecord::angle_start, 16>,
+        Field<&ArcRecord::angle_end, 20>>;
+
+    // Main 0x05 block and the 0x05 sub blocks of parts: a segment (scale and net index follow)
+    struct LineRecord {
+        int32_t layer = 0;
+        int32_t x1 = 0;
+        int32_t y1 = 0;
+        int32_t x2 = 0;
+        int32_t y2 = 0;
+
+        BRDPoint GetStart() const { return ToPoint(x1, y1); }
+        BRDPoint GetEnd() const { return ToPoint(x2, y2); }
+
+        static BRDPoint ToPoint(int32_t x, int32_t y) {
+            return {static_cast<int>(static_cast<double>(x) / 10000.0), static_cast<int>(static_cast<double>(y) / 10000.0)};
+        }
+    };
+    using LineLayout = Fixed<20,
+        Field<&LineRecord::layer, 0>,
+        Field<&LineRecord::x1, 4>,
+        Field<&LineRecord::y1, 8>,
+        Field<&LineRecord::x2, 12>,
+        Field<&LineRecord::y2, 16>>;
+
+    // Head of a 0x07 block: <size> 18 unknown bytes <group name>
+    struct PartHeaderRecord {
+        uint32_t size = 0;
+        std::string_view group_name;
+    };
+    using PartHeaderLayout = Counted<
+        Fixed<22, Field<&PartHeaderRecord::size, 0>>,
+        &PartHeaderRecord::group_name,
+        Fixed<0>>;
+
+    // 0x06 sub block of a part holding its name: <0x06> 30 unknown bytes <name>
+    struct PartNameRecord {
+        uint8_t type = 0;
+        std::string_view name;
+    };
+    using PartNameLayout = Counted<
+        Fixed<31, Field<&PartNameRecord::type, 0>>,
+        &PartNameRecord::name,
+        Fixed<0>>;
+
+    // 0x09 sub block of a part: <size> <?> <x> <y> <?> <rotation> <name>, then from the end of
+    // the name <height or radius> <width> 18 bytes <shape> 5 bytes <net index>
+    struct PinRecord {
+        uint32_t size = 0;          // Of the record after this field
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t rotation = 0;
+        std::string_view name;
+        uint32_t height_radius = 0;
+        uint32_t width = 0;
+        uint8_t shape = 0;
+        uint32_t net_index = 0;
+    };
+    // Fields the lazy walks read on their own
+    using PinX = Field<&PinRecord::x, 8>;
+    using PinY = Field<&PinRecord::y, 12>;
+    using PinNetIndex = Field<&PinRecord::net_index, 32>;
+    using PinLayout = Counted<
+        Fixed<24, Field<&PinRecord::size, 0>, PinX, PinY, Field<&PinRecord::rotation, 20>>,
+        &PinRecord::name,
+        Fixed<36, Field<&PinRecord::height_radius, 0>, Field<&PinRecord::width, 4>, Field<&PinRecord::shape, 26>, PinNetIndex>>;
+
+    // Main 0x09 block: <pad number> <x> <y> <inner diameter> <rotation> <name> <width> <height>
+    // <shape> ..., with the net index 12 bytes before the end of the block
+    struct TestPadRecord {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t rotation = 0;
+        std::string_view name;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint8_t shape = 0;
+        uint32_t net_index = 0;
+    };
+    using TestPadLayout = Counted<
+        Fixed<20, Field<&TestPadRecord::x, 4>, Field<&TestPadRecord::y, 8>, Field<&TestPadRecord::rotation, 16>>,
+        &TestPadRecord::name,
+        Fixed<9, Field<&TestPadRecord::width, 0>, Field<&TestPadRecord::height, 4>, Field<&TestPadRecord::shape, 8>>>;
+    const size_t kTestPadNetFromEnd = 12;
+    static_assert(kTestPadNetFromEnd <= TestPadLayout::bytes_offset, "net index inside every test pad block");
+
+    bool DecodeTestPad(const ByteCursor& cursor, TestPadRecord& pad) {
+        if (!TestPadLayout::Decode(cursor, pad)) return false;
+        pad.net_index = cursor.Peek<uint32_t>(cursor.GetRemaining() - kTestPadNetFromEnd);
+        return true;
+    }
+}
 
-    std::vector<char> buffer(fileSize);
-    file.read(buffer.data(), fileSize);
-    file.close();
+namespace {
+    // Reads an encrypted part block in place in its source, fetching and decrypting each 8-byte
+    // block on first access (DES is used in ECB mode, so blocks decrypt independently). Like
+    // des_decrypt, a partial last block is zero-padded, so the plain text is a whole number of
+    // blocks.
+    class LazyDesReader {
+    public:
+        LazyDesReader(BoardSource& source, uint64_t offset, size_t size)
+            : source(source), offset(offset), source_size(size), length((size + 7) / 8 * 8),
+              plain(length, 0), ready(length / 8, 0), key(GetPartBlockKey()) {}
+
+        size_t size() const { return length; }
+        uint64_t GetDecryptedBytes() const { return decrypted_blocks * 8; }
+
+        bool Read(size_t pos, void* out, size_t count) {
+            if (pos > length || count > length - pos) {
+                return false;
+            }
+            for (size_t block = pos / 8; block * 8 < pos + count; ++block) {
+                if (!Decrypt(block)) {
+                    return false;
+                }
+            }
+            std::memcpy(out, plain.data() + pos, count);
+            return true;
+        }
+
+        bool ReadU32(size_t pos, uint32_t& value) { return Read(pos, &value, 4); }
+        bool ReadU8(size_t pos, uint8_t& value) { return Read(pos, &value, 1); }
+
+    private:
+        bool Decrypt(size_t block) {
+            if (ready[block]) {
+                return true;
+            }
+            uint8_t in[8] = {0};
+            size_t begin = block * 8;
+            if (!source.Read(offset + begin, in, std::min<size_t>(8, source_size - begin))) {
+                return false;
+            }
+            DecryptPartBlock(in, plain.data() + begin, key);
+            ready[block] = 1;
+            decrypted_blocks++;
+            return true;
+        }
+
+        BoardSource& source;
+        uint64_t offset;
+        size_t source_size;
+        size_t length;
+        std::vector<uint8_t> plain;
+        std::vector<uint8_t> ready;
+        uint64_t key;
+        uint64_t decrypted_blocks = 0;
+    };
+
+    // The walk of ParsePartBlockOriginal over an encrypted part block, decrypting only what is
+    // read: `part_name` (unless null) receives the name, then sub_block(type, record) is called
+    // for each outline (0x05) and pin (0x09) sub block with the offset of its size field, until
+    // it returns false or the block ends. False without a name sub block.
+    template <typename SubBlockFn>
+    bool WalkPartBlock(LazyDesReader& reader, std::string* part_name, SubBlockFn&& sub_block) {
+        uint32_t part_size = 0;
+        uint32_t part_group_name_size = 0;
+        if (!reader.ReadU32(0, part_size) || !reader.ReadU32(PartHeaderLayout::count_offset, part_group_name_size)) return false;
+        size_t current_pointer = PartHeaderLayout::bytes_offset + static_cast<size_t>(part_group_name_size);
+
+        uint8_t sub_type_identifier = 0;
+        if (!reader.ReadU8(current_pointer, sub_type_identifier) || sub_type_identifier != 0x06) return false;
+        uint32_t part_name_size = 0;
+        if (!reader.ReadU32(current_pointer + PartNameLayout::count_offset, part_name_size)) return false;
+        current_pointer += PartNameLayout::bytes_offset;
+        if (part_name) {
+            part_name->assign(part_name_size <= reader.size() ? part_name_size : 0, '\0');
+            if (part_name->size() != part_name_size || !reader.Read(current_pointer, &(*part_name)[0], part_name_size)) return false;
+        }
+        current_pointer += part_name_size;
+
+        while (current_pointer <= part_size && current_pointer < reader.size()) {
+            reader.ReadU8(current_pointer, sub_type_identifier);
+            current_pointer += 1;
 
-    std::cout << "LoadFromFile: Creating XZZPCBFile object" << std::endl;
+            uint32_t sub_block_size = 0;
+            switch (sub_type_identifier) {
+                case 0x01:
+                case 0x06:
+                    if (!reader.ReadU32(current_pointer, sub_block_size)) return true;
+                    current_pointer += static_cast<size_t>(sub_block_size) + 4;
+                    break;
+                case 0x05:
+                case 0x09:
+                    if (!reader.ReadU32(current_pointer, sub_block_size) || !sub_block(sub_type_identifier, current_pointer)) return true;
+                    current_pointer += static_cast<size_t>(sub_block_size) + 4;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return true;
+    }
+}
+
+// Window of the file as read back after the load (lazy text, deferred part blocks): part
+// blocks are small
+static const size_t kReadBackWindowBytes = 64 * 1024;
+
+XZZPCBFile::XZZPCBFile() = default;
+XZZPCBFile::~XZZPCBFile() = default;
+
+std::unique_ptr<XZZPCBFile> XZZPCBFile::LoadFromFile(const std::string& filepath, LoadReport* report) {
+    return LoadFromFile(filepath, report, LoadOptions());
+}
+
+std::unique_ptr<XZZPCBFile> XZZPCBFile::LoadFromFile(const std::string& filepath, LoadReport* report,
+                                                     const LoadOptions& options) {
+    LOG_DEBUG("LoadFromFile: Opening " << filepath);
+    PCB_TRACE_SCOPE("XZZPCBFile::LoadFromFile");
     auto pcbFile = std::make_unique<XZZPCBFile>();
-    std::cout << "LoadFromFile: Calling Load() method" << std::endl;
-    if (pcbFile->Load(buffer, filepath)) {
-        std::cout << "LoadFromFile: Load() succeeded, returning pcbFile" << std::endl;
+    pcbFile->SetLoadOptions(options);
+    bool loaded = pcbFile->LoadFile(filepath);
+    if (report) {
+        *report = pcbFile->load_report;
+    }
+
+    if (loaded) {
         return pcbFile;
     }
-    std::cout << "LoadFromFile: Load() failed, returning nullptr" << std::endl;
+    LOG_DEBUG("LoadFromFile: load failed for " << filepath);
     return nullptr;
 }
 
-bool XZZPCBFile::Load(const std::vector<char>& buffer, const std::string& filepath) {
-    init_hexconv(); // Initialize hex conversion table
-    
-    if (!VerifyFormat(buffer)) {
-        std::cerr << "Error: Invalid XZZPCB format" << std::endl;
+bool XZZPCBFile::LoadFile(const std::string& filepath) {
+    FileBoardSource source;
+    if (!source.Open(filepath)) {
+        LOG_ERROR("Cannot open file " << filepath);
+        load_report.Reset();
+        load_report.file_path = filepath;
+        load_report.error = error_msg = "Cannot open file";
         return false;
     }
+    source_path = filepath;
+    return LoadSource(source, filepath);
+}
 
-    std::cout << "Loading XZZPCB file: " << filepath << " (size: " << buffer.size() << ")" << std::endl;
+bool XZZPCBFile::Load(const std::vector<char>& buffer, const std::string& filepath) {
+    MemoryBoardSource source(buffer);
+    source_path.clear();
+    return LoadSource(source, filepath);
+}
 
-    // Create a mutable copy for parsing
-    std::vector<char> buf(buffer);
-    
-    return ParseXZZPCBOriginal(buf);
+bool XZZPCBFile::LoadSource(BoardSource& source, const std::string& filepath) {
+    PCB_ALLOC_SCOPE(Parse);
+    PCB_TRACE_SCOPE("XZZPCBFile::Load");
+    init_hexconv(); // Initialize hex conversion table
+
+    load_report.Reset();
+    load_report.file_path = filepath;
+    load_report.file_bytes = source.GetSize();
+    deferred_parts.clear();
+    stored_parts.clear();
+    deferred_part_data.clear();
+    pending_part_count = 0;
+    // Lazy text needs the file to read it back from
+    lazy_text = load_options.lazy_text && !source_path.empty();
+    pin_text_sources.clear();
+    file_source.reset();
+    source_size = source.GetSize();
+    source_xor_key = 0;
+    source_xor_end = 0;
+    ClearTextCache();
+    AllocTracker::ResetPeak();
+    auto load_start = std::chrono::steady_clock::now();
+
+    bool parsed = false;
+    if (!VerifySource(source)) {
+        LOG_ERROR("Invalid XZZPCB format");
+        error_msg = "Invalid XZZPCB format";
+    } else {
+        LOG_INFO("Loading XZZPCB file: " << filepath << " (size: " << source.GetSize() << ")");
+        parsed = ParseBoard(source);
+    }
+
+    load_report.total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count();
+    load_report.Phase(LoadPhase::Read) = source.GetFetchMs();
+    load_report.read_bytes = source.GetBytesFetched();
+    load_report.success = parsed;
+    load_report.error = parsed ? "" : error_msg;
+    load_report.nets = static_cast<uint32_t>(net_dict.size());
+    load_report.parts = static_cast<uint32_t>(parts.size());
+    load_report.pins = static_cast<uint32_t>(pins.size());
+    load_report.outline_segments = static_cast<uint32_t>(outline_segments.size());
+    load_report.part_outline_segments = static_cast<uint32_t>(part_outline_segments.size());
+    load_report.pad_shapes = static_cast<uint32_t>(circles.size() + rectangles.size() + ovals.size());
+    load_report.pad_stacks = static_cast<uint32_t>(pad_stacks.size());
+    load_report.deferred_parts = static_cast<uint32_t>(deferred_parts.size());
+    load_report.pin_text_groups = static_cast<uint32_t>(pin_text_sources.size());
+    load_report.part_aliases = static_cast<uint32_t>(part_alias_dict.size());
+    load_report.diode_readings = static_cast<uint32_t>(json_diode_dict.size() + diode_dict.size());
+    load_report.strings = static_cast<uint32_t>(strings.GetStringCount());
+    load_report.string_bytes = strings.GetByteCount();
+    load_report.peak_heap_bytes = AllocTracker::GetPeakLiveBytes();
+    load_report.peak_resident_bytes = LoadReportUtil::QueryPeakResidentBytes();
+    LOG_INFO("XZZPCB " + load_report.Summary());
+
+    return parsed;
 }
 
 bool XZZPCBFile::VerifyFormat(const std::vector<char>& buffer) {
-    if (buffer.size() < 6) return false;
-    
-    bool raw = std::string(buffer.begin(), buffer.begin() + 6) == "XZZPCB";
+    MemoryBoardSource source(buffer);
+    return VerifySource(source);
+}
+
+bool XZZPCBFile::VerifySource(BoardSource& source) {
+    char header[0x11];
+    if (!source.Read(0, header, 6)) return false;
+
+    bool raw = std::string(header, 6) == "XZZPCB";
     if (raw) {
         return true;
     }
 
-    if (buffer.size() > 0x10 && buffer[0x10] != 0x00) {
-        uint8_t xor_key = buffer[0x10];
-        std::vector<char> xor_buf(buffer.begin(), buffer.begin() + 6);
+    if (source.GetSize() > 0x10 && source.Read(0x10, &header[0x10], 1) && header[0x10] != 0x00) {
+        uint8_t xor_key = header[0x10];
         for (int i = 0; i < 6; ++i) {
-            xor_buf[i] ^= xor_key;
+            header[i] ^= xor_key;
         }
-        return std::string(xor_buf.begin(), xor_buf.end()) == "XZZPCB";
+        return std::string(header, 6) == "XZZPCB";
     }
 
     return false;
 }
 
 bool XZZPCBFile::ParseXZZPCBOriginal(std::vector<char>& buf) {
-    auto v6v6555v6v6 = std::vector<uint8_t>{0x76, 0x36, 0x76, 0x36, 0x35, 0x35, 0x35, 0x76, 0x36, 0x76, 0x36};
-    auto v6v6555v6v6_found = std::search(buf.begin(), buf.end(), v6v6555v6v6.begin(), v6v6555v6v6.end());
-
-    if (v6v6555v6v6_found != buf.end()) {
-        if (buf[0x10] != 0x00) {
-            uint8_t xor_key = buf[0x10];
-            for (int i = 0; i < v6v6555v6v6_found - buf.begin(); ++i) {
-                buf[i] ^= xor_key; // XOR the buffer with xor_key until v6v6555v6v6 is reached
-            }
-        }
-        ParsePostV6(v6v6555v6v6_found, buf);
-    } else {
-        if (buf[0x10] != 0) {
-            uint8_t xor_key = buf[0x10];
-            for (int i = 0; i < buf.end() - buf.begin(); ++i) {
-                buf[i] ^= xor_key; // XOR the buffer with xor_key until the end of the buffer as no v6v6555v6v6
-            }
-        }
-        
-        // Also try to find JSON data in the entire buffer since there's no PostV6 section
-        std::vector<uint8_t> json_pattern = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, 0xB8, 0xBD, 0xBC, 0xD3, 0x0A};
-        auto json_pattern_found = std::search(buf.begin(), buf.end(), json_pattern.begin(), json_pattern.end());
-        
-        if (json_pattern_found != buf.end()) {
-            std::cout << "Found JSON pattern in main buffer at position: " << (json_pattern_found - buf.begin()) << std::endl;
-            ParseJsonData(json_pattern_found + json_pattern.size(), buf);
-        } else {
-            // Try to search for JSON-like data by looking for key strings
-            std::string buffer_str(buf.begin(), buf.end());
-            size_t part_pos = buffer_str.find("\"part\":[");
-            
-            if (part_pos != std::string::npos) {
-                std::cout << "Found 'part' array in main buffer at position: " << part_pos << std::endl;
-                // Find the start of the JSON object by looking backwards for '{'
-                size_t json_start = buffer_str.rfind('{', part_pos);
-                if (json_start != std::string::npos) {
-                    std::cout << "Found JSON start in main buffer at position: " << json_start << std::endl;
-                    ParseJsonData(buf.begin() + json_start, buf);
-                }
-            }
-        }
+    MemoryBoardSource source(buf);
+    return ParseBoard(source);
+}
+
+bool XZZPCBFile::ParseBoard(BoardSource& source) {
+    static const char v6v6555v6v6[] = {0x76, 0x36, 0x76, 0x36, 0x35, 0x35, 0x35, 0x76, 0x36, 0x76, 0x36};
+    uint64_t file_size = source.GetSize();
+
+    // Everything before the post-v6 marker (the whole file without one) is XORed with the byte
+    // at 0x10; the source undoes it on every read. The marker lies past the header, so the
+    // header reads the same whatever its position turns out to be.
+    uint8_t xor_key = 0;
+    if (source.Read(0x10, &xor_key, 1) && xor_key != 0) {
+        source.SetXor(xor_key, file_size);
     }
 
-    if (buf.size() < 0x30) {
-        std::cerr << "Error: Buffer too small for XZZPCB format" << std::endl;
+    // Header offsets are 32-bit; positions are 64-bit so nothing past 4 GB wraps
+    uint32_t main_data_offset = 0;
+    uint32_t net_data_offset = 0;
+    if (file_size < 0x30 || !source.ReadU32(0x20, main_data_offset) || !source.ReadU32(0x28, net_data_offset)) {
+        LOG_ERROR("Buffer too small for XZZPCB format");
+        error_msg = "Buffer too small for XZZPCB format";
         return false;
     }
 
-    uint32_t main_data_offset = *reinterpret_cast<uint32_t*>(&buf[0x20]);
-    uint32_t net_data_offset = *reinterpret_cast<uint32_t*>(&buf[0x28]);
-
-    uint32_t main_data_start = main_data_offset + 0x20;
-    uint32_t net_data_start = net_data_offset + 0x20;
+    uint64_t main_data_start = static_cast<uint64_t>(main_data_offset) + 0x20;
+    uint64_t net_data_start = static_cast<uint64_t>(net_data_offset) + 0x20;
 
-    if (main_data_start >= buf.size() || net_data_start >= buf.size()) {
-        std::cerr << "Error: Invalid offsets in XZZPCB file" << std::endl;
+    uint32_t main_data_blocks_size = 0;
+    uint32_t net_block_size = 0;
+    if (!source.ReadU32(main_data_start, main_data_blocks_size) || !source.ReadU32(net_data_start, net_block_size)) {
+        LOG_ERROR("Invalid offsets in XZZPCB file");
+        error_msg = "Invalid offsets in XZZPCB file";
         return false;
     }
 
-    uint32_t main_data_blocks_size = *reinterpret_cast<uint32_t*>(&buf[main_data_start]);
-    uint32_t net_block_size = *reinterpret_cast<uint32_t*>(&buf[net_data_start]);
-
-    if (net_data_start + net_block_size + 4 > buf.size()) {
-        std::cerr << "Error: Net block extends beyond buffer" << std::endl;
+    if (net_data_start + net_block_size + 4 > file_size) {
+        LOG_ERROR("Net block extends beyond buffer");
+        error_msg = "Net block extends beyond buffer";
         return false;
     }
 
-    std::vector<char> net_block_buf(buf.begin() + net_data_start + 4, buf.begin() + net_data_start + net_block_size + 4);
-    ParseNetBlockOriginal(net_block_buf);
+    // The JSON data and the post-v6 section follow the main and net data, so only that tail
+    // is searched instead of the whole file
+    uint64_t main_data_end = main_data_start + 4 + main_data_blocks_size;
+    uint64_t trailer_start = std::min(std::max(main_data_end, net_data_start + 4 + net_block_size), file_size);
+    uint64_t v6v6555v6v6_found;
+    {
+        PCB_TRACE_SCOPE("marker search");
+        LoadPhaseTimer phase_timer(load_report, LoadPhase::MarkerSearch);
+        // The marker itself is not XORed
+        source.SetXor(xor_key, trailer_start);
+        v6v6555v6v6_found = source.Find(v6v6555v6v6, sizeof(v6v6555v6v6), trailer_start);
+    }
+    if (xor_key != 0) {
+        load_report.xor_bytes = v6v6555v6v6_found != BoardSource::kNotFound ? v6v6555v6v6_found : file_size;
+        source_xor_key = xor_key;
+        source_xor_end = load_report.xor_bytes;
+    }
+    source.SetXor(xor_key, load_report.xor_bytes);
 
-    uint32_t current_pointer = main_data_start + 4;
-    while (current_pointer < main_data_start + 4 + main_data_blocks_size) {
-        if (current_pointer >= buf.size()) break;
-        
-        uint8_t block_type = buf[current_pointer];
-        current_pointer += 1;
-        
-        if (current_pointer + 4 > buf.size()) break;
-        uint32_t block_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-        current_pointer += 4;
-        
-        if (current_pointer + block_size > buf.size()) break;
-        std::vector<char> block_buf(buf.begin() + current_pointer, buf.begin() + current_pointer + block_size);
-        ProcessBlockOriginal(block_type, block_buf);
-        current_pointer += block_size;
+    ParseTrailer(source, trailer_start, v6v6555v6v6_found);
+
+    {
+        PCB_TRACE_SCOPE("net block");
+        LoadPhaseTimer phase_timer(load_report, LoadPhase::NetBlock);
+        load_report.net_block_bytes = net_block_size;
+        ParseNetBlock(source, net_data_start + 4, net_block_size);
     }
-    
-    FindXYTranslation();
-    TranslateSegments();
-    TranslatePartOutlineSegments();
-    TranslatePins();
-    TranslateCircles();
-    TranslateRectangles();
-    TranslateOvals();
 
-    // Update counts
-    num_parts = parts.size();
-    num_pins = pins.size();
-      std::cout << "XZZPCB parsing completed:" << std::endl;
-    std::cout << "  Parts: " << num_parts << std::endl;
-    std::cout << "  Pins: " << num_pins << std::endl;
-    std::cout << "  Outline segments: " << outline_segments.size() << std::endl;
-    std::cout << "  Part outline segments: " << part_outline_segments.size() << std::endl;
-    std::cout << "  Circles: " << circles.size() << std::endl;
-    std::cout << "  Rectangles: " << rectangles.size() << std::endl;
-    std::cout << "  Ovals: " << ovals.size() << std::endl;
-    std::cout << "  Part aliases found: " << part_alias_dict.size() << std::endl;
-    std::cout << "  JSON diode readings found: " << json_diode_dict.size() << std::endl;
-    
-    // Debug: Print first few pin coordinates
-    if (!pins.empty()) {
-        std::cout << "First few pin coordinates:" << std::endl;
-        for (size_t i = 0; i < std::min((size_t)5, pins.size()); i++) {
-            std::cout << "  Pin " << i << ": (" << pins[i].pos.x << ", " << pins[i].pos.y << ") " << pins[i].name;
-            if (!pins[i].comment.empty()) {
-                std::cout << " [diode: " << pins[i].comment << "]";
+    bool part_index_file = load_options.mode == LoadMode::IndexOnly && load_options.part_index_file && !source_path.empty();
+    if (part_index_file) {
+        ReadPartIndexFile();
+    }
+
+    {
+        PCB_TRACE_SCOPE("main blocks");
+        // One block in memory at a time, reused from block to block
+        std::vector<char> block_buf;
+        uint64_t current_pointer = main_data_start + 4;
+        while (current_pointer < main_data_end) {
+            char block_header[5];
+            if (!source.Read(current_pointer, block_header, 1)) break;
+            uint8_t block_type = static_cast<uint8_t>(block_header[0]);
+            current_pointer += 1;
+
+            uint32_t block_size = 0;
+            if (!source.ReadU32(current_pointer, block_size)) break;
+            current_pointer += 4;
+
+            if (current_pointer + block_size > file_size) {
+                load_report.truncated_blocks++;
+                break;
+            }
+            if (block_size > load_options.stream_memory_cap) {
+                LOG_ERROR("Block of " << block_size << " bytes at " << current_pointer << " exceeds the memory cap");
+                error_msg = "Block exceeds the memory cap";
+                return false;
             }
-            std::cout << std::endl;
+            load_report.block_counts[block_type]++;
+            load_report.main_block_bytes += block_size;
+            current_block_offset = current_pointer;
+            if (block_type == 0x07 && load_options.mode == LoadMode::IndexOnly) {
+                // Read in place: only the few 8-byte blocks the index needs are fetched
+                if (!IndexPartBlock(source, current_pointer, block_size)) {
+                    LOG_ERROR("Read failed at " << current_pointer);
+                    error_msg = "Read failed";
+                    return false;
+                }
+                current_pointer += block_size;
+                continue;
+            }
+            block_buf.clear();
+            if (!source.ReadInto(current_pointer, block_size, block_buf)) {
+                LOG_ERROR("Read failed at " << current_pointer);
+                error_msg = "Read failed";
+                return false;
+            }
+            ProcessBlockOriginal(block_type, block_buf);
+            current_pointer += block_size;
         }
     }
-    
-    // Debug: Print some part aliases if they exist
-    if (!part_alias_dict.empty()) {
-        std::cout << "First few part aliases:" << std::endl;
-        int count = 0;
-        for (const auto& alias : part_alias_dict) {
-            if (count >= 3) break;
-            std::cout << "  " << alias.first << " -> " << alias.second << std::endl;
-            count++;
-        }
+
+    // Boxes are stored as read, before the translation
+    if (part_index_file && (load_report.stored_part_boxes != deferred_parts.size() || stored_parts.size() != deferred_parts.size())) {
+        WritePartIndexFile();
     }
-      // Debug: Print first few outline segments
-    if (!outline_segments.empty()) {
-        std::cout << "First few outline segments:" << std::endl;
-        for (size_t i = 0; i < std::min((size_t)3, outline_segments.size()); i++) {
-            std::cout << "  Segment " << i << ": (" << outline_segments[i].first.x << ", " << outline_segments[i].first.y << ") to (" 
-                     << outline_segments[i].second.x << ", " << outline_segments[i].second.y << ")" << std::endl;
+    std::vector<DeferredPart>().swap(stored_parts);
+
+    {
+        PCB_TRACE_SCOPE("translate");
+        LoadPhaseTimer phase_timer(load_report, LoadPhase::Translate);
+        FindXYTranslation();
+        TranslateSegments();
+        TranslatePartOutlineSegments();
+        TranslatePins();
+        TranslateCircles();
+        TranslateRectangles();
+        TranslateOvals();
+        for (DeferredPart& part : deferred_parts) {
+            TranslatePoints(part.min);
+            TranslatePoints(part.max);
         }
     }
 
-    // Debug: Print first few part outline segments
-    if (!part_outline_segments.empty()) {
-        std::cout << "First few part outline segments:" << std::endl;
-        for (size_t i = 0; i < std::min((size_t)3, part_outline_segments.size()); i++) {
-            std::cout << "  Part segment " << i << ": (" << part_outline_segments[i].first.x << ", " << part_outline_segments[i].first.y << ") to (" 
-                     << part_outline_segments[i].second.x << ", " << part_outline_segments[i].second.y << ")" << std::endl;
-        }
+    {
+        PCB_TRACE_SCOPE("spatial_sort");
+        LoadPhaseTimer phase_timer(load_report, LoadPhase::SpatialSort);
+        SortPadsSpatially();
     }
 
+    // Update counts
+    num_parts = parts.size();
+    num_pins = pins.size();
+
     // Set valid flag to indicate successful parsing
     valid = true;
-    std::cout << "XZZPCB file parsed successfully - setting valid flag to true" << std::endl;
 
     return true;
 }
 
+void XZZPCBFile::ParseTrailer(BoardSource& source, uint64_t trailer_start, uint64_t v6_pos) {
+    PCB_TRACE_SCOPE("trailer");
+    uint64_t file_size = source.GetSize();
+
+    // JSON data (aliases, diode readings) follows the marker 3D 3D 3D 50 43 42 B8 BD BC D3 0A;
+    // without it, the object holding a "part" array is used
+    static const char json_pattern[] = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, static_cast<char>(0xB8),
+                                        static_cast<char>(0xBD), static_cast<char>(0xBC), static_cast<char>(0xD3), 0x0A};
+    static const char part_key[] = "\"part\":[";
+    uint64_t json_start = BoardSource::kNotFound;
+    {
+        LoadPhaseTimer phase_timer(load_report, LoadPhase::MarkerSearch);
+        std::vector<uint64_t> found = source.FindEach({std::string_view(json_pattern, sizeof(json_pattern)),
+                                                       std::string_view(part_key, sizeof(part_key) - 1)},
+                                                      trailer_start);
+        uint64_t json_pattern_found = found[0];
+        uint64_t part_pos = found[1];
+        if (json_pattern_found != BoardSource::kNotFound) {
+            LOG_DEBUG("Found JSON pattern at position: " << json_pattern_found);
+            json_start = source.Find("{", 1, json_pattern_found + sizeof(json_pattern));
+        } else if (part_pos != BoardSource::kNotFound) {
+            LOG_DEBUG("Found 'part' array at position: " << part_pos);
+            json_start = source.FindLast('{', part_pos);
+        } else {
+            LOG_DEBUG("No JSON-like data found");
+        }
+    }
+    if (json_start != BoardSource::kNotFound) {
+        ParseJsonObject(source, json_start);
+    }
+
+    if (v6_pos != BoardSource::kNotFound) {
+        // Diode readings run from the marker to the end of the file
+        uint64_t tail_size = file_size - v6_pos;
+        std::vector<char> tail;
+        if (tail_size > load_options.stream_memory_cap) {
+            LOG_WARNING("Post-v6 section of " << tail_size << " bytes exceeds the memory cap; diode readings skipped");
+        } else if (source.ReadInto(v6_pos, static_cast<size_t>(tail_size), tail)) {
+            ParsePostV6(tail);
+        }
+    }
+}
+
+void XZZPCBFile::ParseJsonObject(BoardSource& source, uint64_t json_start) {
+    // Find the end of the object by counting braces, then parse only the object
+    std::vector<char> chunk(64 * 1024);
+    uint64_t file_size = source.GetSize();
+    uint64_t json_end = BoardSource::kNotFound;
+    int brace_count = 0;
+    for (uint64_t pos = json_start; pos < file_size && json_end == BoardSource::kNotFound; pos += chunk.size()) {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(chunk.size(), file_size - pos));
+        if (!source.Read(pos, chunk.data(), count)) {
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (chunk[i] == '{') {
+                brace_count++;
+            } else if (chunk[i] == '}' && --brace_count == 0) {
+                json_end = pos + i + 1;
+                break;
+            }
+        }
+    }
+    if (json_end == BoardSource::kNotFound) {
+        LOG_WARNING("Incomplete JSON object found");
+        return;
+    }
+    if (json_end - json_start > load_options.stream_memory_cap) {
+        LOG_WARNING("JSON data of " << (json_end - json_start) << " bytes exceeds the memory cap; skipped");
+        return;
+    }
+
+    std::vector<char> json_buf;
+    if (source.ReadInto(json_start, static_cast<size_t>(json_end - json_start), json_buf)) {
+        DumpHexAroundPosition(json_buf, 0, 30);
+        ParseJsonData(json_buf.begin(), json_buf);
+    }
+}
+
 void XZZPCBFile::ProcessBlockOriginal(uint8_t block_type, std::vector<char>& block_buf) {
+    // Records are decoded in place; a part block is decrypted in place
+    ByteCursor cursor(block_buf.data(), block_buf.size());
     switch (block_type) {
         case 0x01: { // ARC
-            std::vector<uint32_t> arc_data((uint32_t*)(block_buf.data()), (uint32_t*)(block_buf.data() + block_buf.size()));
-            ParseArcBlockOriginal(arc_data);
+            PCB_TRACE_SCOPE("arc block");
+            LoadPhaseTimer phase_timer(load_report, LoadPhase::ArcBlocks);
+            ParseArcBlockOriginal(cursor);
             break;
         }
         case 0x02: { // VIA
@@ -263,9 +692,9 @@ void XZZPCBFile::ProcessBlockOriginal(uint8_t block_type, std::vector<char>& blo
             break;
         }
         case 0x05: { // LINE SEGMENT
-            std::vector<uint32_t> line_segment_data((uint32_t*)(block_buf.data()),
-                                                   (uint32_t*)(block_buf.data() + block_buf.size()));
-            ParseLineSegmentBlockOriginal(line_segment_data);
+            PCB_TRACE_SCOPE("line block");
+            LoadPhaseTimer phase_timer(load_report, LoadPhase::LineBlocks);
+            ParseLineSegmentBlockOriginal(cursor);
             break;
         }
         case 0x06: { // TEXT
@@ -273,73 +702,483 @@ void XZZPCBFile::ProcessBlockOriginal(uint8_t block_type, std::vector<char>& blo
             break;
         }
         case 0x07: { // PART/PIN
-            std::vector<char> part_data(block_buf.begin(), block_buf.end());
-            ParsePartBlockOriginal(part_data);
+            PCB_TRACE_SCOPE("part block");
+            LoadPhaseTimer phase_timer(load_report, LoadPhase::PartBlocks);
+            size_t first_pin = pins.size();
+            uint32_t block_size = static_cast<uint32_t>(block_buf.size());
+            ParsePartBlockOriginal(block_buf);
+            AddPinTextSource(block_type, first_pin, block_size);
             break;
         }
         case 0x09: { // TEST PADS/DRILL HOLES
-            std::vector<uint8_t> test_pad_data((uint8_t*)(block_buf.data()), (uint8_t*)(block_buf.data() + block_buf.size()));
-            ParseTestPadBlockOriginal(test_pad_data);
+            PCB_TRACE_SCOPE("test pad block");
+            LoadPhaseTimer phase_timer(load_report, LoadPhase::TestPadBlocks);
+            size_t first_pin = pins.size();
+            ParseTestPadBlockOriginal(cursor);
+            AddPinTextSource(block_type, first_pin, static_cast<uint32_t>(block_buf.size()));
             break;
         }
         default:
+            load_report.unknown_blocks++;
             break;
     }
 }
 
 void XZZPCBFile::des_decrypt(std::vector<char>& buf) {
-    std::vector<uint16_t> byteList = {0xE0, 0xCF, 0x2E, 0x9F, 0x3C, 0x33, 0x3C, 0x33};
+    PCB_ALLOC_SCOPE(DES);
+    PCB_TRACE_SCOPE("des");
+    LoadPhaseTimer phase_timer(load_report, LoadPhase::DES);
+    load_report.des_bytes += buf.size();
+    uint64_t k = GetPartBlockKey();
+
+    // Whole 8-byte blocks, decrypted in place; a partial last block is zero-padded
+    buf.resize((buf.size() + 7) / 8 * 8, 0);
+    for (size_t pos = 0; pos < buf.size(); pos += 8) {
+        uint8_t* block = reinterpret_cast<uint8_t*>(buf.data() + pos);
+        DecryptPartBlock(block, block, k);
+    }
+}
+
+bool XZZPCBFile::IndexPartBlock(BoardSource& source, uint64_t offset, uint32_t size) {
+    PCB_TRACE_SCOPE("part index");
+    LoadPhaseTimer phase_timer(load_report, LoadPhase::PartIndex);
+    DeferredPart part;
+    part.file_offset = offset;
+    part.size = size;
+    if (source_path.empty()) {
+        part.data_offset = deferred_part_data.size();
+        if (!source.ReadInto(offset, size, deferred_part_data)) {
+            return false;
+        }
+    }
+    if (!source.Read(offset, &part.first_bytes, std::min<size_t>(sizeof(part.first_bytes), size))) {
+        return false;
+    }
 
-    std::ostringstream a;
-    for (size_t i = 0; i < byteList.size(); i += 2) {
-        uint16_t value = (byteList[i] << 8) | byteList[i + 1];
-        value ^= 0x3C33; // <3
-        a << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << value;
+    // The box of an earlier load of the same block
+    size_t index = deferred_parts.size();
+    if (index < stored_parts.size()) {
+        const DeferredPart& stored = stored_parts[index];
+        if (stored.file_offset == offset && stored.size == size && stored.first_bytes == part.first_bytes) {
+            part.has_box = stored.has_box;
+            part.min = stored.min;
+            part.max = stored.max;
+            load_report.stored_part_boxes++;
+            deferred_parts.push_back(part);
+            pending_part_count++;
+            return true;
+        }
+        // The file has changed since: the rest is indexed again
+        stored_parts.clear();
     }
-    std::string b = a.str();
-    char* c = new char[b.length() + 1];
-    std::copy(b.begin(), b.end(), c);
-    c[b.length()] = '\0';
 
-    std::vector<uint8_t> buf_uint8(buf.begin(), buf.end());
-    uint8_t* p = buf_uint8.data();
-    uint8_t* ep = p + buf_uint8.size();
+    // Only the sub block headers up to the first pin are decrypted: the outline records before
+    // it and the pin itself give the box (the renderer loads a margin around the view, which
+    // covers pins reaching past it). The name is left for LoadPendingPartsNamed().
+    LazyDesReader reader(source, offset, size);
+    auto extend = [&](BRDPoint pos) {
+        if (!part.has_box) {
+            part.min = part.max = pos;
+            part.has_box = true;
+        } else {
+            part.min = {std::min(part.min.x, pos.x), std::min(part.min.y, pos.y)};
+            part.max = {std::max(part.max.x, pos.x), std::max(part.max.y, pos.y)};
+        }
+    };
+    WalkPartBlock(reader, nullptr, [&](uint8_t type, size_t record) {
+        if (type == 0x05) {
+            // Same checks as the parser: a record of at least 24 bytes that fits the block
+            uint32_t line_size = 0;
+            char bytes[LineLayout::size];
+            LineRecord line;
+            if (reader.ReadU32(record, line_size) && line_size >= 24 && line_size <= reader.size() - record - 4 &&
+                reader.Read(record + 4, bytes, sizeof(bytes)) && LineLayout::Decode(ByteCursor(bytes, sizeof(bytes)), line)) {
+                extend(line.GetStart());
+                extend(line.GetEnd());
+            }
+            return true;
+        }
+        uint32_t raw_x = 0, raw_y = 0;
+        // The parser needs the position, rotation and name size of the pin
+        if (record + PinLayout::count_offset <= reader.size() && reader.ReadU32(record + PinX::offset, raw_x) &&
+            reader.ReadU32(record + PinY::offset, raw_y)) {
+            extend({static_cast<int>(raw_x / 10000), static_cast<int>(raw_y / 10000)});
+        }
+        return false;
+    });
 
-    uint64_t k = 0x0000000000000000;
-    const char* kp = c;
-    for (int i = 0; i < 8; i++) {
-        uint64_t v = hexconv[(int)*kp] * 16 + hexconv[(int)*(kp + 1)];
-        k |= (v << ((7 - i) * 8));
-        kp += 2;
+    load_report.des_bytes += reader.GetDecryptedBytes();
+    deferred_parts.push_back(part);
+    pending_part_count++;
+    return true;
+}
+
+// Part index file: <magic> <board size, u64> <entry count, u32>, then per deferred part
+// <offset, u64> <size, u32> <first encrypted bytes, u64> <has box, u8> <min x, y> <max x, y>
+// (i32 each), all little-endian, boxes untranslated
+static const char kPartIndexMagic[8] = {'P', 'C', 'B', 'I', 'D', 'X', '0', '1'};
+static const size_t kPartIndexHeaderBytes = sizeof(kPartIndexMagic) + 12;
+static const size_t kPartIndexEntryBytes = 37;
+
+void XZZPCBFile::ReadPartIndexFile() {
+    std::ifstream file(source_path + ".pcbindex", std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ByteCursor cursor(data.data(), data.size());
+    if (!cursor.Has(kPartIndexHeaderBytes) || std::memcmp(data.data(), kPartIndexMagic, sizeof(kPartIndexMagic)) != 0 ||
+        cursor.Peek<uint64_t>(8) != source_size) {
+        return;
+    }
+    uint32_t count = cursor.Peek<uint32_t>(16);
+    if (!cursor.Has(static_cast<size_t>(count) * kPartIndexEntryBytes, kPartIndexHeaderBytes)) {
+        return;
     }
+    stored_parts.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        size_t entry = kPartIndexHeaderBytes + static_cast<size_t>(i) * kPartIndexEntryBytes;
+        DeferredPart& part = stored_parts[i];
+        part.file_offset = cursor.Peek<uint64_t>(entry);
+        part.size = cursor.Peek<uint32_t>(entry + 8);
+        part.first_bytes = cursor.Peek<uint64_t>(entry + 12);
+        part.has_box = cursor.Peek<uint8_t>(entry + 20) != 0;
+        part.min = {cursor.Peek<int32_t>(entry + 21), cursor.Peek<int32_t>(entry + 25)};
+        part.max = {cursor.Peek<int32_t>(entry + 29), cursor.Peek<int32_t>(entry + 33)};
+    }
+}
 
-    std::vector<uint8_t> decrypted_buf;
-    while (p < ep) {
-        unsigned char e[8];
-        unsigned char d[8];
-        uint64_t d64;
-        uint64_t e64;
+void XZZPCBFile::WritePartIndexFile() const {
+    std::vector<char> data(kPartIndexHeaderBytes + deferred_parts.size() * kPartIndexEntryBytes);
+    char* out = data.data();
+    auto put = [&out](const auto& value) {
+        std::memcpy(out, &value, sizeof(value));
+        out += sizeof(value);
+    };
+    std::memcpy(out, kPartIndexMagic, sizeof(kPartIndexMagic));
+    out += sizeof(kPartIndexMagic);
+    put(source_size);
+    put(static_cast<uint32_t>(deferred_parts.size()));
+    for (const DeferredPart& part : deferred_parts) {
+        put(part.file_offset);
+        put(part.size);
+        put(part.first_bytes);
+        put(static_cast<uint8_t>(part.has_box ? 1 : 0));
+        put(static_cast<int32_t>(part.min.x));
+        put(static_cast<int32_t>(part.min.y));
+        put(static_cast<int32_t>(part.max.x));
+        put(static_cast<int32_t>(part.max.y));
+    }
 
-        // Build encrypted block
-        for (int i = 0; i < 8; i++) {
-            e[7 - i] = *p;
-            p++;
+    // Written aside and renamed, so a concurrent load never reads half a file. A board in a
+    // read-only directory simply has no index file.
+    std::string path = source_path + ".pcbindex";
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+            LOG_DEBUG("Cannot write the part index " << temp_path);
+            return;
         }
-        memcpy(&e64, e, 8);
+    }
+    std::remove(path.c_str());
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        LOG_DEBUG("Cannot write the part index " << path);
+        std::remove(temp_path.c_str());
+    }
+}
 
-        // Decode/decrypt
-        d64 = des(e64, k, 'd');
+void XZZPCBFile::ReadDeferredPartName(DeferredPart& part) {
+    part.name_read = true;
+    std::unique_ptr<MemoryBoardSource> memory;
+    BoardSource* source = nullptr;
+    uint64_t offset = part.file_offset;
+    if (source_path.empty()) {
+        memory = std::make_unique<MemoryBoardSource>(deferred_part_data.data() + part.data_offset, part.size);
+        source = memory.get();
+        offset = 0;
+    } else {
+        source = GetFileSource();
+    }
+    if (!source || offset + part.size > source->GetSize()) {
+        return;
+    }
 
-        // Reverse d64 and append to decrypted_buf
-        for (int i = 0; i < 8; i++) {
-            d[i] = (d64 >> (i * 8)) & 0xff; // Extract each byte
+    LazyDesReader reader(*source, offset, part.size);
+    std::string part_name;
+    if (WalkPartBlock(reader, &part_name, [](uint8_t, size_t) { return false; })) {
+        auto alias = part_alias_dict.find(part_name);
+        part.name = strings.Intern(alias != part_alias_dict.end() ? alias->second : part_name);
+    }
+}
+
+size_t XZZPCBFile::ParseDeferredParts(const std::vector<uint32_t>& indices) {
+    if (indices.empty()) {
+        return 0;
+    }
+    PCB_TRACE_SCOPE("XZZPCBFile::ParseDeferredParts");
+    size_t first_pin = pins.size();
+    size_t first_outline = part_outline_segments.size();
+    size_t first_circle = circles.size();
+    size_t first_rectangle = rectangles.size();
+    size_t first_oval = ovals.size();
+
+    std::vector<char> part_data;
+    for (uint32_t index : indices) {
+        DeferredPart& part = deferred_parts[index];
+        // A block that cannot be read back is dropped rather than retried on every call
+        part.loaded = true;
+        pending_part_count--;
+        part_data.clear();
+        if (!ReadDeferredPart(part, part_data)) {
+            continue;
         }
-        for (int i = 7; i >= 0; i--) {
-            decrypted_buf.push_back(d[i]); // Append in reverse order
+        size_t block_first_pin = pins.size();
+        current_block_offset = part.file_offset;
+        ParsePartBlockOriginal(part_data);
+        AddPinTextSource(0x07, block_first_pin, part.size);
+    }
+
+    // New geometry joins the board coordinates and the Z-order of the pads
+    for (size_t i = first_pin; i < pins.size(); ++i) TranslatePoints(pins[i].pos);
+    for (size_t i = first_outline; i < part_outline_segments.size(); ++i) {
+        TranslatePoints(part_outline_segments[i].first);
+        TranslatePoints(part_outline_segments[i].second);
+    }
+    for (size_t i = first_circle; i < circles.size(); ++i) TranslatePoints(circles[i].center);
+    for (size_t i = first_rectangle; i < rectangles.size(); ++i) TranslatePoints(rectangles[i].center);
+    for (size_t i = first_oval; i < ovals.size(); ++i) TranslatePoints(ovals[i].center);
+    // Pads of earlier batches keep their indices, so caches built over them stay valid
+    SortPadsSpatially(first_circle, first_rectangle, first_oval);
+
+    num_parts = parts.size();
+    num_pins = pins.size();
+    if (pending_part_count == 0) {
+        std::vector<char>().swap(deferred_part_data);
+    }
+    LOG_DEBUG("Parsed " << indices.size() << " deferred part blocks, " << pending_part_count << " pending");
+    return indices.size();
+}
+
+bool XZZPCBFile::ReadDeferredPart(const DeferredPart& part, std::vector<char>& data) const {
+    if (source_path.empty()) {
+        data.assign(deferred_part_data.begin() + part.data_offset,
+                    deferred_part_data.begin() + part.data_offset + part.size);
+        return true;
+    }
+    BoardSource* file = GetFileSource();
+    if (!file || !file->ReadInto(part.file_offset, part.size, data)) {
+        LOG_ERROR("Cannot read the part block at " << part.file_offset);
+        return false;
+    }
+    return true;
+}
+
+size_t XZZPCBFile::LoadPendingParts(BRDPoint min_point, BRDPoint max_point, size_t limit) {
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < deferred_parts.size() && pending_part_count > 0; ++i) {
+        const DeferredPart& part = deferred_parts[i];
+        // Parts without a box come with the first region load
+        if (!part.loaded && (!part.has_box || (part.max.x >= min_point.x && part.min.x <= max_point.x &&
+                                               part.max.y >= min_point.y && part.min.y <= max_point.y))) {
+            indices.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    if (indices.size() > limit) {
+        // Parts nearest the centre of the region first; file order within the batch
+        auto distance = [&](uint32_t index) {
+            const DeferredPart& part = deferred_parts[index];
+            double dx = (static_cast<double>(part.min.x) + part.max.x - min_point.x - max_point.x) * 0.5;
+            double dy = (static_cast<double>(part.min.y) + part.max.y - min_point.y - max_point.y) * 0.5;
+            return dx * dx + dy * dy;
+        };
+        std::nth_element(indices.begin(), indices.begin() + limit, indices.end(),
+                         [&](uint32_t a, uint32_t b) { return distance(a) < distance(b); });
+        indices.resize(limit);
+        std::sort(indices.begin(), indices.end());
+    }
+    return ParseDeferredParts(indices);
+}
+
+size_t XZZPCBFile::LoadPendingPartsNamed(std::string_view name) {
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < deferred_parts.size() && pending_part_count > 0; ++i) {
+        DeferredPart& part = deferred_parts[i];
+        if (part.loaded) {
+            continue;
+        }
+        if (!part.name_read) {
+            ReadDeferredPartName(part);
+        }
+        if (strings.Get(part.name) == name) {
+            indices.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return ParseDeferredParts(indices);
+}
+
+size_t XZZPCBFile::LoadAllPendingParts() {
+    std::vector<uint32_t> indices;
+    for (size_t i = 0; i < deferred_parts.size() && pending_part_count > 0; ++i) {
+        if (!deferred_parts[i].loaded) {
+            indices.push_back(static_cast<uint32_t>(i));
         }
     }
-    buf = std::vector<char>(decrypted_buf.begin(), decrypted_buf.end());
-    delete[] c;
+    return ParseDeferredParts(indices);
+}
+
+bool XZZPCBFile::GetPendingPartBounds(BRDPoint& min_point, BRDPoint& max_point) const {
+    bool found = false;
+    for (const DeferredPart& part : deferred_parts) {
+        if (part.loaded || !part.has_box) {
+            continue;
+        }
+        if (!found) {
+            min_point = part.min;
+            max_point = part.max;
+            found = true;
+        } else {
+            min_point = {std::min(min_point.x, part.min.x), std::min(min_point.y, part.min.y)};
+            max_point = {std::max(max_point.x, part.max.x), std::max(max_point.y, part.max.y)};
+        }
+    }
+    return found;
+}
+
+void XZZPCBFile::AddPinTextSource(uint8_t block_type, size_t first_pin, uint32_t size) {
+    if (!lazy_text || pins.size() == first_pin) {
+        return;
+    }
+    // Test pads take their numbers from their parts, so a run of them is one group
+    if (block_type == 0x09 && !pin_text_sources.empty() && pin_text_sources.back().block_type == 0x09) {
+        return;
+    }
+    PinTextSource source;
+    source.first_pin = static_cast<uint32_t>(first_pin);
+    source.block_type = block_type;
+    source.size = size;
+    source.offset = current_block_offset;
+    pin_text_sources.push_back(source);
+}
+
+std::string_view XZZPCBFile::FindPinComment(const std::string& part_name, const std::string& part_label,
+                                            const std::string& pin_name, uint32_t net_index) const {
+    // JSON readings take priority over the post-v6 section
+    auto json_part = json_diode_dict.find(part_name);
+    if (json_part != json_diode_dict.end()) {
+        auto reading = json_part->second.find(pin_name);
+        if (reading != json_part->second.end()) {
+            return reading->second;
+        }
+    }
+    const std::string* key = nullptr;
+    const char* pin_key = nullptr;
+    if (diode_readings_type == 1) {
+        key = &part_label;
+        pin_key = pin_name.c_str();
+    } else if (diode_readings_type == 2) {
+        auto net_name = net_dict.find(net_index);
+        key = net_name != net_dict.end() ? &net_name->second : nullptr;
+        pin_key = "0";
+    }
+    if (key) {
+        auto readings = diode_dict.find(*key);
+        if (readings != diode_dict.end()) {
+            auto reading = readings->second.find(pin_key);
+            if (reading != readings->second.end()) {
+                return reading->second;
+            }
+        }
+    }
+    return std::string_view();
+}
+
+bool XZZPCBFile::FindPinTextGroup(size_t pin, uint32_t& group, uint32_t& first_pin) const {
+    // Groups are in pin order
+    auto it = std::upper_bound(pin_text_sources.begin(), pin_text_sources.end(), pin,
+                               [](size_t value, const PinTextSource& source) { return value < source.first_pin; });
+    if (it == pin_text_sources.begin()) {
+        return false;
+    }
+    --it;
+    group = static_cast<uint32_t>(it - pin_text_sources.begin());
+    first_pin = it->first_pin;
+    return true;
+}
+
+BoardSource* XZZPCBFile::GetFileSource() const {
+    if (!file_source) {
+        auto file = std::make_unique<FileBoardSource>(kReadBackWindowBytes);
+        if (!file->Open(source_path) || file->GetSize() != source_size) {
+            LOG_ERROR("Cannot read back " << source_path << ": it is missing or has changed");
+            return nullptr;
+        }
+        if (source_xor_key != 0) {
+            file->SetXor(source_xor_key, source_xor_end);
+        }
+        file_source = std::move(file);
+    }
+    return file_source.get();
+}
+
+bool XZZPCBFile::ReadPinTextGroup(uint32_t group, std::vector<std::string>& text) const {
+    PCB_TRACE_SCOPE("XZZPCBFile::ReadPinTextGroup");
+    const PinTextSource& source = pin_text_sources[group];
+    size_t end_pin = group + 1 < pin_text_sources.size() ? pin_text_sources[group + 1].first_pin : pins.size();
+    size_t count = end_pin - source.first_pin;
+    text.assign(count * 3, std::string());
+
+    if (source.block_type == 0x09) {
+        // A test pad's part is named "..." + its number
+        for (size_t i = 0; i < count; ++i) {
+            unsigned int part = pins[source.first_pin + i].part;
+            std::string_view name = part >= 1 && part <= parts.size() ? strings.Get(parts[part - 1].name) : std::string_view();
+            if (name.size() >= 3 && name.compare(0, 3, "...") == 0) {
+                text[i * 3] = std::string(name.substr(3));
+            }
+        }
+        return true;
+    }
+
+    BoardSource* file = GetFileSource();
+    if (!file || source.offset + source.size > file->GetSize()) {
+        return false;
+    }
+
+    // The parser's walk again, decrypting only the pin names and net indices
+    LazyDesReader reader(*file, source.offset, source.size);
+    std::string part_name;
+    std::string part_label;
+    size_t pin = 0;
+    return WalkPartBlock(reader, &part_name, [&](uint8_t type, size_t record) {
+        if (type != 0x09) {
+            return true;
+        }
+        // Records the parser stops at added no pin
+        uint32_t name_size = 0;
+        if (pin >= count || record + PinLayout::count_offset > reader.size() ||
+            !reader.ReadU32(record + PinLayout::count_offset, name_size)) {
+            return false;
+        }
+        size_t name_start = record + PinLayout::bytes_offset;
+        if (name_size > reader.size() - name_start) {
+            return false;
+        }
+        std::string pin_name(name_size, '\0');
+        uint32_t net_index = 0;
+        if (!reader.Read(name_start, &pin_name[0], name_size) || !reader.ReadU32(name_start + name_size + PinNetIndex::offset, net_index)) {
+            return false;
+        }
+        if (part_label.empty()) {
+            auto alias = part_alias_dict.find(part_name);
+            part_label = alias != part_alias_dict.end() ? alias->second : part_name;
+        }
+        text[pin * 3 + 2] = std::string(FindPinComment(part_name, part_label, pin_name, net_index));
+        text[pin * 3] = pin_name;
+        text[pin * 3 + 1] = std::move(pin_name);
+        pin++;
+        return true;
+    });
 }
 
 std::vector<std::pair<BRDPoint, BRDPoint>> XZZPCBFile::xzz_arc_to_segments(int startAngle, int endAngle, int r, BRDPoint pc) {
@@ -378,300 +1217,146 @@ std::vector<std::pair<BRDPoint, BRDPoint>> XZZPCBFile::xzz_arc_to_segments(int s
     return arc_segments;
 }
 
-void XZZPCBFile::ParseArcBlockOriginal(std::vector<uint32_t>& buf) {
-    uint32_t layer = buf[0];
-    uint32_t x = buf[1];
-    uint32_t y = buf[2];
-    int32_t r = buf[3];
-    int32_t angle_start = buf[4];
-    int32_t angle_end = buf[5];
-    int32_t scale = buf[6];
-    // int32_t unknown_arc = buf[7];
-    scale = 10000;
-    if (layer != 28 && layer != 17) {
+void XZZPCBFile::ParseArcBlockOriginal(const ByteCursor& cursor) {
+    ArcRecord arc;
+    if (!ArcLayout::Decode(cursor, arc)) {
+        load_report.malformed_records++;
+        return;
+    }
+    // The record's scale field is ignored: coordinates are always in 1/10000
+    const int32_t scale = 10000;
+    if (arc.layer != 28 && arc.layer != 17) {
         return;
     }
 
-    int point_x = static_cast<int>(x / scale);
-    int point_y = static_cast<int>(y / scale);
-    r = r / scale;
-    angle_start = angle_start / scale;
-    angle_end = angle_end / scale;
+    int point_x = static_cast<int>(arc.x / scale);
+    int point_y = static_cast<int>(arc.y / scale);
+    int32_t r = arc.radius / scale;
+    int32_t angle_start = arc.angle_start / scale;
+    int32_t angle_end = arc.angle_end / scale;
     BRDPoint centre = {point_x, point_y};
 
     std::vector<std::pair<BRDPoint, BRDPoint>> segments = xzz_arc_to_segments(angle_start, angle_end, r, centre);
     std::move(segments.begin(), segments.end(), std::back_inserter(outline_segments));
 }
 
-void XZZPCBFile::ParseLineSegmentBlockOriginal(std::vector<uint32_t>& buf) {
-    int32_t layer = buf[0];
-    int32_t x1 = buf[1];
-    int32_t y1 = buf[2];
-    int32_t x2 = buf[3];
-    int32_t y2 = buf[4];
-    int32_t scale = buf[5];
-    scale = 10000;
-    // int32_t trace_net_index = buf[6];	/* unused */
-    if (layer != 28 && layer != 17) {
+void XZZPCBFile::ParseLineSegmentBlockOriginal(const ByteCursor& cursor) {
+    LineRecord line;
+    if (!LineLayout::Decode(cursor, line)) {
+        load_report.malformed_records++;
         return;
     }
-
-    BRDPoint point;
-    point.x = static_cast<int>(static_cast<double>(x1) / static_cast<double>(scale));
-    point.y = static_cast<int>(static_cast<double>(y1) / static_cast<double>(scale));
-    BRDPoint point2;
-    point2.x = static_cast<int>(static_cast<double>(x2) / static_cast<double>(scale));
-    point2.y = static_cast<int>(static_cast<double>(y2) / static_cast<double>(scale));
-    outline_segments.push_back({point, point2});
+    if (line.layer != 28 && line.layer != 17) {
+        return;
+    }
+    outline_segments.push_back({line.GetStart(), line.GetEnd()});
 }
 
 void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
-    BRDPart blank_part;
-    BRDPin blank_pin;
     BRDPart part;
-    BRDPin pin;
 
     des_decrypt(buf);
-
-    uint32_t current_pointer = 0;
-    if (buf.size() < 4) return;
-    uint32_t part_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    current_pointer += 18;
-    
-    if (current_pointer + 4 > buf.size()) return;
-    uint32_t part_group_name_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    current_pointer += part_group_name_size;
-
-    // So far 0x06 sub blocks have been first always
-    // Also contains part name so needed before pins
-    if (current_pointer >= buf.size() || buf[current_pointer] != 0x06) {
-        return;
-    }
-
-    current_pointer += 31;
-    if (current_pointer + 4 > buf.size()) return;
-    uint32_t part_name_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    if (current_pointer + part_name_size > buf.size()) return;
-    std::string part_name(reinterpret_cast<char*>(&buf[current_pointer]), part_name_size);
-    current_pointer += part_name_size;
-
-    part.name = part_name;
-    
-    // Check if we have an alias for this part from the JSON data
-    if (part_alias_dict.find(part_name) != part_alias_dict.end()) {
-        std::string alias = part_alias_dict[part_name];
-        std::cout << "Using alias for part " << part_name << " -> " << alias << std::endl;
-        part.name = alias;
+    ByteCursor cursor(buf.data(), buf.size());
+
+    // The header, then a 0x06 sub block holding the part name (so far always first, and the
+    // name is needed before the pins)
+    PartHeaderRecord header;
+    PartNameRecord name_record;
+    if (!PartHeaderLayout::Read(cursor, header) || !PartNameLayout::Read(cursor, name_record) || name_record.type != 0x06) return;
+    uint32_t part_size = header.size;
+    std::string part_name(name_record.name);
+
+    // Name shown for the part: its alias from the JSON data when there is one
+    std::string part_label = part_name;
+    auto alias = part_alias_dict.find(part_name);
+    if (alias != part_alias_dict.end()) {
+        LOG_DEBUG("Using alias for part " << part_name << " -> " << alias->second);
+        part_label = alias->second;
     }
+    part.name = strings.Intern(part_label);
     
     part.mounting_side = BRDPartMountingSide::Top;
     part.part_type = BRDPartType::SMD;
 
-    // uint32_t pin_count = 0; /* currently unused */
-    while (current_pointer <= part_size && current_pointer < buf.size()) {
-        uint8_t sub_type_identifier = buf[current_pointer];
-        current_pointer += 1;
+    while (cursor.GetPosition() <= part_size && !cursor.AtEnd()) {
+        uint8_t sub_type_identifier = 0;
+        cursor.Read(sub_type_identifier);
 
         switch (sub_type_identifier) {
-            case 0x01: {
-                // Currently unsure what this is
-                if (current_pointer + 4 > buf.size()) return;
-                current_pointer += *reinterpret_cast<uint32_t*>(&buf[current_pointer]) + 4; // Skip the block
+            case 0x01:   // Currently unsure what this is
+            case 0x06: { // Labels/Part Names - not currently relevant for BRDPin
+                load_report.skipped_sub_blocks++;
+                uint32_t sub_block_size = 0;
+                if (!cursor.Read(sub_block_size)) return;
+                cursor.SkipClamped(sub_block_size);
                 break;
             }
             case 0x05: { // Line Segment - Part outline
-                if (current_pointer + 4 > buf.size()) return;
-                uint32_t line_block_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                current_pointer += 4;
-                
-                // Process line segment data (expected format: similar to main line segments)
-                if (line_block_size >= 24 && current_pointer + line_block_size <= buf.size()) { // 6 uint32_t values = 24 bytes minimum
-                    uint32_t* line_data = reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                    
-                    // Extract line segment data (assuming similar format to ParseLineSegmentBlockOriginal)
-                    // int32_t layer = line_data[0];  // Layer - may not be relevant for part outlines
-                    int32_t x1 = line_data[1];
-                    int32_t y1 = line_data[2]; 
-                    int32_t x2 = line_data[3];
-                    int32_t y2 = line_data[4];
-                    int32_t scale = line_data[5];
-                    
-                    // Use consistent scaling
-                    scale = 10000;
-                    
-                    // Create line segment points
-                    BRDPoint point1;
-                    point1.x = static_cast<int>(static_cast<double>(x1) / static_cast<double>(scale));
-                    point1.y = static_cast<int>(static_cast<double>(y1) / static_cast<double>(scale));
-                    BRDPoint point2;
-                    point2.x = static_cast<int>(static_cast<double>(x2) / static_cast<double>(scale));
-                    point2.y = static_cast<int>(static_cast<double>(y2) / static_cast<double>(scale));
-                    
-                    // Add to part outline segments for rendering (these are part outlines, not board outlines)
-                    part_outline_segments.push_back({point1, point2});
-                    
-                    //std::cout << "DEBUG: Added part outline segment from (" << point1.x << ", " << point1.y 
-                             //<< ") to (" << point2.x << ", " << point2.y << ") for part: " << part_name << std::endl;
+                uint32_t line_block_size = 0;
+                if (!cursor.Read(line_block_size)) return;
+
+                // Same record as the main line segment blocks
+                LineRecord line;
+                if (line_block_size >= 24 && cursor.Has(line_block_size) && LineLayout::Decode(cursor, line)) {
+                    // Part outlines, not board outlines: every layer is kept
+                    part_outline_segments.push_back({line.GetStart(), line.GetEnd()});
                 }
-                
-                current_pointer += line_block_size;
-                break;
-            }
-            case 0x06: { // Labels/Part Names
-                // Not currently relevant for BRDPin
-                if (current_pointer + 4 > buf.size()) return;
-                current_pointer += *reinterpret_cast<uint32_t*>(&buf[current_pointer]) + 4; // Skip the block
+                cursor.SkipClamped(line_block_size);
                 break;
             }
             case 0x09: { // Pins
-                // pin_count += 1;
+                PinRecord record;
+                if (!PinLayout::Decode(cursor, record)) {
+                    load_report.malformed_records++;
+                    return;
+                }
+                BRDPin pin;
                 pin.side = BRDPinSide::Top;
-
-                // Block size
-                if (current_pointer + 4 > buf.size()) return;
-                uint32_t pin_block_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                uint32_t pin_block_end = current_pointer + pin_block_size + 4;
-                current_pointer += 4;
-                current_pointer += 4; // currently unknown
-
-                if (current_pointer + 16 > buf.size()) return;
-                pin.pos.x = *reinterpret_cast<uint32_t*>(&buf[current_pointer]) / 10000;
-                current_pointer += 4;
-                pin.pos.y = *reinterpret_cast<uint32_t*>(&buf[current_pointer]) / 10000;
-                current_pointer += 4;
-                
-                current_pointer += 4; // currently unknown
-                uint32_t pin_rotation = *reinterpret_cast<uint32_t*>(&buf[current_pointer]) / 10000; // Rotation in degrees
-                //pin_rotation = pin_rotation + 90; // Adjust to match BRD coordinate system (0 degrees is right, 90 degrees is up)
-                current_pointer += 4;
-
-                if (current_pointer + 4 > buf.size()) return;
-                uint32_t pin_name_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                current_pointer += 4;
-                if (current_pointer + pin_name_size > buf.size()) return;
-                std::string pin_name(reinterpret_cast<char*>(&buf[current_pointer]), pin_name_size);
-                pin.name = pin_name;
-                pin.snum = pin_name;
-                
-                // Debug: Log pin data loading
-                //std::cout << "DEBUG: Loaded pin - name: '" << pin_name << "', setting snum to: '" << pin.snum << "'" << std::endl;
-                //std::cout << "Pin rotation: '" << pin_rotation << "'" << std::endl;
-
-
-                current_pointer += pin_name_size;
-                uint32_t height_radius_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]); // Height for rectangular pins, radius for circular pins
-                current_pointer += 4;
-                uint32_t width_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]); // Width for rectangular pins
-                current_pointer += 22;
-                uint8_t pin_shape = *reinterpret_cast<uint8_t*>(&buf[current_pointer]); // Shape for pins
-
-
-
-                
-                // Extract shape data based on pin_rotation
-                if (current_pointer + 4 <= buf.size()) {
-                    //uint32_t height_radius_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                    //current_pointer += 4;
-                    
-                    if (pin_shape == 1) {
-                        // Check if it's circular (height == width) or oval (height != width)
-                        if (height_radius_raw == width_raw) {
-                            // Circular pin - height and width are equal
-                            float diameter = static_cast<float>(height_radius_raw) / 10000.0f; // Apply same scaling as coordinates
-                            float radius = diameter / 2.0f;
-                            
-                            // Create circle with red fill color at pin position
-                            BRDCircle circle(pin.pos, radius, 0.7f, 0.0f, 0.0f, 1.0f); // Red color (R=1.0, G=0.0, B=0.0, A=1.0)
-                            circles.push_back(circle);
-                            
-                            //std::cout << "DEBUG: Added circle for pin '" << pin_name << "' at (" << pin.pos.x << ", " << pin.pos.y 
-                                     //<< ") with diameter " << diameter << " (radius " << radius << ")" << std::endl;
-                        } else {
-
-                            // If pin_rotation is 900000, treat as 0 (no rotation), else keep as is
-                        if (pin_rotation == 0 || pin_rotation == 90 || pin_rotation == 180 || pin_rotation == 270 || pin_rotation == 360) {
-                            pin_rotation += 90;
-                        }
-                        
-                            // Oval pin - height and width are different
-                            float height = static_cast<float>(height_radius_raw) / 10000.0f; // Apply same scaling as coordinates
-                            float width = static_cast<float>(width_raw) / 10000.0f;
-                            
-                            // Create oval with red fill color at pin position
-                            BRDOval oval(pin.pos, width, height, static_cast<float>(pin_rotation), 0.7f, 0.0f, 0.0f, 1.0f); // Red color
-                            ovals.push_back(oval);
-                            
-                            //std::cout << "DEBUG: Added oval for pin '" << pin_name << "' at (" << pin.pos.x << ", " << pin.pos.y 
-                                     //<< ") with width " << width << ", height " << height << std::endl;
-                        }
-                    } else {
-                        // If pin_rotation is 900000, treat as 0 (no rotation), else keep as is
-                        if (pin_rotation == 0 || pin_rotation == 90 || pin_rotation == 180 || pin_rotation == 270 || pin_rotation == 360) {
-                            pin_rotation += 90;
-                        }
-                       
-                        
-                        // Rectangular pin - height_radius_raw is height, need to get width next
-                        float height = static_cast<float>(height_radius_raw) / 10000.0f; // Apply same scaling as coordinates
-                        
-                        // Get width (next 4 bytes)
-                        if (current_pointer + 4 <= buf.size()) {
-                            //uint32_t width_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                            float width = static_cast<float>(width_raw) / 10000.0f;
-                            
-                            // Create rectangle with red fill color at pin position
-                            BRDRectangle rectangle(pin.pos, width, height, static_cast<float>(pin_rotation), 0.7f, 0.0f, 0.0f, 1.0f); // Red color
-                            rectangles.push_back(rectangle);
-                            
-                            //std::cout << "DEBUG: Added rectangle for pin '" << pin_name << "' at (" << pin.pos.x << ", " << pin.pos.y 
-                                     //<< ") with width " << width << ", height " << height << ", rotation " << pin_rotation << "°" << "shape: " << pin_shape <<std::endl;
-                        }
-                    }
+                pin.pos.x = record.x / 10000;
+                pin.pos.y = record.y / 10000;
+                uint32_t pin_rotation = record.rotation / 10000; // Rotation in degrees
+                std::string pin_name(record.name);
+
+                // Pad stack of this pin; the pad itself is placed once the pin has its index.
+                // Shape 1 is a circle when height and width agree and an oval otherwise;
+                // anything else is a rectangle.
+                bool circle = record.shape == 1 && record.height_radius == record.width;
+                if (!circle && (pin_rotation == 0 || pin_rotation == 90 || pin_rotation == 180 ||
+                                pin_rotation == 270 || pin_rotation == 360)) {
+                    pin_rotation += 90;
+                }
+                float height = static_cast<float>(record.height_radius) / 10000.0f; // Same scaling as coordinates
+                float width = static_cast<float>(record.width) / 10000.0f;
+                uint32_t pad_stack = 0;
+                if (circle) {
+                    pad_stack = AddPadStack(BRDPadShape::Circle, height, height, 0.0f);
+                } else {
+                    pad_stack = AddPadStack(record.shape == 1 ? BRDPadShape::Oval : BRDPadShape::Rectangle, width, height,
+                                            static_cast<float>(pin_rotation));
                 }
-                
-                current_pointer += 6;
 
-                if (current_pointer + 4 > buf.size()) return;
-                uint32_t net_index = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-                current_pointer = pin_block_end;
+                auto net_ref = net_refs.find(record.net_index);
+                pin.net = net_ref != net_refs.end() ? net_ref->second : StringRef();
+                pin.part = parts.size() + 1;
 
-                std::string diode_reading;
-                std::string pin_net = net_dict[net_index];
-
-                if (pin_net == "NC") {
-                    pin.net = "NC";
-                } else {
-                    pin.net = pin_net;
-                }                pin.part = parts.size() + 1;
-
-                if (!diode_reading.empty()) {
-                    pin.comment = diode_reading;
-                } else if (json_diode_dict.find(part_name) != json_diode_dict.end() &&
-                          json_diode_dict[part_name].find(pin.name) != json_diode_dict[part_name].end()) {
-                    // Use JSON diode reading (prioritize this over other methods)
-                    pin.comment = json_diode_dict[part_name][pin.name];
-                    std::cout << "Using JSON diode reading for " << part_name << " pin " << pin.name << ": " << pin.comment << std::endl;
-                } else if (diode_readings_type == 1) {
-                    if (diode_dict.find(part.name) != diode_dict.end() &&
-                        diode_dict[part.name].find(pin.name) != diode_dict[part.name].end()) {
-                        pin.comment = diode_dict[part.name][pin.name];
-                    }
-                } else if (diode_readings_type == 2) {
-                    if (diode_dict.find(pin.net) != diode_dict.end()) {
-                        pin.comment = diode_dict[pin.net]["0"];
-                    }
+                if (!lazy_text) {
+                    BRDPinText text;
+                    text.name = strings.Intern(pin_name);
+                    text.snum = text.name;
+                    text.comment = strings.Intern(FindPinComment(part_name, part_label, pin_name, record.net_index));
+                    pin_texts.push_back(text);
                 }
 
                 pins.push_back(pin);
-                pin = blank_pin;
+                AddPad(pin.pos, pad_stack, static_cast<uint32_t>(pins.size() - 1));
+                cursor.SkipClamped(static_cast<size_t>(record.size) + 4);
                 break;
             }
             default:
                 if (sub_type_identifier != 0x00) {
-                    printf("Unknown sub block type: 0x%02X at %d in %s\n", sub_type_identifier, current_pointer, part_name.c_str());
+                    load_report.unknown_sub_blocks++;
+                    LOG_DEBUG("Unknown sub block type: 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(sub_type_identifier)
+                              << std::dec << " at " << cursor.GetPosition() << " in " << part_name);
                 }
                 break;
         }
@@ -679,118 +1364,83 @@ void XZZPCBFile::ParsePartBlockOriginal(std::vector<char>& buf) {
 
     part.end_of_pins = pins.size();
     parts.push_back(part);
-    part = blank_part;
 }
 
-void XZZPCBFile::ParseTestPadBlockOriginal(std::vector<uint8_t>& buf) {
-    BRDPart blank_part;
-    BRDPin blank_pin;
-    BRDPart part;
-    BRDPin pin;
-
-    uint32_t current_pointer = 0;
-    if (buf.size() < 20) return;
-    // uint32_t pad_number = *reinterpret_cast<uint32_t*>(&buf[current_pointer]); /* unused */
-    current_pointer += 4;
-    uint32_t x_origin = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    uint32_t y_origin = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    current_pointer += 4; // inner_diameter
-
-    uint32_t pin_rotation = *reinterpret_cast<uint32_t*>(&buf[current_pointer]) / 10000;
-
-    current_pointer += 4; // rotation
-    uint32_t name_length = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    if (current_pointer + name_length > buf.size()) return;
-    std::string name(reinterpret_cast<char*>(&buf[current_pointer]), name_length);
-    current_pointer += name_length;
-    if (current_pointer + 8 > buf.size()) return;
-    uint32_t width_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    uint32_t height_raw = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    current_pointer += 4;
-    uint8_t pin_shape = *reinterpret_cast<uint8_t*>(&buf[current_pointer]);
-
-    // Optionally, store or use width_raw and height_raw for rendering test pad shapes
-    current_pointer = buf.size() - 12;
-    std::cout << "Buffer Size '" << buf.size() << "'" << std::endl;
-    std::cout << "Current Pointer After '" << current_pointer << "'" << std::endl;
-    if (current_pointer >= buf.size()) return;
-    uint32_t net_index = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-    std::cout << "Net index '" << net_index << "'" << std::endl;
+void XZZPCBFile::ParseTestPadBlockOriginal(const ByteCursor& cursor) {
+    TestPadRecord record;
+    if (!DecodeTestPad(cursor, record)) {
+        load_report.malformed_records++;
+        return;
+    }
 
     // Create test pad shapes based on width and height
-    float width = static_cast<float>(width_raw) / 10000.0f;
-    float height = static_cast<float>(height_raw) / 10000.0f;
-
-    
+    float width = static_cast<float>(record.width) / 10000.0f;
+    float height = static_cast<float>(record.height) / 10000.0f;
+    uint32_t pin_rotation = record.rotation / 10000;
 
     BRDPoint test_pad_pos;
-    test_pad_pos.x = static_cast<int>(static_cast<double>(x_origin / 10000.0));
-    test_pad_pos.y = static_cast<int>(static_cast<double>(y_origin / 10000.0));
+    test_pad_pos.x = static_cast<int>(static_cast<double>(record.x / 10000.0));
+    test_pad_pos.y = static_cast<int>(static_cast<double>(record.y / 10000.0));
     
-    if (pin_shape == 1) {
-        // Create circle for test pad when width equals height
-        float radius = width / 2.0f;
-        BRDCircle circle(test_pad_pos, radius, 0.7f, 0.0f, 0.0f, 1.0f); // Green color for test pads
-        circles.push_back(circle);
-        
-        //std::cout << "DEBUG: Added circle test pad '" << name << "' at (" << test_pad_pos.x << ", " << test_pad_pos.y 
-                 //<< ") with radius " << radius << std::endl;
+    uint32_t pad_stack;
+    if (record.shape == 1) {
+        // Circle for test pad when width equals height
+        pad_stack = AddPadStack(BRDPadShape::Circle, width, width, 0.0f);
     } else {
+        // Rectangle for test pad when width differs from height
+        pad_stack = AddPadStack(BRDPadShape::Rectangle, width, height, static_cast<float>(pin_rotation));
+    }
 
-        
-        // Create rectangle for test pad when width differs from height
-        BRDRectangle rectangle(test_pad_pos, width, height, static_cast<float>(pin_rotation), 0.7f, 0.0f, 0.0f, 1.0f); // Green color for test pads
-        rectangles.push_back(rectangle);
-        
-        //std::cout << "DEBUG: Added rectangle test pad '" << name << "' at (" << test_pad_pos.x << ", " << test_pad_pos.y 
-                 //<< ") with width " << width << ", height " << height << std::endl;
-    }    part.name = "..." + name; // To make it get the kPinTypeTestPad type
+    std::string name(record.name);
+    BRDPart part;
+    part.name = strings.Intern("..." + name); // To make it get the kPinTypeTestPad type
     part.mounting_side = BRDPartMountingSide::Top;
     part.part_type = BRDPartType::SMD;
 
-    pin.snum = name;
-    
-    // Debug: Log pin data loading for test pad
-    //std::cout << "DEBUG: Loaded test pad pin - name: '" << name << "', setting snum to: '" << pin.snum << "'" << std::endl;
+    if (!lazy_text) {
+        BRDPinText text;
+        text.snum = strings.Intern(name);
+        pin_texts.push_back(text);
+    }
 
+    BRDPin pin;
     pin.side = BRDPinSide::Top;
-    pin.pos.x = static_cast<int>(static_cast<double>(x_origin / 10000.0));
-    pin.pos.y = static_cast<int>(static_cast<double>(y_origin / 10000.0));
-    if (net_dict.find(net_index) != net_dict.end()) {
-        if (net_dict[net_index] == "UNCONNECTED" || net_dict[net_index] == "NC") {
-            pin.net = ""; // As the part already gets the kPinTypeTestPad type if "UNCONNECTED" is used type will be changed
-                          // to kPinTypeNotConnected
-        } else {
-            pin.net = net_dict[net_index];
-        }
-    } else {
-        pin.net = ""; // As the part already gets the kPinTypeTestPad type if "UNCONNECTED" is used type will be changed to
-                      // kPinTypeNotConnected
+    pin.pos = test_pad_pos;
+    // Unknown, "UNCONNECTED" and "NC" nets are left empty: the part already gets the
+    // kPinTypeTestPad type, which an "UNCONNECTED" net would change to kPinTypeNotConnected
+    auto net_name = net_dict.find(record.net_index);
+    if (net_name != net_dict.end() && net_name->second != "UNCONNECTED" && net_name->second != "NC") {
+        pin.net = net_refs[record.net_index];
     }
     pin.part = parts.size() + 1;
     pins.push_back(pin);
-    pin = blank_pin;
+    AddPad(test_pad_pos, pad_stack, static_cast<uint32_t>(pins.size() - 1));
     part.end_of_pins = pins.size();
     parts.push_back(part);
-    part = blank_part;
 }
 
 void XZZPCBFile::ParseNetBlockOriginal(std::vector<char>& buf) {
-    uint32_t current_pointer = 0;
-    while (current_pointer < buf.size()) {
-        if (current_pointer + 8 > buf.size()) break;
-        uint32_t net_size = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-        current_pointer += 4;
-        uint32_t net_index = *reinterpret_cast<uint32_t*>(&buf[current_pointer]);
-        current_pointer += 4;
-        if (current_pointer + net_size - 8 > buf.size()) break;
-        std::string net_name(&buf[current_pointer], net_size - 8);
+    MemoryBoardSource source(buf);
+    ParseNetBlock(source, 0, buf.size());
+}
+
+void XZZPCBFile::ParseNetBlock(BoardSource& source, uint64_t start, uint64_t size) {
+    // Records are read one at a time: <size incl. header> <index> <name>
+    std::string net_name;
+    uint64_t current_pointer = start;
+    uint64_t end = start + size;
+    while (current_pointer + 8 <= end) {
+        uint32_t header[2];
+        if (!source.Read(current_pointer, header, sizeof(header))) break;
+        uint32_t net_size = header[0];
+        uint32_t net_index = header[1];
+        current_pointer += 8;
+        if (net_size < 8 || current_pointer + (net_size - 8) > end) break;
+        net_name.resize(net_size - 8);
+        if (!source.Read(current_pointer, &net_name[0], net_name.size())) break;
         current_pointer += net_size - 8;
 
+        net_refs[net_index] = strings.Intern(net_name);
         net_dict[net_index] = net_name;
     }
 }
@@ -823,48 +1473,9 @@ std::string XZZPCBFile::read_cb2312_string(const std::string& str) {
 }
 
 // atm some diode readings aren't processed properly
-void XZZPCBFile::ParsePostV6(std::vector<char>::iterator v6_pos, std::vector<char>& buf) {
-    unsigned int current_pointer = v6_pos - buf.begin() + 11;
-    
-    // First, look for JSON data after the specific hex pattern: 3D 3D 3D 50 43 42 B8 BD BC D3 0A
-    std::vector<uint8_t> json_pattern = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, 0xB8, 0xBD, 0xBC, 0xD3, 0x0A};
-    auto json_pattern_found = std::search(buf.begin(), buf.end(), json_pattern.begin(), json_pattern.end());
-    
-    if (json_pattern_found != buf.end()) {
-        std::cout << "Found JSON pattern at position: " << (json_pattern_found - buf.begin()) << std::endl;
-        ParseJsonData(json_pattern_found + json_pattern.size(), buf);
-    } else {
-        std::cout << "JSON pattern not found in buffer" << std::endl;
-        
-        // Try to search for JSON-like data by looking for key strings
-        std::string buffer_str(buf.begin(), buf.end());
-        size_t part_pos = buffer_str.find("\"part\":[");
-        size_t reference_pos = buffer_str.find("\"reference\":");
-        size_t alias_pos = buffer_str.find("\"alias\":");
-        
-        if (part_pos != std::string::npos) {
-            std::cout << "Found 'part' array at position: " << part_pos << std::endl;
-            DumpHexAroundPosition(buf, part_pos, 30);
-            // Find the start of the JSON object by looking backwards for '{'
-            size_t json_start = buffer_str.rfind('{', part_pos);
-            if (json_start != std::string::npos) {
-                std::cout << "Found JSON start at position: " << json_start << std::endl;
-                DumpHexAroundPosition(buf, json_start, 30);
-                ParseJsonData(buf.begin() + json_start, buf);
-            }
-        } else if (reference_pos != std::string::npos || alias_pos != std::string::npos) {
-            std::cout << "Found JSON-like strings but no 'part' array" << std::endl;
-            std::cout << "reference at: " << reference_pos << ", alias at: " << alias_pos << std::endl;
-            if (reference_pos != std::string::npos) {
-                DumpHexAroundPosition(buf, reference_pos, 30);
-            }
-            if (alias_pos != std::string::npos) {
-                DumpHexAroundPosition(buf, alias_pos, 30);
-            }
-        } else {
-            std::cout << "No JSON-like data found in buffer" << std::endl;
-        }
-    }
+void XZZPCBFile::ParsePostV6(const std::vector<char>& buf) {
+    PCB_TRACE_SCOPE("post v6");
+    unsigned int current_pointer = 11; // After the v6v6555v6v6 marker at the start of buf
     
     current_pointer += 7; // While post v6 isnt handled properly
     if (current_pointer >= buf.size()) return;
@@ -967,29 +1578,23 @@ void XZZPCBFile::ParsePostV6(std::vector<char>::iterator v6_pos, std::vector<cha
 }
 
 void XZZPCBFile::ParseJsonData(std::vector<char>::iterator json_start, std::vector<char>& buf) {
+    PCB_ALLOC_SCOPE(JSON);
+    PCB_TRACE_SCOPE("json");
+    LoadPhaseTimer phase_timer(load_report, LoadPhase::Json);
+    load_report.json_bytes += static_cast<uint64_t>(buf.end() - json_start);
     // Convert to string for easier parsing
     std::string json_str(json_start, buf.end());
     
-    // Debug: Print first 200 characters after the pattern
-    std::cout << "First 200 chars after pattern: ";
-    for (size_t i = 0; i < std::min((size_t)200, json_str.length()); i++) {
-        char c = json_str[i];
-        if (c >= 32 && c <= 126) {  // Printable ASCII
-            std::cout << c;
-        } else {
-            std::cout << "[0x" << std::hex << (unsigned char)c << std::dec << "]";
-        }
-    }
-    std::cout << std::endl;
+    LOG_DEBUG("First 200 chars after pattern: " << FormatPrintable(json_str, 200));
     
     // Find the start of the JSON object (first '{')
     size_t json_begin = json_str.find('{');
     if (json_begin == std::string::npos) {
-        std::cout << "No JSON object found after pattern" << std::endl;
+        LOG_DEBUG("No JSON object found after pattern");
         return;
     }
     
-    std::cout << "JSON starts at offset " << json_begin << " after pattern" << std::endl;
+    LOG_DEBUG("JSON starts at offset " << json_begin << " after pattern");
     
     // Find the end of the JSON object by counting braces
     size_t json_end = json_begin;
@@ -1007,20 +1612,20 @@ void XZZPCBFile::ParseJsonData(std::vector<char>::iterator json_start, std::vect
     }
     
     if (brace_count != 0) {
-        std::cout << "Incomplete JSON object found" << std::endl;
+        LOG_WARNING("Incomplete JSON object found");
         return;
     }
     
     // Extract the JSON substring
     std::string json_data = json_str.substr(json_begin, json_end - json_begin + 1);
-    std::cout << "Found JSON data: " << json_data.substr(0, 100) << "..." << std::endl;
+    LOG_DEBUG("Found JSON data: " << json_data.substr(0, 100) << "...");
     
     // Simple JSON parsing for the specific structure
     // Looking for: {"part":[{"reference":"N752","alias":"J11100","pad":[...]},...]}
     
     size_t part_array_start = json_data.find("\"part\":[");
     if (part_array_start == std::string::npos) {
-        std::cout << "No 'part' array found in JSON" << std::endl;
+        LOG_DEBUG("No 'part' array found in JSON");
         return;
     }
     
@@ -1078,7 +1683,7 @@ void XZZPCBFile::ParseJsonData(std::vector<char>::iterator json_start, std::vect
         // Store the alias mapping
         if (!reference.empty() && !alias.empty()) {
             part_alias_dict[reference] = alias;
-            std::cout << "Mapping part " << reference << " -> " << alias << std::endl;
+            LOG_DEBUG("Mapping part " << reference << " -> " << alias);
         }
         
         // Parse pad array for diode readings
@@ -1139,7 +1744,7 @@ void XZZPCBFile::ParseJsonData(std::vector<char>::iterator json_start, std::vect
                 // Store the diode reading for this part and pin
                 if (!reference.empty() && !pin_name.empty() && !diode_reading.empty()) {
                     json_diode_dict[reference][pin_name] = diode_reading;
-                    std::cout << "Diode reading for " << reference << " pin " << pin_name << ": " << diode_reading << std::endl;
+                    LOG_DEBUG("Diode reading for " << reference << " pin " << pin_name << ": " << diode_reading);
                 }
                 
                 pad_pos = pad_end + 1;
@@ -1149,40 +1754,46 @@ void XZZPCBFile::ParseJsonData(std::vector<char>::iterator json_start, std::vect
         pos = part_end + 1;
     }
     
-    std::cout << "Parsed " << part_alias_dict.size() << " part aliases and diode readings" << std::endl;
+    LOG_INFO("Parsed " << part_alias_dict.size() << " part aliases and " << json_diode_dict.size() << " parts with diode readings");
 }
 
 void XZZPCBFile::DumpHexAroundPosition(const std::vector<char>& buf, size_t pos, size_t range) {
+    if (!Log::IsEnabled(LogLevel::Debug)) {
+        return;
+    }
     size_t start = (pos > range) ? pos - range : 0;
     size_t end = std::min(pos + range, buf.size());
     
-    std::cout << "Hex dump around position " << pos << " (range " << start << "-" << end << "):" << std::endl;
+    std::ostringstream dump;
+    dump << "Hex dump around position " << pos << " (range " << start << "-" << end << "):";
     
     for (size_t i = start; i < end; i += 16) {
         // Print offset
-        std::cout << std::hex << std::setw(8) << std::setfill('0') << i << ": ";
+        dump << "\n" << std::hex << std::setw(8) << std::setfill('0') << i << ": ";
         
         // Print hex bytes
         for (size_t j = 0; j < 16 && i + j < end; j++) {
+            int value = static_cast<unsigned char>(buf[i + j]);
             if (i + j == pos) {
-                std::cout << "[" << std::hex << std::setw(2) << std::setfill('0') << (unsigned char)buf[i + j] << "]";
+                dump << "[" << std::setw(2) << std::setfill('0') << value << "]";
             } else {
-                std::cout << std::hex << std::setw(2) << std::setfill('0') << (unsigned char)buf[i + j] << " ";
+                dump << std::setw(2) << std::setfill('0') << value << " ";
             }
         }
         
         // Print ASCII representation
-        std::cout << " | ";
+        dump << " | ";
         for (size_t j = 0; j < 16 && i + j < end; j++) {
             char c = buf[i + j];
             if (i + j == pos) {
-                std::cout << "[" << (c >= 32 && c <= 126 ? c : '.') << "]";
+                dump << "[" << (c >= 32 && c <= 126 ? c : '.') << "]";
             } else {
-                std::cout << (c >= 32 && c <= 126 ? c : '.');
+                dump << (c >= 32 && c <= 126 ? c : '.');
             }
         }
-        std::cout << std::dec << std::endl;
+        dump << std::dec;
     }
+    LOG_DEBUG(dump.str());
 }
 
 // Translation and mirroring functions
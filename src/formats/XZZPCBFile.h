@@ -7,46 +7,156 @@
 #include <string>
 #include <list>
 
+class BoardSource;
+class ByteCursor;
+
 class XZZPCBFile : public BRDFileBase {
 public:
-    XZZPCBFile() = default;
-    ~XZZPCBFile() = default;
+    // Full: every part block is decrypted and parsed by Load().
+    // IndexOnly: Load() records where each part block is and decrypts only the sub block
+    // headers up to its first pin, for a box; the part is parsed by LoadPendingParts*() when
+    // it is needed.
+    enum class LoadMode { Full, IndexOnly };
+
+    XZZPCBFile();
+    ~XZZPCBFile();
+
+    // Largest single buffer the parser holds besides the read window: a main block, the JSON
+    // object or the post-v6 section. A larger block fails the load; a larger trailer is skipped.
+    static const uint64_t kDefaultStreamMemoryCap = 64ull << 20;
+
+    struct LoadOptions {
+        LoadMode mode = LoadMode::Full;
+        uint64_t stream_memory_cap = kDefaultStreamMemoryCap;
+        // Pin numbers, names and diode readings are not kept (pin_texts stays empty): each part
+        // block's are read back from the file the first time one of its pins is asked for.
+        // Applies to LoadFile() only; a board loaded from a buffer always keeps its text.
+        bool lazy_text = false;
+        // Index-only file loads keep the part boxes in <file>.pcbindex and take them from there
+        // while the part blocks are unchanged, so only the first load decrypts anything
+        bool part_index_file = true;
+    };
+
+    void SetLoadOptions(const LoadOptions& options) { load_options = options; }
+    const LoadOptions& GetLoadOptions() const { return load_options; }
 
     // Implementation of pure virtual methods
     bool Load(const std::vector<char>& buffer, const std::string& filepath = "") override;
     bool VerifyFormat(const std::vector<char>& buffer) override;
 
-    // Static factory method
-    static std::unique_ptr<XZZPCBFile> LoadFromFile(const std::string& filepath);
+    // Static factory method; `report` (optional) receives the load report even when loading fails
+    // Streams the file through a fixed read window instead of reading it whole
+    static std::unique_ptr<XZZPCBFile> LoadFromFile(const std::string& filepath, LoadReport* report = nullptr);
+    static std::unique_ptr<XZZPCBFile> LoadFromFile(const std::string& filepath, LoadReport* report,
+                                                    const LoadOptions& options);
+    bool LoadFile(const std::string& filepath);
+
+    size_t GetPendingPartCount() const override { return pending_part_count; }
+    size_t LoadPendingParts(BRDPoint min_point, BRDPoint max_point, size_t limit = SIZE_MAX) override;
+    size_t LoadPendingPartsNamed(std::string_view name) override;
+    size_t LoadAllPendingParts() override;
+    bool GetPendingPartBounds(BRDPoint& min_point, BRDPoint& max_point) const override;
 
     // Legacy compatibility method
     void CreateEnhancedSampleData();
 
 private:
+    // Benchmarks time the parse stages directly (benchmarks/ParserBenchmarks.cpp)
+    friend class ParserBenchmarkAccess;
+
     std::unordered_map<uint32_t, std::string> net_dict;
+    std::unordered_map<uint32_t, StringRef> net_refs; // Net names interned once for the pins
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> diode_dict; // <Net Name, <Pin Name, Reading>>
     std::unordered_map<std::string, std::string> part_alias_dict; // <Reference (original part name), Alias (new part name)>
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> json_diode_dict; // <Reference (part name), <Pin Name, Diode Reading>>
     BRDPoint xy_translation = {0, 0};
+    LoadOptions load_options;
+
+    // A part block kept encrypted by an index-only load
+    struct DeferredPart {
+        uint64_t file_offset = 0;   // Of the encrypted payload, read back when the part is parsed
+        uint32_t size = 0;
+        uint64_t first_bytes = 0;   // First 8 encrypted bytes: a part index file entry must match
+        size_t data_offset = 0;     // Into deferred_part_data (buffer loads)
+        StringRef name;             // Shown name (alias applied), empty if the block has none
+        bool name_read = false;     // Names are decrypted by the first LoadPendingPartsNamed()
+        // min/max enclose the outline records before the first pin and that pin (board
+        // coordinates once translated); a part with neither is loaded by any region load
+        bool has_box = false;
+        bool loaded = false;
+        BRDPoint min = {0, 0};
+        BRDPoint max = {0, 0};
+    };
+    std::vector<DeferredPart> deferred_parts;
+    // Entries of the part index file read by this load, matched in block order
+    std::vector<DeferredPart> stored_parts;
+    // A buffer load has no file to read payloads back from and keeps copies, released once
+    // all are parsed
+    std::vector<char> deferred_part_data;
+    size_t pending_part_count = 0;
     int diode_readings_type = 0; // 0 = No readings, 1 = Based on part name and pin name, 2 = Based on net
 
-    // Core parsing method
+    // Lazy text: where the text of each group of pins is. A part block is one group; a run of
+    // test pads is another (their numbers are their part names).
+    struct PinTextSource {
+        uint32_t first_pin = 0;
+        uint8_t block_type = 0;     // 0x07 part block, 0x09 test pads
+        uint32_t size = 0;
+        uint64_t offset = 0;        // Payload of the part block in the file
+    };
+    bool lazy_text = false;                 // This load keeps no pin text
+    std::vector<PinTextSource> pin_text_sources;
+    uint64_t current_block_offset = 0;      // File position of the block being parsed
+    std::string source_path;                // File of the last LoadFile()
+    uint64_t source_size = 0;
+    uint8_t source_xor_key = 0;
+    uint64_t source_xor_end = 0;
+    mutable std::unique_ptr<BoardSource> file_source;   // Opened on the first read-back
+
+    // Core parsing methods: one walk over the file with 64-bit positions, from memory or a file
+    bool LoadSource(BoardSource& source, const std::string& filepath);
+    bool VerifySource(BoardSource& source);
     bool ParseXZZPCBOriginal(std::vector<char>& buf);
+    bool ParseBoard(BoardSource& source);
+    void ParseTrailer(BoardSource& source, uint64_t trailer_start, uint64_t v6_pos);
+    void ParseJsonObject(BoardSource& source, uint64_t json_start);
     
     // DES decryption
     void des_decrypt(std::vector<char>& buf);
+
+    // Index-only loads: records the part block at `offset` and its box / parses recorded blocks
+    bool IndexPartBlock(BoardSource& source, uint64_t offset, uint32_t size);
+    size_t ParseDeferredParts(const std::vector<uint32_t>& indices);
+    bool ReadDeferredPart(const DeferredPart& part, std::vector<char>& data) const;
+    void ReadDeferredPartName(DeferredPart& part);
+    // <file>.pcbindex: boxes of the deferred parts of an earlier load of the same file
+    void ReadPartIndexFile();
+    void WritePartIndexFile() const;
+    // The file of the last LoadFile(), reopened for reads after the load; null if it is
+    // missing or has changed
+    BoardSource* GetFileSource() const;
+
+    // Lazy text: records the group of the pins a block added since `first_pin`; the base class
+    // reads a group through the overrides
+    bool FindPinTextGroup(size_t pin, uint32_t& group, uint32_t& first_pin) const override;
+    bool ReadPinTextGroup(uint32_t group, std::vector<std::string>& text) const override;
+    void AddPinTextSource(uint8_t block_type, size_t first_pin, uint32_t size);
+    // Diode reading of a pin from the JSON data or the post-v6 section, "" if there is none
+    std::string_view FindPinComment(const std::string& part_name, const std::string& part_label,
+                                    const std::string& pin_name, uint32_t net_index) const;
     
     // Arc conversion
     std::vector<std::pair<BRDPoint, BRDPoint>> xzz_arc_to_segments(int startAngle, int endAngle, int r, BRDPoint pc);
     
     // Block parsing methods
     void ProcessBlockOriginal(uint8_t block_type, std::vector<char>& block_buf);
-    void ParseArcBlockOriginal(std::vector<uint32_t>& buf);
-    void ParseLineSegmentBlockOriginal(std::vector<uint32_t>& buf);
-    void ParsePartBlockOriginal(std::vector<char>& buf);
-    void ParseTestPadBlockOriginal(std::vector<uint8_t>& buf);
-    void ParsePostV6(std::vector<char>::iterator v6_pos, std::vector<char>& buf);
+    void ParseArcBlockOriginal(const ByteCursor& cursor);
+    void ParseLineSegmentBlockOriginal(const ByteCursor& cursor);
+    void ParsePartBlockOriginal(std::vector<char>& buf);   // Decrypts `buf` in place
+    void ParseTestPadBlockOriginal(const ByteCursor& cursor);
+    void ParsePostV6(const std::vector<char>& buf);
     void ParseNetBlockOriginal(std::vector<char>& buf);
+    void ParseNetBlock(BoardSource& source, uint64_t start, uint64_t size);
     void ParseJsonData(std::vector<char>::iterator json_start, std::vector<char>& buf);
     void DumpHexAroundPosition(const std::vector<char>& buf, size_t pos, size_t range = 50);
     
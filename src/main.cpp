@@ -2,6 +2,9 @@
 #include "PCBRenderer.h"
 #include "XZZPCBFile.h"
 #include "Utils.h"
+#include "AllocTracker.h"
+#include "Trace.h"
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -73,7 +76,29 @@ public:
         return true;
     }
 
+    // Writes the load report of every loaded file as JSON to `path` ("-" for stdout)
+    void EnableLoadReportOutput(const std::string& path) {
+        load_report_path = path;
+    }
+
+    // Opens boards without parsing their parts; parts are parsed as they come into view
+    void EnableIndexOnlyLoading() {
+        load_options.mode = XZZPCBFile::LoadMode::IndexOnly;
+    }
+
+    // Keeps no pin text in memory: labels and tooltips read it back from the file when shown
+    void EnableLazyText() {
+        load_options.lazy_text = true;
+    }
+
+    // Records a trace from startup and writes it to `path` on exit (F12 also saves it)
+    void EnableTracing(const std::string& path) {
+        trace_path = path;
+        Trace::SetEnabled(true);
+    }
+    
     void Run(const std::string& pcb_file_path = "") {
+        Trace::SetThreadName("main");
         if (!pcb_file_path.empty()) {
             LoadPCBFile(pcb_file_path);
         } else {
@@ -83,6 +108,9 @@ public:
         LOG_INFO("Starting main render loop");
         int frame_count = 0;
         
+        // Allocation report interval (only printed when PCB_ALLOC_TRACKING is compiled in)
+        const int alloc_report_frames = 600;
+        
         // Frame rate limiting variables
         const double target_fps = 60.0;
         const double frame_time = 1.0 / target_fps;
@@ -97,35 +125,66 @@ public:
             // Calculate delta time for frame rate limiting
             auto current_time = std::chrono::high_resolution_clock::now();
             double delta_time = std::chrono::duration<double>(current_time - last_time).count();
-              window.PollEvents();
-            
-            // Update window size for responsiveness
-            window.UpdateSize();
-            
-            HandleInput();
-            
-            // Start ImGui frame
-            ImGui_ImplOpenGL3_NewFrame();
-            ImGui_ImplGlfw_NewFrame();
-            ImGui::NewFrame();
-            
-            // Render
-            renderer.Render(window.GetWidth(), window.GetHeight());
-            
-            // Display hover information if a pin is hovered
-            DisplayPinHoverInfo();
+            {
+                PCB_TRACE_SCOPE("frame");
+                {
+                    PCB_TRACE_SCOPE("poll events");
+                    window.PollEvents();
+                }
+                
+                // Update window size for responsiveness
+                window.UpdateSize();
+                
+                {
+                    PCB_TRACE_SCOPE("input");
+                    HandleInput();
+                }
+                
+                // Start ImGui frame
+                ImGui_ImplOpenGL3_NewFrame();
+                ImGui_ImplGlfw_NewFrame();
+                ImGui::NewFrame();
+                
+                // Render
+                renderer.Render(window.GetWidth(), window.GetHeight());
+                
+                // Display hover information if a pin is hovered
+                DisplayPinHoverInfo();
+                
+                if (show_load_report) {
+                    DisplayLoadReport();
+                }
+                
+                // Render ImGui
+                {
+                    PCB_TRACE_SCOPE("imgui render");
+                    ImGui::Render();
+                    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+                }
+                
+                {
+                    PCB_TRACE_SCOPE("swap buffers");
+                    window.SwapBuffers();
+                }
+            }
             
-            // Render ImGui
-            ImGui::Render();
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            // Traces are written between frames, while no thread is recording
+            if (trace_save_requested) {
+                trace_save_requested = false;
+                Trace::SetEnabled(false);
+                Trace::WriteChromeTrace(trace_path.empty() ? "pcb_trace.json" : trace_path);
+            }
             
-            window.SwapBuffers();
+            if (frame_count % alloc_report_frames == 0) {
+                AllocTracker::LogReport("frame " + std::to_string(frame_count));
+            }
             
             // Frame rate limiting - only sleep if we're rendering too fast
             double frame_end_time = std::chrono::duration<double>(
                 std::chrono::high_resolution_clock::now() - current_time).count();
             
             if (frame_end_time < frame_time) {
+                PCB_TRACE_SCOPE("sleep");
                 double sleep_time = frame_time - frame_end_time;
                 std::this_thread::sleep_for(std::chrono::microseconds(
                     static_cast<int>(sleep_time * 1000000)));
@@ -136,6 +195,12 @@ public:
     }
 
     void Cleanup() {
+        // Save a trace that was started from the command line
+        if (Trace::IsEnabled() && !trace_path.empty()) {
+            Trace::SetEnabled(false);
+            Trace::WriteChromeTrace(trace_path);
+        }
+        
         // Cleanup ImGui
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
@@ -149,6 +214,14 @@ private:
     Window window;
     PCBRenderer renderer;
     std::shared_ptr<BRDFileBase> pcb_data;
+    // Tracing (F12 starts recording, F12 again saves the trace)
+    std::string trace_path;
+    bool trace_save_requested = false;
+    // Load report of the last file (F9 toggles the panel)
+    LoadReport last_load_report;
+    std::string load_report_path;
+    bool show_load_report = false;
+    XZZPCBFile::LoadOptions load_options;
       // Input state
     bool mouse_dragging = false;
     double last_mouse_x = 0.0;
@@ -192,7 +265,8 @@ private:
             return false;
         }
           // Load XZZPCB file
-        auto xzzpcb = XZZPCBFile::LoadFromFile(filepath);
+        auto xzzpcb = XZZPCBFile::LoadFromFile(filepath, &last_load_report, load_options);
+        WriteLoadReport();
         if (!xzzpcb) {
             LOG_ERROR("Failed to load XZZPCB file: " + filepath);
             return false;
@@ -207,6 +281,7 @@ private:
         renderer.ZoomToFit(window.GetWidth(), window.GetHeight());
         
         LOG_INFO("PCB file loaded successfully");
+        AllocTracker::LogReport("after loading " + filepath);
         return true;
     }
 
@@ -230,7 +305,7 @@ private:
         
         // Sample parts
         BRDPart part1;
-        part1.name = "U1";
+        part1.name = sample_pcb->Intern("U1");
         part1.mounting_side = BRDPartMountingSide::Top;
         part1.part_type = BRDPartType::SMD;
         part1.p1 = {2000, 2000};
@@ -238,7 +313,7 @@ private:
         sample_pcb->parts.push_back(part1);
         
         BRDPart part2;
-        part2.name = "U2";
+        part2.name = sample_pcb->Intern("U2");
         part2.mounting_side = BRDPartMountingSide::Top;
         part2.part_type = BRDPartType::SMD;
         part2.p1 = {6000, 4000};
@@ -255,27 +330,31 @@ private:
             BRDPin pin;
             pin.pos = {2000 + i * 250, 2000};
             pin.part = 0;
-            pin.name = std::to_string(i + 1);  // Pin number
-            pin.net = (i < net_names.size()) ? net_names[i] : "NET_" + std::to_string(i);
-            pin.snum = std::to_string(i + 1);
+            BRDPinText text;
+            text.name = sample_pcb->Intern(std::to_string(i + 1));  // Pin number
+            pin.net = sample_pcb->Intern((i < net_names.size()) ? net_names[i] : "NET_" + std::to_string(i));
+            text.snum = text.name;
             pin.radius = 50;
             sample_pcb->pins.push_back(pin);
+            sample_pcb->pin_texts.push_back(text);
             
             // Debug log each pin
-            LOG_INFO("Pin " + std::to_string(i+1) + ": name='" + pin.name + "', net='" + pin.net + "', snum='" + pin.snum + "'");
+            LOG_INFO("Pin " + std::to_string(i+1) + ": name='" + sample_pcb->GetCString(text.name) + "', net='" + sample_pcb->GetCString(pin.net) + "', snum='" + sample_pcb->GetCString(text.snum) + "'");
         }
           for (int i = 0; i < 6; ++i) {
             BRDPin pin;
             pin.pos = {6000 + i * 300, 4000};
             pin.part = 1;
-            pin.name = std::to_string(i + 1);  // Pin number
-            pin.net = (i < net_names2.size()) ? net_names2[i] : "NET_" + std::to_string(i + 8);
-            pin.snum = std::to_string(i + 1);
+            BRDPinText text;
+            text.name = sample_pcb->Intern(std::to_string(i + 1));  // Pin number
+            pin.net = sample_pcb->Intern((i < net_names2.size()) ? net_names2[i] : "NET_" + std::to_string(i + 8));
+            text.snum = text.name;
             pin.radius = 60;
             sample_pcb->pins.push_back(pin);
+            sample_pcb->pin_texts.push_back(text);
             
             // Debug log each pin
-            LOG_INFO("Pin " + std::to_string(i+9) + ": name='" + pin.name + "', net='" + pin.net + "', snum='" + pin.snum + "'");
+            LOG_INFO("Pin " + std::to_string(i+9) + ": name='" + sample_pcb->GetCString(text.name) + "', net='" + sample_pcb->GetCString(pin.net) + "', snum='" + sample_pcb->GetCString(text.snum) + "'");
         }// Validate and set data
         sample_pcb->SetValid(true);  // For demo data, we know it's valid
         
@@ -316,6 +395,34 @@ private:
             renderer.ZoomToFit(window.GetWidth(), window.GetHeight());
         }
         
+        // F12 starts a trace recording; pressing it again saves the trace
+        static bool f12_pressed = false;
+        if (glfwGetKey(glfw_window, GLFW_KEY_F12) == GLFW_PRESS) {
+            if (!f12_pressed) {
+                f12_pressed = true;
+                if (Trace::IsEnabled()) {
+                    trace_save_requested = true;
+                } else {
+                    Trace::Clear();
+                    Trace::SetEnabled(true);
+                    LOG_INFO("Trace recording started - press F12 again to save it");
+                }
+            }
+        } else {
+            f12_pressed = false;
+        }
+        
+        // F9 shows or hides the load report panel
+        static bool f9_pressed = false;
+        if (glfwGetKey(glfw_window, GLFW_KEY_F9) == GLFW_PRESS) {
+            if (!f9_pressed) {
+                f9_pressed = true;
+                show_load_report = !show_load_report;
+            }
+        } else {
+            f9_pressed = false;
+        }
+        
         // Ctrl+O to open file
         static bool ctrl_o_pressed = false;
         if (glfwGetKey(glfw_window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || 
@@ -394,6 +501,78 @@ private:
         renderer.Zoom(zoom_factor, mouse_world_x, mouse_world_y);
     }
     
+    void WriteLoadReport() {
+        if (load_report_path.empty()) {
+            return;
+        }
+        std::string json = last_load_report.ToJson();
+        if (load_report_path == "-") {
+            // Keep queued log lines from interleaving with the JSON
+            Log::Flush();
+            std::cout << json << std::endl;
+            return;
+        }
+        std::ofstream file(load_report_path);
+        if (!file.is_open()) {
+            LOG_ERROR("Cannot write load report: " + load_report_path);
+            return;
+        }
+        file << json << std::endl;
+        LOG_INFO("Load report written to " + load_report_path);
+    }
+
+    void DisplayLoadReport() {
+        const LoadReport& report = last_load_report;
+        ImGui::SetNextWindowPos(ImVec2(10, 300), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Load Report", &show_load_report, ImGuiWindowFlags_AlwaysAutoResize)) {
+            ImGui::End();
+            return;
+        }
+        if (report.file_path.empty()) {
+            ImGui::Text("No file loaded");
+            ImGui::End();
+            return;
+        }
+
+        ImGui::Text("File: %s", report.file_path.c_str());
+        if (report.success) {
+            ImGui::Text("Loaded in %.1f ms (%.1f MB)", report.total_ms, report.file_bytes / (1024.0 * 1024.0));
+        } else {
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Failed: %s", report.error.c_str());
+        }
+
+        if (ImGui::CollapsingHeader("Phases", ImGuiTreeNodeFlags_DefaultOpen)) {
+            for (size_t i = 0; i < report.phase_ms.size(); ++i) {
+                LoadPhase phase = static_cast<LoadPhase>(i);
+                ImGui::Text("%-16s %8.2f ms", LoadReport::GetPhaseName(phase), report.GetPhaseMs(phase));
+            }
+        }
+        if (ImGui::CollapsingHeader("Blocks", ImGuiTreeNodeFlags_DefaultOpen)) {
+            for (int type = 0; type < 256; ++type) {
+                if (report.block_counts[type] > 0) {
+                    ImGui::Text("0x%02X  %u", type, report.block_counts[type]);
+                }
+            }
+            ImGui::Text("Unknown blocks: %u, truncated: %u", report.unknown_blocks, report.truncated_blocks);
+            ImGui::Text("Sub-blocks skipped: %u, unknown: %u", report.skipped_sub_blocks, report.unknown_sub_blocks);
+        }
+        if (ImGui::CollapsingHeader("Bytes and memory")) {
+            ImGui::Text("XOR: %llu", static_cast<unsigned long long>(report.xor_bytes));
+            ImGui::Text("Net block: %llu", static_cast<unsigned long long>(report.net_block_bytes));
+            ImGui::Text("Main blocks: %llu", static_cast<unsigned long long>(report.main_block_bytes));
+            ImGui::Text("DES: %llu", static_cast<unsigned long long>(report.des_bytes));
+            ImGui::Text("JSON: %llu", static_cast<unsigned long long>(report.json_bytes));
+            if (report.peak_heap_bytes > 0) {
+                ImGui::Text("Peak heap: %.1f MB", report.peak_heap_bytes / (1024.0 * 1024.0));
+            }
+            if (report.peak_resident_bytes > 0) {
+                ImGui::Text("Peak resident: %.1f MB", report.peak_resident_bytes / (1024.0 * 1024.0));
+            }
+        }
+        ImGui::Text("%u parts, %u pins, %u nets", report.parts, report.pins, report.nets);
+        ImGui::End();
+    }
+    
     void DisplayPinHoverInfo() {
         // Get current mouse position
         double mouse_x, mouse_y;
@@ -419,16 +598,19 @@ private:
                 ImGui::Text("Pin Information:");
                 ImGui::Separator();
                 
-                if (!pin.snum.empty()) {
-                    ImGui::Text("Pin Number: %s", pin.snum.c_str());
-                }                if (!pin.name.empty() && pin.name != pin.snum) {
-                    ImGui::Text("Pin Name: %s", pin.name.c_str());
+                // Pin text views are NUL-terminated (read back here on lazy-text boards)
+                std::string_view pin_number = pcb_data->GetPinNumber(hovered_pin);
+                std::string_view pin_name = pcb_data->GetPinName(hovered_pin);
+                if (!pin_number.empty()) {
+                    ImGui::Text("Pin Number: %s", pin_number.data());
+                }                if (!pin_name.empty() && pin_name != pin_number) {
+                    ImGui::Text("Pin Name: %s", pin_name.data());
                 }
                 if (!pin.net.empty()) {
-                    ImGui::Text("Net: %s", pin.net.c_str());
+                    ImGui::Text("Net: %s", pcb_data->GetCString(pin.net));
                     
                     // Count connected pins in the same net
-                    if (pin.net != "UNCONNECTED" && pin.net != "") {
+                    if (pcb_data->GetString(pin.net) != "UNCONNECTED") {
                         int connected_pins = 0;
                         for (const auto& other_pin : pcb_data->pins) {
                             if (other_pin.net == pin.net) {
@@ -466,16 +648,18 @@ private:
                     ImGui::Text("Selected Pin:");
                     ImGui::Separator();
                     
-                    if (!pin.snum.empty()) {
-                        ImGui::Text("Pin Number: %s", pin.snum.c_str());
+                    std::string_view pin_number = pcb_data->GetPinNumber(selected_pin);
+                    std::string_view pin_name = pcb_data->GetPinName(selected_pin);
+                    if (!pin_number.empty()) {
+                        ImGui::Text("Pin Number: %s", pin_number.data());
                     }
-                    if (!pin.name.empty() && pin.name != pin.snum) {
-                        ImGui::Text("Pin Name: %s", pin.name.c_str());
+                    if (!pin_name.empty() && pin_name != pin_number) {
+                        ImGui::Text("Pin Name: %s", pin_name.data());
                     }                    if (!pin.net.empty()) {
-                        ImGui::Text("Net: %s", pin.net.c_str());
+                        ImGui::Text("Net: %s", pcb_data->GetCString(pin.net));
                         
                         // Show connected pins count for selected pin
-                        if (pin.net != "UNCONNECTED" && pin.net != "") {
+                        if (pcb_data->GetString(pin.net) != "UNCONNECTED") {
                             int connected_pins = 0;
                             for (const auto& other_pin : pcb_data->pins) {
                                 if (other_pin.net == pin.net) {
@@ -509,6 +693,8 @@ int main(int argc, char* argv[]) {    std::cout << "PCB Viewer - XZZPCB Format S
     std::cout << "  Mouse Wheel: Zoom in/out" << std::endl;
     std::cout << "  R Key: Reset view to fit PCB" << std::endl;
     std::cout << "  Ctrl+O: Open PCB file" << std::endl;
+    std::cout << "  F9: Show/hide the load report" << std::endl;
+    std::cout << "  F12: Start / save a performance trace (Chrome trace JSON)" << std::endl;
     std::cout << "  ESC Key: Exit application" << std::endl;
     std::cout << std::endl;
 
@@ -519,15 +705,34 @@ int main(int argc, char* argv[]) {    std::cout << "PCB Viewer - XZZPCB Format S
         return -1;
     }
 
-    // Check if a file path was provided
+    // Arguments: [--log-level <debug|info|warning|error|off>] [--trace <trace.json>]
+    //            [--load-report <report.json|->] [--index-only] [--lazy-text] [pcb file]
     std::string pcb_file_path;
-    if (argc > 1) {
-        pcb_file_path = argv[1];
-        if (!Utils::FileExists(pcb_file_path)) {
-            LOG_ERROR("File does not exist: " + pcb_file_path);
-            pcb_file_path.clear();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--log-level" && i + 1 < argc) {
+            LogLevel level;
+            if (Log::ParseLevel(argv[++i], level)) {
+                Log::SetLevel(level);
+            } else {
+                LOG_ERROR("Unknown log level: " << argv[i]);
+            }
+        } else if (arg == "--trace" && i + 1 < argc) {
+            app.EnableTracing(argv[++i]);
+        } else if (arg == "--load-report" && i + 1 < argc) {
+            app.EnableLoadReportOutput(argv[++i]);
+        } else if (arg == "--index-only") {
+            app.EnableIndexOnlyLoading();
+        } else if (arg == "--lazy-text") {
+            app.EnableLazyText();
+        } else {
+            pcb_file_path = arg;
         }
     }
+    if (!pcb_file_path.empty() && !Utils::FileExists(pcb_file_path)) {
+        LOG_ERROR("File does not exist: " + pcb_file_path);
+        pcb_file_path.clear();
+    }
 
     try {
         app.Run(pcb_file_path);
@@ -0,0 +1,314 @@
+#include "CullKernel.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define PCB_CULL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(PCB_CULL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PCB_CULL_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#else
+#define PCB_CULL_TARGET_AVX2
+#endif
+
+namespace {
+
+// Lanes a vector kernel may write past `count` when storing a compacted group
+const size_t kOutputPadding = 8;
+
+void PrepareOutput(size_t element_count, VisibleSet& out) {
+    // Grows only when a larger board is loaded; steady-state frames do not allocate
+    size_t needed = element_count + kOutputPadding;
+    if (out.index.size() < needed) {
+        out.index.resize(needed);
+        out.screen_x.resize(needed);
+        out.screen_y.resize(needed);
+    }
+    out.count = 0;
+}
+
+void TransformAndCullScalar(const float* x, const float* y, const float* radius, size_t begin, size_t end,
+                            const ScreenTransform& view, VisibleSet& out) {
+    size_t count = out.count;
+    for (size_t i = begin; i < end; ++i) {
+        float screen_x = x[i] * view.zoom + view.offset_x;
+        float screen_y = view.offset_y - y[i] * view.zoom;
+        float reach = radius[i] * view.zoom + view.margin;
+
+        if (screen_x + reach >= 0.0f && screen_x - reach <= view.width &&
+            screen_y + reach >= 0.0f && screen_y - reach <= view.height) {
+            out.index[count] = static_cast<uint32_t>(i);
+            out.screen_x[count] = screen_x;
+            out.screen_y[count] = screen_y;
+            count++;
+        }
+    }
+    out.count = count;
+}
+
+#if defined(PCB_CULL_X86)
+
+// SSE2 is baseline on x86-64: four elements per step, survivors written lane by lane
+void TransformAndCullSSE2(const float* x, const float* y, const float* radius, size_t begin, size_t end,
+                          const ScreenTransform& view, VisibleSet& out) {
+    const __m128 zoom = _mm_set1_ps(view.zoom);
+    const __m128 offset_x = _mm_set1_ps(view.offset_x);
+    const __m128 offset_y = _mm_set1_ps(view.offset_y);
+    const __m128 margin = _mm_set1_ps(view.margin);
+    const __m128 width = _mm_set1_ps(view.width);
+    const __m128 height = _mm_set1_ps(view.height);
+    const __m128 zero = _mm_setzero_ps();
+
+    alignas(16) float lane_x[4];
+    alignas(16) float lane_y[4];
+    size_t count = out.count;
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 sx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), zoom), offset_x);
+        __m128 sy = _mm_sub_ps(offset_y, _mm_mul_ps(_mm_loadu_ps(y + i), zoom));
+        __m128 reach = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(radius + i), zoom), margin);
+
+        __m128 visible = _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(sx, reach), zero),
+                                    _mm_cmple_ps(_mm_sub_ps(sx, reach), width));
+        visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(sy, reach), zero));
+        visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_sub_ps(sy, reach), height));
+
+        int mask = _mm_movemask_ps(visible);
+        if (mask == 0) {
+            continue;
+        }
+        _mm_store_ps(lane_x, sx);
+        _mm_store_ps(lane_y, sy);
+        for (int lane = 0; lane < 4; ++lane) {
+            if (mask & (1 << lane)) {
+                out.index[count] = static_cast<uint32_t>(i + lane);
+                out.screen_x[count] = lane_x[lane];
+                out.screen_y[count] = lane_y[lane];
+                count++;
+            }
+        }
+    }
+    out.count = count;
+    TransformAndCullScalar(x, y, radius, i, end, view, out);
+}
+
+// Lane permutation per 8-bit visibility mask: visible lanes first, in order
+struct CompactTable {
+    alignas(32) uint32_t lanes[256][8];
+
+    CompactTable() {
+        for (int mask = 0; mask < 256; ++mask) {
+            int n = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) {
+                    lanes[mask][n++] = static_cast<uint32_t>(lane);
+                }
+            }
+            while (n < 8) {
+                lanes[mask][n++] = 0;
+            }
+        }
+    }
+};
+
+const CompactTable& GetCompactTable() {
+    static const CompactTable table;
+    return table;
+}
+
+// AVX2: eight elements per step; survivors are packed with a permute and stored as a
+// full vector (the output carries kOutputPadding spare slots for the unused tail)
+PCB_CULL_TARGET_AVX2
+void TransformAndCullAVX2(const float* x, const float* y, const float* radius, size_t begin, size_t end,
+                          const ScreenTransform& view, VisibleSet& out) {
+    const CompactTable& table = GetCompactTable();
+    const __m256 zoom = _mm256_set1_ps(view.zoom);
+    const __m256 offset_x = _mm256_set1_ps(view.offset_x);
+    const __m256 offset_y = _mm256_set1_ps(view.offset_y);
+    const __m256 margin = _mm256_set1_ps(view.margin);
+    const __m256 width = _mm256_set1_ps(view.width);
+    const __m256 height = _mm256_set1_ps(view.height);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256i lane_offsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    uint32_t* out_index = out.index.data();
+    float* out_x = out.screen_x.data();
+    float* out_y = out.screen_y.data();
+    size_t count = out.count;
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 sx = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), zoom), offset_x);
+        __m256 sy = _mm256_sub_ps(offset_y, _mm256_mul_ps(_mm256_loadu_ps(y + i), zoom));
+        __m256 reach = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(radius + i), zoom), margin);
+
+        __m256 visible = _mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(sx, reach), zero, _CMP_GE_OQ),
+                                       _mm256_cmp_ps(_mm256_sub_ps(sx, reach), width, _CMP_LE_OQ));
+        visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(sy, reach), zero, _CMP_GE_OQ));
+        visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_sub_ps(sy, reach), height, _CMP_LE_OQ));
+
+        int mask = _mm256_movemask_ps(visible);
+        if (mask == 0) {
+            continue;
+        }
+        __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(table.lanes[mask]));
+        __m256i indices = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), lane_offsets);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_index + count), _mm256_permutevar8x32_epi32(indices, perm));
+        _mm256_storeu_ps(out_x + count, _mm256_permutevar8x32_ps(sx, perm));
+        _mm256_storeu_ps(out_y + count, _mm256_permutevar8x32_ps(sy, perm));
+        count += static_cast<size_t>(_mm_popcnt_u32(static_cast<unsigned int>(mask)));
+    }
+    out.count = count;
+    TransformAndCullScalar(x, y, radius, i, end, view, out);
+}
+
+bool CpuSupportsAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool popcnt = (info[2] & (1 << 23)) != 0;
+    if (!osxsave || !avx || !popcnt) return false;
+    // OS must save YMM state
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#endif
+}
+
+#endif // PCB_CULL_X86
+
+enum class KernelKind { Scalar, SSE2, AVX2 };
+
+KernelKind SelectKernel() {
+#if defined(PCB_CULL_X86)
+    static const KernelKind kind = CpuSupportsAVX2() ? KernelKind::AVX2 : KernelKind::SSE2;
+    return kind;
+#else
+    return KernelKind::Scalar;
+#endif
+}
+
+void Dispatch(const CullElements& elements, size_t begin, size_t end, const ScreenTransform& view, VisibleSet& out) {
+    const float* x = elements.x.data();
+    const float* y = elements.y.data();
+    const float* radius = elements.radius.data();
+
+    switch (SelectKernel()) {
+#if defined(PCB_CULL_X86)
+    case KernelKind::AVX2:
+        TransformAndCullAVX2(x, y, radius, begin, end, view, out);
+        break;
+    case KernelKind::SSE2:
+        TransformAndCullSSE2(x, y, radius, begin, end, view, out);
+        break;
+#endif
+    default:
+        TransformAndCullScalar(x, y, radius, begin, end, view, out);
+        break;
+    }
+}
+
+// Same test as the kernels, applied to a block's bounds (Y is mirrored on screen), with a
+// pixel of slack so rounding never drops an element the kernel would keep
+bool IsBlockVisible(const CullElements& elements, size_t block, const ScreenTransform& view) {
+    const float margin = view.margin + 1.0f;
+    float left = elements.block_min_x[block] * view.zoom + view.offset_x;
+    float right = elements.block_max_x[block] * view.zoom + view.offset_x;
+    float top = view.offset_y - elements.block_max_y[block] * view.zoom;
+    float bottom = view.offset_y - elements.block_min_y[block] * view.zoom;
+    return right + margin >= 0.0f && left - margin <= view.width &&
+           bottom + margin >= 0.0f && top - margin <= view.height;
+}
+
+} // namespace
+
+void CullElements::BuildBlocks() {
+    // Full blocks of elements that were already covered are kept
+    size_t first_block = std::min(block_element_count, Size()) / kBlockSize;
+    size_t block_count = (Size() + kBlockSize - 1) / kBlockSize;
+    block_min_x.resize(block_count);
+    block_min_y.resize(block_count);
+    block_max_x.resize(block_count);
+    block_max_y.resize(block_count);
+    for (size_t block = first_block; block < block_count; ++block) {
+        size_t begin = block * kBlockSize;
+        size_t end = std::min(begin + kBlockSize, Size());
+        float min_x = x[begin] - radius[begin], max_x = x[begin] + radius[begin];
+        float min_y = y[begin] - radius[begin], max_y = y[begin] + radius[begin];
+        for (size_t i = begin + 1; i < end; ++i) {
+            min_x = std::min(min_x, x[i] - radius[i]);
+            max_x = std::max(max_x, x[i] + radius[i]);
+            min_y = std::min(min_y, y[i] - radius[i]);
+            max_y = std::max(max_y, y[i] + radius[i]);
+        }
+        block_min_x[block] = min_x;
+        block_min_y[block] = min_y;
+        block_max_x[block] = max_x;
+        block_max_y[block] = max_y;
+    }
+    block_element_count = Size();
+}
+
+namespace CullKernel {
+
+void TransformAndCull(const CullElements& elements, const ScreenTransform& view, VisibleSet& out) {
+    TransformAndCull(elements, 0, elements.Size(), view, out);
+}
+
+void TransformAndCull(const CullElements& elements, size_t begin, size_t end, const ScreenTransform& view, VisibleSet& out) {
+    end = end < elements.Size() ? end : elements.Size();
+    begin = begin < end ? begin : end;
+    PrepareOutput(end - begin, out);
+    if (begin == end) {
+        return;
+    }
+
+    // Block bounds assume a positive zoom (larger board x is further right on screen)
+    if (!elements.HasBlocks() || !(view.zoom > 0.0f)) {
+        Dispatch(elements, begin, end, view, out);
+        return;
+    }
+
+    // Consecutive visible blocks are merged into one run for the kernel
+    const size_t block_size = CullElements::kBlockSize;
+    size_t run_begin = begin;
+    size_t run_end = begin;
+    for (size_t block = begin / block_size; block * block_size < end; ++block) {
+        size_t block_begin = std::max(begin, block * block_size);
+        size_t block_end = std::min(end, (block + 1) * block_size);
+        if (IsBlockVisible(elements, block, view)) {
+            if (run_end != block_begin) {
+                run_begin = block_begin;
+            }
+            run_end = block_end;
+            continue;
+        }
+        if (run_end > run_begin) {
+            Dispatch(elements, run_begin, run_end, view, out);
+        }
+        run_begin = run_end = block_end;
+    }
+    if (run_end > run_begin) {
+        Dispatch(elements, run_begin, run_end, view, out);
+    }
+}
+
+const char* ActiveKernelName() {
+    switch (SelectKernel()) {
+    case KernelKind::AVX2: return "avx2";
+    case KernelKind::SSE2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+} // namespace CullKernel
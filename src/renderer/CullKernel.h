@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Board-to-screen mapping shared by all render passes:
+// screen_x = x * zoom + offset_x, screen_y = offset_y - y * zoom (Y mirrored)
+struct ScreenTransform {
+    float zoom = 1.0f;
+    float offset_x = 0.0f;
+    float offset_y = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+    float margin = 10.0f;  // Extra screen pixels kept around the viewport
+};
+
+// Structure-of-arrays element set: centre and culling radius in board units.
+// Built once per board so the per-frame kernel streams plain float arrays.
+struct CullElements {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> radius;
+
+    // Bounds (radius included) of each run of kBlockSize consecutive elements. With the
+    // elements in spatial order the kernel skips whole runs that are off screen.
+    static const size_t kBlockSize = 64;
+    std::vector<float> block_min_x, block_min_y, block_max_x, block_max_y;
+    size_t block_element_count = 0;  // Size() when the blocks were built
+
+    void Clear() {
+        x.clear(); y.clear(); radius.clear();
+        block_min_x.clear(); block_min_y.clear(); block_max_x.clear(); block_max_y.clear();
+        block_element_count = 0;
+    }
+    void Reserve(size_t count) { x.reserve(count); y.reserve(count); radius.reserve(count); }
+    void Add(float cx, float cy, float r) { x.push_back(cx); y.push_back(cy); radius.push_back(r); }
+    size_t Size() const { return x.size(); }
+
+    // Call after the last Add(); blocks are ignored once more elements are added. Calling it
+    // again after appending rebuilds only the blocks from the last partial one on.
+    void BuildBlocks();
+    bool HasBlocks() const { return block_element_count == Size() && !block_min_x.empty(); }
+};
+
+// Compact output of the kernel: visible element indices with their screen-space centres.
+// Storage is sized to the input once and reused across frames.
+struct VisibleSet {
+    std::vector<uint32_t> index;
+    std::vector<float> screen_x;
+    std::vector<float> screen_y;
+    size_t count = 0;
+};
+
+namespace CullKernel {
+    // Transforms every element to screen space, culls it against the viewport (plus margin)
+    // and writes the survivors, in input order, to `out`.
+    void TransformAndCull(const CullElements& elements, const ScreenTransform& view, VisibleSet& out);
+
+    // Same for the element range [begin, end); output indices stay relative to the whole set.
+    // Elements with blocks are tested run by run; the output is the same either way.
+    void TransformAndCull(const CullElements& elements, size_t begin, size_t end, const ScreenTransform& view, VisibleSet& out);
+
+    // Name of the implementation picked at startup ("avx2", "sse2" or "scalar")
+    const char* ActiveKernelName();
+}
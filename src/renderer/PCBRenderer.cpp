@@ -1,37 +1,102 @@
 #include "PCBRenderer.h"
 #include "Utils.h"
+#include "ThreadPool.h"
+#include "AllocTracker.h"
+#include "Trace.h"
+#include "SpatialOrder.h"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <vector>
 #include <set>
 #include <imgui.h>
+#include <imgui_impl_opengl3.h>
 #include <cctype>
+#include <cstddef>
+#include <cstring>
 
-// Simple vertex shader - kept for reference but not used in ImGui rendering
+// Width of the per-pin style texture; rows are added as the pin count grows
+static const int kStyleTextureWidth = 1024;
+
+// Base colour of every pad before net/ground/NC styling
+static const float kPadColor[4] = { 0.7f, 0.0f, 0.0f, 1.0f };
+
+// Instanced pad vertex shader: expands a unit quad around each pad in screen space
 const char* vertex_shader_source = R"(
 #version 330 core
-layout (location = 0) in vec2 aPos;
-layout (location = 1) in vec3 aColor;
+layout (location = 0) in vec2 aCorner;       // Unit quad corner (-1..1)
+layout (location = 1) in vec2 aCenter;       // Pad centre (board units)
+layout (location = 2) in vec2 aHalfSize;     // Pad half width/height (board units)
+layout (location = 3) in float aRotation;    // Radians
+layout (location = 4) in uvec2 aShapeStyle;  // Shape kind, style texel index
 
-uniform mat4 projection;
-out vec3 vertexColor;
+uniform vec3 transform;       // zoom, offset_x, offset_y (board units -> screen pixels)
+uniform vec2 viewport_size;   // Screen pixels
+uniform sampler2D style_tex;  // Per-pin RGBA colour
+
+flat out vec4 padColor;
+flat out uint padShape;
+flat out vec2 padHalfSize;
+out vec2 padLocal;            // Fragment position relative to the pad centre, in pixels
 
 void main() {
-    gl_Position = projection * vec4(aPos, 0.0, 1.0);
-    vertexColor = aColor;
+    // Keep tiny pads visible (same minimum size as the CPU passes) and leave a pixel for anti-aliasing
+    vec2 half_px = max(aHalfSize * transform.x, vec2(1.0));
+    vec2 local = aCorner * (half_px + 1.0);
+
+    float c = cos(aRotation);
+    float s = sin(aRotation);
+    vec2 center = vec2(aCenter.x * transform.x + transform.y, transform.z - aCenter.y * transform.x);
+    vec2 screen = center + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+    gl_Position = vec4(screen.x / viewport_size.x * 2.0 - 1.0, 1.0 - screen.y / viewport_size.y * 2.0, 0.0, 1.0);
+
+    int style = int(aShapeStyle.y);
+    int width = textureSize(style_tex, 0).x;
+    padColor = texelFetch(style_tex, ivec2(style % width, style / width), 0);
+    padShape = aShapeStyle.x;
+    padHalfSize = half_px;
+    padLocal = local;
 }
 )";
 
-// Simple fragment shader - kept for reference but not used in ImGui rendering
+// Instanced pad fragment shader: analytic signed distance for circles, rectangles and stadiums
 const char* fragment_shader_source = R"(
 #version 330 core
-in vec3 vertexColor;
+flat in vec4 padColor;
+flat in uint padShape;
+flat in vec2 padHalfSize;
+in vec2 padLocal;
 out vec4 FragColor;
 
-uniform float alpha;
+float BoxDistance(vec2 p, vec2 half_size) {
+    vec2 d = abs(p) - half_size;
+    return length(max(d, 0.0)) + min(max(d.x, d.y), 0.0);
+}
+
+float StadiumDistance(vec2 p, vec2 half_size) {
+    float radius = min(half_size.x, half_size.y);
+    vec2 segment = half_size - vec2(radius);
+    return length(p - clamp(p, -segment, segment)) - radius;
+}
 
 void main() {
-    FragColor = vec4(vertexColor, alpha);
+    float d;
+    if (padShape == 0u) {
+        d = length(padLocal) - padHalfSize.x;
+    } else if (padShape == 1u) {
+        d = BoxDistance(padLocal, padHalfSize);
+    } else {
+        d = StadiumDistance(padLocal, padHalfSize);
+    }
+
+    float coverage = clamp(0.5 - d, 0.0, 1.0);
+    if (coverage <= 0.0) {
+        discard;
+    }
+
+    // Darker one pixel rim, matching the outline drawn by the CPU passes
+    float rim = clamp(d + 1.5, 0.0, 1.0);
+    FragColor = vec4(mix(padColor.rgb, padColor.rgb * 0.7, rim), padColor.a * coverage);
 }
 )";
 
@@ -43,38 +108,81 @@ PCBRenderer::~PCBRenderer() {
 }
 
 bool PCBRenderer::Initialize() {
-    // Create minimal OpenGL resources for compatibility
-    // Note: These resources aren't actively used for rendering anymore (ImGui handles the drawing)
-    // but are kept for compatibility with the OpenGL context
+    // Worker pool for the CPU draw-list passes
+    if (settings.render_threads != 1) {
+        render_pool.reset(new ThreadPool(settings.render_threads > 1 ? settings.render_threads - 1 : 0));
+        if (render_pool->GetWorkerCount() == 0) {
+            render_pool.reset();
+        }
+    }
+    LOG_INFO("Render threads: " + std::to_string(render_pool ? render_pool->GetConcurrency() : 1));
     
+    // The instanced pad renderer is optional: if the GL 3.3 pipeline cannot be built
+    // the CPU (ImDrawList) passes are used instead
     if (!CreateShaderProgram()) {
-        LOG_ERROR("Failed to create shader program");
-        return false;
+        LOG_ERROR("Failed to create pad shader program - using CPU pad rendering");
+        gpu_pads_ready = false;
+        return true;
     }
+    
+    transform_loc = glGetUniformLocation(shader_program, "transform");
+    viewport_loc = glGetUniformLocation(shader_program, "viewport_size");
+    style_loc = glGetUniformLocation(shader_program, "style_tex");
 
-    // Create VAO and VBO
+    // Create VAO, unit quad VBO and instance VBO
     glGenVertexArrays(1, &vao);
     glGenBuffers(1, &vbo);
+    glGenBuffers(1, &instance_vbo);
+    glGenTextures(1, &style_texture);
 
     glBindVertexArray(vao);
+    
+    // Unit quad corners, drawn as a triangle strip
+    const float quad_corners[] = { -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-    // Position attribute
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad_corners), quad_corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
-    // Color attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // Per-instance attributes
+    glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(PadInstance), (void*)offsetof(PadInstance, center_x));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(PadInstance), (void*)offsetof(PadInstance, half_width));
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(PadInstance), (void*)offsetof(PadInstance, rotation));
+    glVertexAttribIPointer(4, 2, GL_UNSIGNED_INT, sizeof(PadInstance), (void*)offsetof(PadInstance, shape));
+    for (GLuint attrib = 1; attrib <= 4; ++attrib) {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+    
+    // Style texture: nearest sampling, fetched with texelFetch
+    glBindTexture(GL_TEXTURE_2D, style_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    gpu_pads_ready = true;
 
     LOG_INFO("PCB Renderer initialized successfully");
     return true;
 }
 
 void PCBRenderer::Cleanup() {
+    render_pool.reset();
+    pan_cache.Release();
+    static_draw_list.reset();
+    static_cache_valid = false;
+    if (style_texture) {
+        glDeleteTextures(1, &style_texture);
+        style_texture = 0;
+    }
+    if (instance_vbo) {
+        glDeleteBuffers(1, &instance_vbo);
+        instance_vbo = 0;
+    }
     if (vbo) {
         glDeleteBuffers(1, &vbo);
         vbo = 0;
@@ -87,10 +195,17 @@ void PCBRenderer::Cleanup() {
         glDeleteProgram(shader_program);
         shader_program = 0;
     }
+    gpu_pads_ready = false;
+    pad_instance_count = 0;
 }
 
 void PCBRenderer::SetPCBData(std::shared_ptr<BRDFileBase> data) {
+    PCB_ALLOC_SCOPE(CacheBuild);
+    PCB_TRACE_SCOPE("PCBRenderer::SetPCBData");
     pcb_data = data;
+    data_generation++;
+    overlay_selection = -2;
+    cached_counts = BoardCacheCounts();
     
     if (pcb_data && pcb_data->IsValid()) {
         LOG_INFO("PCB data set: " + std::to_string(pcb_data->parts.size()) + 
@@ -98,10 +213,118 @@ void PCBRenderer::SetPCBData(std::shared_ptr<BRDFileBase> data) {
         
         // Build performance optimization cache
         BuildPinGeometryCache();
+        BuildPartBoundsCache();
+        BuildPartLabelCache();
+        BuildCullElements();
+        cached_counts = CountCachedElements();
+    }
+    
+    // Retained GPU data: pad instances are uploaded once per board
+    UploadPadInstances();
+}
+
+BoardCacheCounts PCBRenderer::CountCachedElements() const {
+    BoardCacheCounts counts;
+    counts.parts = pcb_data->parts.size();
+    counts.pins = pcb_data->pins.size();
+    counts.circles = pcb_data->circles.size();
+    counts.rectangles = pcb_data->rectangles.size();
+    counts.ovals = pcb_data->ovals.size();
+    counts.part_outline_segments = pcb_data->part_outline_segments.size();
+    return counts;
+}
+
+// Pending parts are parsed this far (in view sizes) beyond each edge, ahead of a pan
+static const float kPendingPartMargin = 0.5f;
+// Pending parts parsed by the first loading frame. The batch doubles on each following frame,
+// so a zoomed-out view streams the whole board in over a logarithmic number of frames.
+static const size_t kPendingPartBatch = 256;
+
+void PCBRenderer::LoadVisiblePendingParts(int window_width, int window_height) {
+    if (pcb_data->GetPendingPartCount() == 0) {
+        return;
+    }
+    PCB_TRACE_SCOPE("PCBRenderer::LoadVisiblePendingParts");
+    float half_width = window_width * (0.5f + kPendingPartMargin) / camera.zoom;
+    float half_height = window_height * (0.5f + kPendingPartMargin) / camera.zoom;
+    BRDPoint min_point = {static_cast<int>(std::floor(camera.x - half_width)), static_cast<int>(std::floor(camera.y - half_height))};
+    BRDPoint max_point = {static_cast<int>(std::ceil(camera.x + half_width)), static_cast<int>(std::ceil(camera.y + half_height))};
+    pending_part_batch = std::max(pending_part_batch, kPendingPartBatch);
+    size_t loaded = pcb_data->LoadPendingParts(min_point, max_point, pending_part_batch);
+    pending_part_batch = loaded == pending_part_batch ? pending_part_batch * 2 : kPendingPartBatch;
+    if (loaded == 0) {
+        return;
     }
+    
+    // Parts, pins and pads were appended and earlier pads kept their places, so existing
+    // indices (selection, hover, cached pads) stay valid and only the new elements are added
+    PCB_ALLOC_SCOPE(CacheBuild);
+    data_generation++;
+    overlay_selection = -2;
+    BoardCacheCounts from = cached_counts;
+    BuildPinGeometryCache(from);
+    BuildPartBoundsCache(from);
+    BuildPartLabelCache(from);
+    BuildCullElements(from);
+    UploadPadInstances(from);
+    cached_counts = CountCachedElements();
 }
 
+// Seconds on a monotonic clock, used for the frame budget
+static double GetTimeSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Elements handed to one progressive step before the budget is checked again
+static const size_t kProgressiveBatch = 4096;
+
 void PCBRenderer::Render(int window_width, int window_height) {
+    if (pcb_data && pcb_data->IsValid()) {
+        // Initialize camera if needed (first time rendering)
+        static bool camera_initialized = false;
+        if (!camera_initialized) {
+            ZoomToFit(window_width, window_height);
+            camera_initialized = true;
+        }
+        // Before the frame starts, so no pass sees the board grow and the parse is not
+        // counted as frame time or frame allocations
+        LoadVisiblePendingParts(window_width, window_height);
+    }
+    
+    PCB_ALLOC_SCOPE(Frame);
+    frame_profiler.BeginFrame();
+    frame_arena.Reset();
+    
+    RenderFrame(window_width, window_height);
+    
+    // A frame that repeats the previous inputs (after a warm-up frame for buffer growth)
+    // redraws an unchanged scene and must not allocate
+    FrameInputs inputs;
+    inputs.camera_x = camera.x;
+    inputs.camera_y = camera.y;
+    inputs.zoom = camera.zoom;
+    inputs.window_width = window_width;
+    inputs.window_height = window_height;
+    inputs.data_generation = data_generation;
+    inputs.selected_pin = selected_pin_index;
+    inputs.hovered_pin = hovered_pin_index;
+    inputs.refining = IsRefining();
+    inputs.part_outlines = settings.show_part_outlines;
+    inputs.gpu_pads = settings.gpu_pads;
+    inputs.pan_cache = settings.pan_cache;
+    inputs.frame_budget_ms = settings.frame_budget_ms;
+    inputs.detail = pad_detail_level;
+    unchanged_frames = inputs == last_frame_inputs ? unchanged_frames + 1 : 0;
+    last_frame_inputs = inputs;
+    
+    bool steady_state = pcb_data && pcb_data->IsValid() && !inputs.refining && unchanged_frames >= 2;
+    frame_profiler.EndFrame(steady_state);
+    PCB_TRACE_COUNTER("render ms", frame_profiler.GetLastFrameMs());
+}
+
+void PCBRenderer::RenderFrame(int window_width, int window_height) {
+    PCB_TRACE_SCOPE("PCBRenderer::Render");
+    frame_start_time = GetTimeSeconds();
     if (!pcb_data || !pcb_data->IsValid()) {
         LOG_INFO("No PCB data to render");
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -113,19 +336,22 @@ void PCBRenderer::Render(int window_width, int window_height) {
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    // Initialize camera if needed (first time rendering)
-    static bool camera_initialized = false;
-    if (!camera_initialized) {
-        ZoomToFit(window_width, window_height);
-        camera_initialized = true;
-    }
+    // Lazily read pin text is dropped only here, so the labels of this frame stay valid
+    pcb_data->TrimTextCache();
     
     // Calculate screen transform from camera
     float zoom = camera.zoom;
     float offset_x = window_width * 0.5f - camera.x * zoom;
     float offset_y = window_height * 0.5f + camera.y * zoom;  // Mirror Y-axis
     
-    // Apply camera transformation
+    // Pad detail depends on zoom only (with hysteresis)
+    UpdatePadDetailLevel(zoom);
+    
+    // Bring the static layer cache up to date (full redraw, or scroll + exposed strips) and show it
+    bool static_layers_cached = settings.pan_cache && UpdatePanCache(zoom, offset_x, offset_y, window_width, window_height);
+    if (static_layers_cached) {
+        pan_cache.PresentToScreen();
+    }
 
     // Create a fullscreen ImGui window for PCB rendering
     ImGui::SetNextWindowPos(ImVec2(0, 0));
@@ -147,30 +373,275 @@ void PCBRenderer::Render(int window_width, int window_height) {
         LOG_ERROR("Failed to get ImGui draw list");
         ImGui::End();
         return;
-    }    // Use structured ImGui rendering methods (like original OpenBoardView)
-    RenderOutlineImGui(draw_list, zoom, offset_x, offset_y);
-    if (settings.show_part_outlines) {
-        RenderPartOutlineImGui(draw_list, zoom, offset_x, offset_y);
     }
-    RenderCirclePinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
-    RenderRectanglePinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
-    RenderOvalPinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+    
+    // Static layers come from the pan cache when it is usable, otherwise they are drawn directly
+    if (!static_layers_cached) {
+        RenderStaticLayers(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+        static_cursor = { StaticStage::Done, 0 };
+    }
+
+    // Selection overlays: highlighted net pads, then the boxes of the parts on that net
+    UpdateSelectionOverlay();
+    RenderNetHighlightOverlay(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+    RenderPartHighlighting(draw_list, zoom, offset_x, offset_y);
 
-    // Collect part names for rendering on top
-    CollectPartNamesForRendering(zoom, offset_x, offset_y);
+    // Labels have the lowest priority: they wait until the static layers are complete
+    if (!IsRefining()) {
+        // Collect part names for rendering on top
+        CollectPartNamesForRendering(zoom, offset_x, offset_y);
 
-    // Render part names on top of all other graphics
-    RenderPartNamesOnTop(draw_list);
+        // Render part names on top of all other graphics
+        RenderPartNamesOnTop(draw_list);
 
-    // Render pin numbers as text overlays
-    RenderPinNumbersAsText(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+        // Render pin numbers as text overlays
+        RenderPinNumbersAsText(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+    }
     
-    // Render part highlighting on top of everything
-    RenderPartHighlighting(draw_list, zoom, offset_x, offset_y);
+    // Hover ring goes over everything else
+    RenderHoverRing(draw_list, zoom, offset_x, offset_y);
 
     ImGui::End();
 }
 
+void PCBRenderer::RenderStaticLayers(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    RenderStaticLayers(draw_list, zoom, offset_x, offset_y, window_width, window_height,
+                       StaticCursor(), StaticCursor{ StaticStage::Done, 0 });
+}
+
+size_t PCBRenderer::GetStaticStageSize(StaticStage stage) const {
+    switch (stage) {
+    case StaticStage::Outline:
+        return outline_cull.Size();
+    case StaticStage::PartOutlines:
+        return settings.show_part_outlines ? part_outline_cull.Size() : 0;
+    case StaticStage::Pads:
+        if ((gpu_pads_ready && settings.gpu_pads && pad_instance_count > 0) || pad_detail_level != PadDetailLevel::Full) {
+            return 1;
+        }
+        return circle_cull.Size() + rectangle_cull.Size() + oval_cull.Size();
+    default:
+        return 0;
+    }
+}
+
+PCBRenderer::StaticCursor PCBRenderer::NormalizeStaticCursor(StaticCursor cursor) const {
+    // Skip stages that are finished or empty
+    while (cursor.stage != StaticStage::Done && cursor.element >= GetStaticStageSize(cursor.stage)) {
+        cursor.stage = static_cast<StaticStage>(static_cast<int>(cursor.stage) + 1);
+        cursor.element = 0;
+    }
+    return cursor;
+}
+
+void PCBRenderer::RenderStaticLayers(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                                     const StaticCursor& from, const StaticCursor& to) {
+    for (int stage_value = 0; stage_value < static_cast<int>(StaticStage::Done); ++stage_value) {
+        StaticStage stage = static_cast<StaticStage>(stage_value);
+        size_t count = GetStaticStageSize(stage);
+        
+        // Part of this stage inside [from, to)
+        size_t begin = stage < from.stage ? count : (stage == from.stage ? from.element : 0);
+        size_t end = stage < to.stage ? count : (stage == to.stage ? to.element : 0);
+        end = std::min(end, count);
+        if (begin >= end) {
+            continue;
+        }
+        
+        if (stage == StaticStage::Outline) {
+            // Use structured ImGui rendering methods (like original OpenBoardView)
+            RenderOutlineImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height, begin, end);
+        } else if (stage == StaticStage::PartOutlines) {
+            RenderPartOutlineImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height, begin, end);
+        } else if (gpu_pads_ready && settings.gpu_pads && pad_instance_count > 0) {
+            // Draw pads at the current detail level.
+            // The instanced GPU path draws every pad at constant CPU cost, so it replaces all LOD levels.
+            RenderPadsGPU(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+        } else if (pad_detail_level == PadDetailLevel::Full) {
+            // Pad elements are numbered circles first, then rectangles, then ovals
+            size_t circles = circle_cull.Size();
+            size_t rectangles = rectangle_cull.Size();
+            if (begin < circles) {
+                RenderCirclePinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height,
+                                      begin, std::min(end, circles));
+            }
+            if (begin < circles + rectangles && end > circles) {
+                RenderRectanglePinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height,
+                                         std::max(begin, circles) - circles, std::min(end, circles + rectangles) - circles);
+            }
+            if (end > circles + rectangles) {
+                RenderOvalPinsImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height,
+                                    std::max(begin, circles + rectangles) - circles - rectangles, end - circles - rectangles);
+            }
+        } else if (pad_detail_level == PadDetailLevel::Clusters) {
+            RenderPadClustersImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+        } else {
+            RenderPadDensityImGui(draw_list, zoom, offset_x, offset_y, window_width, window_height);
+        }
+    }
+}
+
+bool PCBRenderer::UpdatePanCache(float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    PCB_TRACE_SCOPE("UpdatePanCache");
+    if (pan_cache_failed || window_width <= 0 || window_height <= 0) {
+        return false;
+    }
+    
+    const ImVec2 scale = ImGui::GetIO().DisplayFramebufferScale;
+    int framebuffer_width = static_cast<int>(window_width * scale.x + 0.5f);
+    int framebuffer_height = static_cast<int>(window_height * scale.y + 0.5f);
+    if (!pan_cache.EnsureSize(framebuffer_width, framebuffer_height)) {
+        pan_cache_failed = true;
+        static_cache_valid = false;
+        return false;
+    }
+    
+    StaticLayerKey key;
+    key.zoom = zoom;
+    key.window_width = window_width;
+    key.window_height = window_height;
+    key.data_generation = data_generation;
+    key.detail = pad_detail_level;
+    key.part_outlines = settings.show_part_outlines;
+    key.gpu_pads = gpu_pads_ready && settings.gpu_pads;
+    
+    // A pure pan moves the image by whole pixels; anything else needs a full redraw
+    float shift_x = offset_x - static_cache_offset_x;
+    float shift_y = offset_y - static_cache_offset_y;
+    int dx = static_cast<int>(std::lround(shift_x));
+    int dy = static_cast<int>(std::lround(shift_y));
+    float fb_dx = dx * scale.x;
+    float fb_dy = dy * scale.y;
+    bool full_redraw = !static_cache_valid || !(key == static_cache_key) ||
+                       std::fabs(shift_x - dx) > 0.05f || std::fabs(shift_y - dy) > 0.05f ||
+                       std::abs(dx) >= window_width || std::abs(dy) >= window_height ||
+                       std::fabs(fb_dx - std::lround(fb_dx)) > 0.01f || std::fabs(fb_dy - std::lround(fb_dy)) > 0.01f;
+    
+    if (full_redraw) {
+        pan_cache.ClearRegion(0, 0, framebuffer_width, framebuffer_height, 0.0f, 0.0f, 0.0f);
+        static_cache_key = key;
+        static_cache_valid = true;
+        static_cache_offset_x = offset_x;
+        static_cache_offset_y = offset_y;
+        
+        // With a frame budget the image is built over several frames, most important layers first
+        static_cursor = StaticCursor();
+        if (settings.frame_budget_ms > 0.0f) {
+            RefineStaticLayers(zoom, offset_x, offset_y, window_width, window_height);
+        } else {
+            RenderStaticRegion(0, 0, window_width, window_height, zoom, offset_x, offset_y, window_width, window_height,
+                               static_cursor, StaticCursor{ StaticStage::Done, 0 });
+            static_cursor = { StaticStage::Done, 0 };
+        }
+        return true;
+    }
+    
+    if (dx == 0 && dy == 0) {
+        if (IsRefining()) {
+            RefineStaticLayers(zoom, offset_x, offset_y, window_width, window_height);
+        }
+        return true;
+    }
+    
+    pan_cache.Scroll(static_cast<int>(std::lround(fb_dx)), static_cast<int>(std::lround(fb_dy)), 0.0f, 0.0f, 0.0f);
+    
+    // Exposed strips: a full-height column for horizontal movement, the rest of the row for vertical.
+    // They get the same layers as the rest of the image so a pending refinement stays consistent.
+    const StaticCursor strip_begin;
+    int column_width = std::abs(dx);
+    if (column_width > 0) {
+        int column_x = dx > 0 ? 0 : window_width - column_width;
+        RenderStaticRegion(column_x, 0, column_width, window_height, zoom, offset_x, offset_y, window_width, window_height,
+                           strip_begin, static_cursor);
+    }
+    int row_height = std::abs(dy);
+    int row_width = window_width - column_width;
+    if (row_height > 0 && row_width > 0) {
+        int row_x = dx > 0 ? column_width : 0;
+        int row_y = dy > 0 ? 0 : window_height - row_height;
+        RenderStaticRegion(row_x, row_y, row_width, row_height, zoom, offset_x, offset_y, window_width, window_height,
+                           strip_begin, static_cursor);
+    }
+    
+    static_cache_offset_x += dx;
+    static_cache_offset_y += dy;
+    
+    if (IsRefining()) {
+        RefineStaticLayers(zoom, offset_x, offset_y, window_width, window_height);
+    }
+    return true;
+}
+
+void PCBRenderer::RefineStaticLayers(float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    PCB_TRACE_SCOPE("RefineStaticLayers");
+    // Continues the static layers from the persistent cursor until this frame's budget is spent.
+    // At least one batch is drawn per frame so the image always completes.
+    const double budget = settings.frame_budget_ms * 0.001;
+    ImDrawList* list = BeginStaticRegion(0, 0, window_width, window_height, window_height);
+    do {
+        StaticCursor from = NormalizeStaticCursor(static_cursor);
+        if (from.stage == StaticStage::Done) {
+            static_cursor = from;
+            break;
+        }
+        StaticCursor to = from;
+        to.element = std::min(from.element + kProgressiveBatch, GetStaticStageSize(from.stage));
+        RenderStaticLayers(list, zoom, offset_x, offset_y, window_width, window_height, from, to);
+        static_cursor = to;
+    } while (GetTimeSeconds() - frame_start_time < budget);
+    EndStaticRegion(0, 0, window_width, window_height);
+}
+
+void PCBRenderer::RenderStaticRegion(int x, int y, int region_width, int region_height, float zoom, float offset_x, float offset_y,
+                                     int window_width, int window_height, const StaticCursor& from, const StaticCursor& to) {
+    PCB_TRACE_SCOPE("RenderStaticRegion");
+    // Build the region in its own coordinates so culling only keeps what touches it
+    ImDrawList* list = BeginStaticRegion(x, y, region_width, region_height, window_height);
+    RenderStaticLayers(list, zoom, offset_x - x, offset_y - y, region_width, region_height, from, to);
+    EndStaticRegion(x, y, window_width, window_height);
+}
+
+ImDrawList* PCBRenderer::BeginStaticRegion(int x, int y, int region_width, int region_height, int window_height) {
+    ImGuiIO& io = ImGui::GetIO();
+    if (!static_draw_list) {
+        static_draw_list.reset(new ImDrawList(ImGui::GetDrawListSharedData()));
+    }
+    
+    ImDrawList* list = static_draw_list.get();
+    list->_ResetForNewFrame();
+    list->PushTextureID(io.Fonts->TexID);
+    list->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(static_cast<float>(region_width), static_cast<float>(region_height)));
+    
+    static_region.active = true;
+    static_region.x = x;
+    static_region.y = y;
+    static_region.width = region_width;
+    static_region.height = region_height;
+    static_region.window_height = window_height;
+    return list;
+}
+
+void PCBRenderer::EndStaticRegion(int x, int y, int window_width, int window_height) {
+    ImGuiIO& io = ImGui::GetIO();
+    ImDrawList* list = static_draw_list.get();
+    static_region.active = false;
+    
+    list->PopClipRect();
+    list->PopTextureID();
+    
+    // Shifting the display origin places the region inside the full-window image
+    static_draw_data.Clear();
+    static_draw_data.Valid = true;
+    static_draw_data.DisplayPos = ImVec2(static_cast<float>(-x), static_cast<float>(-y));
+    static_draw_data.DisplaySize = ImVec2(static_cast<float>(window_width), static_cast<float>(window_height));
+    static_draw_data.FramebufferScale = io.DisplayFramebufferScale;
+    static_draw_data.AddDrawList(list);
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, pan_cache.GetFrontFramebuffer());
+    ImGui_ImplOpenGL3_RenderDrawData(&static_draw_data);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
 void PCBRenderer::SetCamera(float x, float y, float zoom) {
     camera.x = x;
     camera.y = y;
@@ -229,9 +700,7 @@ void PCBRenderer::ZoomToFit(int window_width, int window_height) {
     camera.y = (min_point.y + max_point.y) * 0.5f;
 }
 
-// Legacy OpenGL shader functions - kept for reference but not needed for ImGui rendering
 bool PCBRenderer::CreateShaderProgram() {
-    // Creating a minimal shader program to satisfy OpenGL initialization
     GLuint vertex_shader = CompileShader(vertex_shader_source, GL_VERTEX_SHADER);
     if (!vertex_shader) return false;
     
@@ -256,6 +725,8 @@ bool PCBRenderer::CreateShaderProgram() {
         LOG_ERROR("Shader program linking failed: " + std::string(info_log));
         glDeleteShader(vertex_shader);
         glDeleteShader(fragment_shader);
+        glDeleteProgram(shader_program);
+        shader_program = 0;
         return false;
     }
 
@@ -285,6 +756,190 @@ GLuint PCBRenderer::CompileShader(const char* source, GLenum type) {
     return shader;
 }
 
+void PCBRenderer::UploadPadInstances(const BoardCacheCounts& from) {
+    PCB_TRACE_SCOPE("UploadPadInstances");
+    bool append = from.pins > 0 && pad_instance_count > 0;
+    if (!append) {
+        pad_instance_count = 0;
+    }
+    if (!gpu_pads_ready) {
+        return;
+    }
+    
+    std::vector<PadInstance> instances;
+    if (pcb_data && pcb_data->IsValid()) {
+        instances.reserve(pcb_data->circles.size() + pcb_data->rectangles.size() + pcb_data->ovals.size() -
+                          (append ? from.circles + from.rectangles + from.ovals : 0));
+        
+        const float deg_to_rad = 3.14159265f / 180.0f;
+        
+        // Same draw order as the CPU passes: circles, rectangles, ovals. Each instance is a
+        // pad stack placed at a position. Appended pads follow all earlier ones, so a batch of
+        // pending parts draws its circles after the ovals already on the board.
+        auto add_instances = [&](const std::vector<BRDPad>& pads, size_t first, PadShapeKind kind) {
+            for (size_t pad_idx = append ? first : 0; pad_idx < pads.size(); ++pad_idx) {
+                const BRDPad& pad = pads[pad_idx];
+                const BRDPadStack& stack = pcb_data->GetPadStack(pad);
+                instances.push_back({ static_cast<float>(pad.center.x), static_cast<float>(pad.center.y),
+                                      stack.width * 0.5f, stack.height * 0.5f,
+                                      kind == PadShapeKind::Circle ? 0.0f : stack.rotation * deg_to_rad,
+                                      static_cast<unsigned int>(kind),
+                                      pad.pin < pcb_data->pins.size() ? pad.pin + 1 : 0u });
+            }
+        };
+        add_instances(pcb_data->circles, from.circles, PadShapeKind::Circle);
+        add_instances(pcb_data->rectangles, from.rectangles, PadShapeKind::Rectangle);
+        add_instances(pcb_data->ovals, from.ovals, PadShapeKind::Oval);
+    }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+    if (!append) {
+        glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(PadInstance),
+                     instances.empty() ? nullptr : instances.data(), GL_STATIC_DRAW);
+        pad_instance_capacity = static_cast<GLsizei>(instances.size());
+    } else {
+        size_t count = static_cast<size_t>(pad_instance_count) + instances.size();
+        if (count > static_cast<size_t>(pad_instance_capacity)) {
+            // Grow by doubling; the instances already uploaded are copied through a staging
+            // buffer, so the vertex array keeps pointing at instance_vbo
+            size_t capacity = std::max(count, static_cast<size_t>(pad_instance_capacity) * 2);
+            GLsizeiptr used_bytes = static_cast<GLsizeiptr>(pad_instance_count) * sizeof(PadInstance);
+            GLuint staging = 0;
+            glGenBuffers(1, &staging);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, staging);
+            glBufferData(GL_COPY_WRITE_BUFFER, used_bytes, nullptr, GL_STREAM_COPY);
+            glCopyBufferSubData(GL_ARRAY_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, used_bytes);
+            glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(PadInstance), nullptr, GL_STATIC_DRAW);
+            glCopyBufferSubData(GL_COPY_WRITE_BUFFER, GL_ARRAY_BUFFER, 0, 0, used_bytes);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            glDeleteBuffers(1, &staging);
+            pad_instance_capacity = static_cast<GLsizei>(capacity);
+        }
+        if (!instances.empty()) {
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(pad_instance_count) * sizeof(PadInstance),
+                            instances.size() * sizeof(PadInstance), instances.data());
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    pad_instance_count += static_cast<GLsizei>(instances.size());
+    
+    if (pad_instance_count > 0) {
+        LOG_INFO("Uploaded " + std::to_string(instances.size()) + " pad instances to the GPU");
+        UpdatePadStyleTexture(append ? from.pins : 0);
+    }
+}
+
+void PCBRenderer::UpdatePadStyleTexture(size_t first_pin) {
+    if (!gpu_pads_ready || !pcb_data) {
+        return;
+    }
+    
+    // Texel 0 is the default slot for shapes without a pin; pin i uses texel i + 1
+    size_t texel_count = pcb_data->pins.size() + 1;
+    int height = static_cast<int>((texel_count + kStyleTextureWidth - 1) / kStyleTextureWidth);
+    
+    glBindTexture(GL_TEXTURE_2D, style_texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (height > style_texture_height || (first_pin == 0 && height != style_texture_height)) {
+        // Appended pins grow the texture by doubling its rows; every texel is written again
+        int rows = first_pin == 0 ? height : std::max(height, style_texture_height * 2);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, kStyleTextureWidth, rows, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        style_texture_height = rows;
+        first_pin = 0;
+    }
+    
+    // Rows from the one holding the first new pin
+    int first_row = static_cast<int>((first_pin + 1) / kStyleTextureWidth);
+    size_t first_texel = static_cast<size_t>(first_row) * kStyleTextureWidth;
+    std::vector<ImU32> texels(static_cast<size_t>(height - first_row) * kStyleTextureWidth, IM_COL32(178, 0, 0, 255));
+    for (size_t pin_idx = first_texel > 0 ? first_texel - 1 : 0;
+         pin_idx < pcb_data->pins.size() && pin_idx < pin_geometry_cache.size(); ++pin_idx) {
+        float r = kPadColor[0], g = kPadColor[1], b = kPadColor[2], a = kPadColor[3];
+        ResolvePadColor(static_cast<int>(pin_idx), r, g, b, a);
+        texels[pin_idx + 1 - first_texel] = IM_COL32((int)(r * 255), (int)(g * 255), (int)(b * 255), (int)(a * 255));
+    }
+    
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first_row, kStyleTextureWidth, height - first_row, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void PCBRenderer::RenderPadsGPU(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    PCB_TRACE_SCOPE("RenderPadsGPU");
+    gpu_frame.zoom = zoom;
+    gpu_frame.offset_x = offset_x;
+    gpu_frame.offset_y = offset_y;
+    gpu_frame.width = window_width;
+    gpu_frame.height = window_height;
+    gpu_frame.viewport_x = gpu_frame.viewport_y = 0;
+    gpu_frame.viewport_width = gpu_frame.viewport_height = 0;
+    if (static_region.active) {
+        // Drawing a cache region: restrict the draw to the region's framebuffer rectangle
+        const ImVec2 scale = ImGui::GetIO().DisplayFramebufferScale;
+        gpu_frame.viewport_x = static_cast<int>(static_region.x * scale.x + 0.5f);
+        gpu_frame.viewport_y = static_cast<int>((static_region.window_height - static_region.y - static_region.height) * scale.y + 0.5f);
+        gpu_frame.viewport_width = static_cast<int>(static_region.width * scale.x + 0.5f);
+        gpu_frame.viewport_height = static_cast<int>(static_region.height * scale.y + 0.5f);
+    }
+    
+    // Issue the instanced draw in draw-list order so outlines and labels layer correctly,
+    // then let the ImGui backend restore its own GL state
+    draw_list->AddCallback(&PCBRenderer::DrawPadInstancesCallback, this);
+    draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+}
+
+void PCBRenderer::DrawPadInstancesCallback(const ImDrawList*, const ImDrawCmd* cmd) {
+    static_cast<PCBRenderer*>(cmd->UserCallbackData)->DrawPadInstances();
+}
+
+void PCBRenderer::DrawPadInstances() {
+    if (!gpu_pads_ready || pad_instance_count == 0 || gpu_frame.width <= 0 || gpu_frame.height <= 0) {
+        return;
+    }
+    
+    glUseProgram(shader_program);
+    glUniform3f(transform_loc, gpu_frame.zoom, gpu_frame.offset_x, gpu_frame.offset_y);
+    glUniform2f(viewport_loc, static_cast<float>(gpu_frame.width), static_cast<float>(gpu_frame.height));
+    glUniform1i(style_loc, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, style_texture);
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+    if (gpu_frame.viewport_width > 0) {
+        glViewport(gpu_frame.viewport_x, gpu_frame.viewport_y, gpu_frame.viewport_width, gpu_frame.viewport_height);
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(gpu_frame.viewport_x, gpu_frame.viewport_y, gpu_frame.viewport_width, gpu_frame.viewport_height);
+    }
+    
+    glBindVertexArray(vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, pad_instance_count);
+    glBindVertexArray(0);
+}
+
+StringRef PCBRenderer::GetSelectedNet() const {
+    if (!pcb_data || selected_pin_index < 0 || selected_pin_index >= (int)pcb_data->pins.size()) {
+        return StringRef();
+    }
+    return pcb_data->pins[selected_pin_index].net;
+}
+
+void PCBRenderer::ResolvePadColor(int pin_index, float& r, float& g, float& b, float& a) const {
+    if (pin_index < 0 || pin_index >= (int)pin_geometry_cache.size()) {
+        return;
+    }
+    const auto& cache = pin_geometry_cache[pin_index];
+    
+    // Net highlighting is not part of the static colour; it is drawn by the selection overlay
+    if (cache.is_nc) {
+        // Use blue color for NC pins
+        r = 0.0f; g = 0.3f; b = 0.3f; a = 1.0f;
+    } else if (cache.is_ground) {
+        // Use grey color for ground pins
+        r = 0.5f; g = 0.5f; b = 0.5f; a = 1.0f;
+    }
+}
+
 // void PCBRenderer::SetProjectionMatrix(int window_width, int window_height) {
 //     camera.aspect_ratio = static_cast<float>(window_width) / window_height;
     
@@ -380,10 +1035,10 @@ GLuint PCBRenderer::CompileShader(const char* source, GLenum type) {
 //     float outline_margin = DeterminePinMargin(part, part_pins, distance);
 // }
 
-float PCBRenderer::DeterminePinMargin(const BRDPart& part, const std::vector<BRDPin>& part_pins, float distance) {
-    int pin_count = part_pins.size();
+float PCBRenderer::DeterminePinMargin(const BRDPart& part, size_t pin_count, float distance) {
       // Enhanced component type detection based on OpenBoardView logic - REDUCED MARGINS
-    if (pin_count < 4 && !part.name.empty() && part.name[0] != 'U' && part.name[0] != 'Q') {
+    std::string_view name = pcb_data->GetString(part.name);
+    if (pin_count < 4 && !name.empty() && name[0] != 'U' && name[0] != 'Q') {
         // 2-3 pin components - likely passives (reduced margins by ~30-40%)
         if (distance > 52 && distance < 57) {
             return 5.0f; // 0603 - reduced from 8.0f
@@ -511,7 +1166,8 @@ float PCBRenderer::DeterminePinSize(const BRDPart& part, const std::vector<BRDPi
         
         float distance = std::sqrt((max_x - min_x) * (max_x - min_x) + (max_y - min_y) * (max_y - min_y));
           // Pin size determination based on OpenBoardView logic
-        if (pin_count < 4 && !part.name.empty() && part.name[0] != 'U' && part.name[0] != 'Q') {
+        std::string_view name = pcb_data->GetString(part.name);
+        if (pin_count < 4 && !name.empty() && name[0] != 'U' && name[0] != 'Q') {
             if (distance > 52 && distance < 57) return 15.0f;  // 0603
             if (distance > 247 && distance < 253) return 50.0f; // SMC diode
             if (distance > 195 && distance < 199) return 50.0f; // Inductor
@@ -588,9 +1244,115 @@ float PCBRenderer::DeterminePinSize(const BRDPart& part, const std::vector<BRDPi
 //     glDrawArrays(GL_TRIANGLE_FAN, 0, static_cast<GLsizei>(vertices.size() / 5));
 // }
 
-void PCBRenderer::RenderOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
+static ScreenTransform MakeScreenTransform(float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    ScreenTransform view;
+    view.zoom = zoom;
+    view.offset_x = offset_x;
+    view.offset_y = offset_y;
+    view.width = static_cast<float>(window_width);
+    view.height = static_cast<float>(window_height);
+    return view;
+}
+
+// Appends segments[order[i]] for i in [begin, end) (all of them in order when `order` is null)
+static void AddSegmentCullElements(const std::vector<std::pair<BRDPoint, BRDPoint>>& segments, const std::vector<uint32_t>* order,
+                                   size_t begin, size_t end, CullElements& elements) {
+    elements.Reserve(elements.Size() + end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        const auto& segment = segments[order ? (*order)[i] : i];
+        // Segment midpoint with half its length as the cull radius
+        float dx = static_cast<float>(segment.second.x - segment.first.x);
+        float dy = static_cast<float>(segment.second.y - segment.first.y);
+        elements.Add(static_cast<float>(segment.first.x + segment.second.x) * 0.5f,
+                     static_cast<float>(segment.first.y + segment.second.y) * 0.5f,
+                     0.5f * std::sqrt(dx * dx + dy * dy));
+    }
+}
+
+void PCBRenderer::BuildCullElements(const BoardCacheCounts& from) {
+    PCB_TRACE_SCOPE("BuildCullElements");
+    if (from.pins == 0) {
+        circle_cull.Clear();
+        rectangle_cull.Clear();
+        oval_cull.Clear();
+        pin_cull.Clear();
+        pin_cull_order.clear();
+        part_outline_cull.Clear();
+        part_outline_order.clear();
+    }
+    if (!pcb_data) return;
+    
+    auto add_pads = [&](const std::vector<BRDPad>& pads, size_t first, CullElements& cull, bool circles) {
+        cull.Reserve(pads.size());
+        for (size_t pad_idx = first; pad_idx < pads.size(); ++pad_idx) {
+            const BRDPad& pad = pads[pad_idx];
+            const BRDPadStack& stack = pcb_data->GetPadStack(pad);
+            cull.Add(static_cast<float>(pad.center.x), static_cast<float>(pad.center.y),
+                     circles ? stack.GetRadius() : std::max(stack.width, stack.height) * 0.5f);
+        }
+    };
+    add_pads(pcb_data->circles, circle_cull.Size(), circle_cull, true);
+    add_pads(pcb_data->rectangles, rectangle_cull.Size(), rectangle_cull, false);
+    add_pads(pcb_data->ovals, oval_cull.Size(), oval_cull, false);
+    
+    // Pads are stored in Z-order by the loader; pins keep their indices, so their cull slots
+    // are laid out in Z-order through a permutation. Appended pads and pins form a Z-ordered
+    // run of their own after the earlier ones.
+    circle_cull.BuildBlocks();
+    rectangle_cull.BuildBlocks();
+    oval_cull.BuildBlocks();
+    
+    size_t first_pin = pin_cull_order.size();
+    std::vector<uint32_t> new_pins = SpatialOrder::MortonOrder(pcb_data->pins.size() - first_pin, [&](size_t i) {
+        return pcb_data->pins[first_pin + i].pos;
+    });
+    pin_cull_order.reserve(pcb_data->pins.size());
+    pin_cull.Reserve(pcb_data->pins.size());
+    for (uint32_t new_pin : new_pins) {
+        uint32_t pin_idx = static_cast<uint32_t>(first_pin) + new_pin;
+        pin_cull_order.push_back(pin_idx);
+        const auto& pin = pcb_data->pins[pin_idx];
+        float radius = 10.0f;
+        if (pin_idx < pin_geometry_cache.size()) {
+            const auto& cache = pin_geometry_cache[pin_idx];
+            if (cache.has_geometry) {
+                radius = std::max(cache.extent_x, cache.extent_y);
+            } else if (cache.radius > 0) {
+                radius = cache.radius;
+            }
+        }
+        pin_cull.Add(static_cast<float>(pin.pos.x), static_cast<float>(pin.pos.y), radius);
+    }
+    pin_cull.BuildBlocks();
+    
+    // The board outline is never appended to and is small
+    outline_cull.Clear();
+    AddSegmentCullElements(pcb_data->outline_segments, nullptr, 0, pcb_data->outline_segments.size(), outline_cull);
+    
+    // Part outlines longest first, so large parts appear first when the frame budget splits the
+    // layer (appended outlines are ordered among themselves, after the earlier ones)
+    const auto& part_segments = pcb_data->part_outline_segments;
+    size_t first_segment = part_outline_order.size();
+    std::vector<float> part_segment_length(part_segments.size() - first_segment);
+    part_outline_order.resize(part_segments.size());
+    for (size_t i = first_segment; i < part_segments.size(); ++i) {
+        float dx = static_cast<float>(part_segments[i].second.x - part_segments[i].first.x);
+        float dy = static_cast<float>(part_segments[i].second.y - part_segments[i].first.y);
+        part_segment_length[i - first_segment] = dx * dx + dy * dy;
+        part_outline_order[i] = static_cast<uint32_t>(i);
+    }
+    std::stable_sort(part_outline_order.begin() + first_segment, part_outline_order.end(), [&](uint32_t a, uint32_t b) {
+        return part_segment_length[a - first_segment] > part_segment_length[b - first_segment];
+    });
+    AddSegmentCullElements(part_segments, &part_outline_order, first_segment, part_segments.size(), part_outline_cull);
+    
+    LOG_INFO(std::string("Visibility culling uses the ") + CullKernel::ActiveKernelName() + " kernel");
+}
+
+void PCBRenderer::RenderOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                                     size_t begin, size_t end) {
+    PCB_TRACE_SCOPE("RenderOutline");
     if (!pcb_data || pcb_data->outline_segments.empty()) {
-        LOG_INFO("No outline segments to render");
         return;
     }    // Render board outline
     
@@ -600,7 +1362,13 @@ void PCBRenderer::RenderOutlineImGui(ImDrawList* draw_list, float zoom, float of
     // Adaptive line thickness based on zoom level
     float line_thickness = std::max(1.0f, std::min(4.0f, zoom * 2.0f));  // Thicker when zoomed in
     
-    for (const auto& segment : pcb_data->outline_segments) {
+    // Only segments that can touch the viewport
+    CullKernel::TransformAndCull(outline_cull, begin, std::min(end, outline_cull.Size()),
+                                 MakeScreenTransform(zoom, offset_x, offset_y, window_width, window_height), visible_outline);
+    
+    for (size_t k = 0; k < visible_outline.count; ++k) {
+        const auto& segment = pcb_data->outline_segments[visible_outline.index[k]];
+        
         // Transform coordinates from PCB space to screen space with Y-axis mirroring
         ImVec2 p1(segment.first.x * zoom + offset_x, offset_y - segment.first.y * zoom);
         ImVec2 p2(segment.second.x * zoom + offset_x, offset_y - segment.second.y * zoom);
@@ -612,7 +1380,9 @@ void PCBRenderer::RenderOutlineImGui(ImDrawList* draw_list, float zoom, float of
     // Outline rendering complete
 }
 
-void PCBRenderer::RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
+void PCBRenderer::RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                                         size_t begin, size_t end) {
+    PCB_TRACE_SCOPE("RenderPartOutline");
     if (!pcb_data || pcb_data->part_outline_segments.empty()) {
         return;
     }
@@ -630,7 +1400,14 @@ void PCBRenderer::RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, floa
     // Adaptive line thickness based on zoom level (slightly thinner than board outline)
     float line_thickness = std::max(0.5f, std::min(2.0f, zoom * 1.5f));
     
-    for (const auto& segment : pcb_data->part_outline_segments) {
+    // Only segments that can touch the viewport
+    CullKernel::TransformAndCull(part_outline_cull, begin, std::min(end, part_outline_cull.Size()),
+                                 MakeScreenTransform(zoom, offset_x, offset_y, window_width, window_height), visible_part_outline);
+    
+    for (size_t k = 0; k < visible_part_outline.count; ++k) {
+        // Cull slots are ordered longest segment first; map back to the segment
+        const auto& segment = pcb_data->part_outline_segments[part_outline_order[visible_part_outline.index[k]]];
+        
         // Transform coordinates from PCB space to screen space with Y-axis mirroring
         ImVec2 p1(segment.first.x * zoom + offset_x, offset_y - segment.first.y * zoom);
         ImVec2 p2(segment.second.x * zoom + offset_x, offset_y - segment.second.y * zoom);
@@ -642,540 +1419,567 @@ void PCBRenderer::RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, floa
     // Part outline rendering complete
 }
 
-void PCBRenderer::RenderPartHighlighting(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
-    // Render part highlighting on top of everything
-    if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pins.size()) {
-        std::string selected_net = pcb_data->pins[selected_pin_index].net;
-        
-        if (!selected_net.empty() && selected_net != "UNCONNECTED") {
-            // Find all parts that have pins on the selected net
-            std::set<unsigned int> parts_to_highlight;
-            for (const auto& pin : pcb_data->pins) {
-                if (pin.net == selected_net && pin.part > 0) {
-                    parts_to_highlight.insert(pin.part);
-                }
-            }
-            
-            // Highlight each part that has pins on the selected net
-            for (unsigned int highlighted_part : parts_to_highlight) {
-                // Collect all pins belonging to this part with their geometry info
-                struct PinGeometryInfo {
-                    BRDPoint pos;
-                    float extent_left, extent_right, extent_bottom, extent_top;
-                };
-                std::vector<PinGeometryInfo> part_pins_info;
-                
-                for (const auto& pin : pcb_data->pins) {
-                    if (pin.part == highlighted_part) {
-                        PinGeometryInfo info;
-                        info.pos = pin.pos;
-                        
-                        // Default extents (symmetric for circles)
-                        float default_extent = 5.0f;
-                        info.extent_left = info.extent_right = info.extent_bottom = info.extent_top = default_extent;
-                        
-                        // Check if this pin has a circle
-                        bool found_geometry = false;
-                        for (const auto& circle : pcb_data->circles) {
-                            if (circle.center.x == pin.pos.x && circle.center.y == pin.pos.y) {
-                                float radius = std::max(default_extent, circle.radius);
-                                info.extent_left = info.extent_right = info.extent_bottom = info.extent_top = radius;
-                                found_geometry = true;
-                                break;
-                            }
-                        }
-                        
-                        // Check if this pin has a rectangle
-                        if (!found_geometry) {
-                            for (const auto& rectangle : pcb_data->rectangles) {
-                                if (rectangle.center.x == pin.pos.x && rectangle.center.y == pin.pos.y) {
-                                    // For rectangles, calculate extents considering rotation
-                                    float half_width = rectangle.width / 2.0f;
-                                    float half_height = rectangle.height / 2.0f;
-                                    
-                                    if (rectangle.rotation == 0.0f) {
-                                        // No rotation - simple case
-                                        info.extent_left = info.extent_right = half_width;
-                                        info.extent_bottom = info.extent_top = half_height;
-                                    } else {
-                                        // With rotation, calculate the maximum extent in each direction
-                                        float rot_rad = rectangle.rotation * 3.14159265f / 180.0f;
-                                        float cos_rot = std::abs(std::cos(rot_rad));
-                                        float sin_rot = std::abs(std::sin(rot_rad));
-                                        
-                                        float extent_x = half_width * cos_rot + half_height * sin_rot;
-                                        float extent_y = half_width * sin_rot + half_height * cos_rot;
-                                        
-                                        info.extent_left = info.extent_right = extent_x;
-                                        info.extent_bottom = info.extent_top = extent_y;
-                                    }
-                                    found_geometry = true;
-                                    break;
-                                }
-                            }
-                        }
-                        
-                        // Check if this pin has an oval
-                        if (!found_geometry) {
-                            for (const auto& oval : pcb_data->ovals) {
-                                if (oval.center.x == pin.pos.x && oval.center.y == pin.pos.y) {
-                                    // For ovals, calculate extents considering rotation
-                                    float half_width = oval.width / 2.0f;
-                                    float half_height = oval.height / 2.0f;
-                                    
-                                    if (oval.rotation == 0.0f) {
-                                        // No rotation - simple case
-                                        info.extent_left = info.extent_right = half_width;
-                                        info.extent_bottom = info.extent_top = half_height;
-                                    } else {
-                                        // With rotation, calculate the maximum extent in each direction
-                                        float rot_rad = oval.rotation * 3.14159265f / 180.0f;
-                                        float cos_rot = std::abs(std::cos(rot_rad));
-                                        float sin_rot = std::abs(std::sin(rot_rad));
-                                        
-                                        float extent_x = half_width * cos_rot + half_height * sin_rot;
-                                        float extent_y = half_width * sin_rot + half_height * cos_rot;
-                                        
-                                        info.extent_left = info.extent_right = extent_x;
-                                        info.extent_bottom = info.extent_top = extent_y;
-                                    }
-                                    found_geometry = true;
-                                    break;
-                                }
-                            }
-                        }
-                        
-                        part_pins_info.push_back(info);
-                    }
-                }
-                
-                if (part_pins_info.size() >= 1) {
-                    // Calculate initial bounding box of the part's pins
-                    float min_x = part_pins_info[0].pos.x, max_x = part_pins_info[0].pos.x;
-                    float min_y = part_pins_info[0].pos.y, max_y = part_pins_info[0].pos.y;
-                    
-                    for (const auto& info : part_pins_info) {
-                        min_x = std::min(min_x, static_cast<float>(info.pos.x));
-                        max_x = std::max(max_x, static_cast<float>(info.pos.x));
-                        min_y = std::min(min_y, static_cast<float>(info.pos.y));
-                        max_y = std::max(max_y, static_cast<float>(info.pos.y));
-                    }
-                    
-                    // Calculate directional margins based on boundary pins with proper geometry
-                    float left_margin = 0.0f, right_margin = 0.0f;
-                    float bottom_margin = 0.0f, top_margin = 0.0f;
-                    
-                    for (const auto& info : part_pins_info) {
-                        // Check if this pin affects the left boundary
-                        if (info.pos.x == min_x) {
-                            left_margin = std::max(left_margin, info.extent_left);
-                        }
-                        // Check if this pin affects the right boundary
-                        if (info.pos.x == max_x) {
-                            right_margin = std::max(right_margin, info.extent_right);
-                        }
-                        // Check if this pin affects the bottom boundary
-                        if (info.pos.y == min_y) {
-                            bottom_margin = std::max(bottom_margin, info.extent_bottom);
-                        }
-                        // Check if this pin affects the top boundary
-                        if (info.pos.y == max_y) {
-                            top_margin = std::max(top_margin, info.extent_top);
-                        }
-                    }
-                    
-                    // Apply directional margins
-                    min_x -= left_margin;
-                    max_x += right_margin;
-                    min_y -= bottom_margin;
-                    max_y += top_margin;
-                    
-                    // Transform to screen coordinates
-                    ImVec2 top_left(min_x * zoom + offset_x, offset_y - max_y * zoom);
-                    ImVec2 bottom_right(max_x * zoom + offset_x, offset_y - min_y * zoom);
-                    
-                    // Draw highlighted bounding box around the part
-                    ImU32 highlight_color = IM_COL32(255, 255, 179, 128); // Semi-transparent yellow
-                    ImU32 highlight_border = IM_COL32(255, 255, 0, 200);  // More opaque yellow border
-                    
-                    // Draw filled rectangle
-                    draw_list->AddRectFilled(top_left, bottom_right, highlight_color);
-                    // Draw border
-                    draw_list->AddRect(top_left, bottom_right, highlight_border, 0.0f, 0, 2.0f);
-                }
+void PCBRenderer::UpdateSelectionOverlay() {
+    PCB_TRACE_SCOPE("UpdateSelectionOverlay");
+    if (overlay_selection == selected_pin_index) {
+        return;
+    }
+    overlay_selection = selected_pin_index;
+    highlighted_pins.clear();
+    highlight_boxes.clear();
+    
+    StringRef selected_net = GetSelectedNet();
+    if (selected_net.empty()) {
+        return;
+    }
+    
+    // Pins on the selected net and the parts they belong to; one scan per selection change
+    std::set<unsigned int> parts_to_highlight;
+    for (size_t i = 0; i < pcb_data->pins.size(); ++i) {
+        const auto& pin = pcb_data->pins[i];
+        if (pin.net == selected_net) {
+            highlighted_pins.push_back(static_cast<int>(i));
+            if (pin.part > 0) {
+                parts_to_highlight.insert(pin.part);
             }
         }
     }
-}
-
-void PCBRenderer::RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
-    if (!pcb_data || pcb_data->circles.empty() || pin_geometry_cache.empty()) {
+    if (pcb_data->GetString(selected_net) == "UNCONNECTED" || parts_to_highlight.empty()) {
         return;
     }
     
-    // Pre-calculate selected net for highlighting (avoid string operations in loop)
-    std::string selected_net;
-    if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pins.size()) {
-        selected_net = pcb_data->pins[selected_pin_index].net;
+    // Collect the pins of every highlighted part with their extents from the geometry cache
+    struct PinGeometryInfo {
+        float x, y;
+        float extent_x, extent_y;
+    };
+    std::vector<std::vector<PinGeometryInfo>> part_pins_info(parts_to_highlight.size());
+    std::vector<int> part_slot(*parts_to_highlight.rbegin() + 1, -1);
+    int slot = 0;
+    for (unsigned int part : parts_to_highlight) {
+        part_slot[part] = slot++;
     }
     
-    // Render all circles with optimized visibility culling
-    for (size_t circle_idx = 0; circle_idx < pcb_data->circles.size(); ++circle_idx) {
-        const auto& circle = pcb_data->circles[circle_idx];
-        
-        // Early visibility culling - skip if circle is outside visible area
-        if (!IsElementVisible(circle.center.x, circle.center.y, circle.radius, zoom, offset_x, offset_y, window_width, window_height)) {
+    for (size_t i = 0; i < pcb_data->pins.size(); ++i) {
+        const auto& pin = pcb_data->pins[i];
+        if (pin.part >= part_slot.size() || part_slot[pin.part] < 0) {
             continue;
         }
         
-        // Transform circle center coordinates to screen space with Y-axis mirroring
-        float x = circle.center.x * zoom + offset_x;
-        float y = offset_y - circle.center.y * zoom;  // Mirror Y-axis
+        // Default extents (symmetric for circles)
+        const float default_extent = 5.0f;
+        PinGeometryInfo info = { static_cast<float>(pin.pos.x), static_cast<float>(pin.pos.y), default_extent, default_extent };
+        if (i < pin_geometry_cache.size()) {
+            const auto& cache = pin_geometry_cache[i];
+            if (cache.circle_index != SIZE_MAX) {
+                info.extent_x = info.extent_y = std::max(default_extent, cache.radius);
+            } else if (cache.rectangle_index != SIZE_MAX || cache.oval_index != SIZE_MAX) {
+                info.extent_x = cache.extent_x;
+                info.extent_y = cache.extent_y;
+            }
+        }
+        part_pins_info[part_slot[pin.part]].push_back(info);
+    }
+    
+    for (const auto& pins_info : part_pins_info) {
+        if (pins_info.empty()) {
+            continue;
+        }
         
-        // Scale radius by zoom factor
-        float radius = circle.radius * zoom;
+        // Calculate initial bounding box of the part's pins
+        float min_x = pins_info[0].x, max_x = pins_info[0].x;
+        float min_y = pins_info[0].y, max_y = pins_info[0].y;
+        for (const auto& info : pins_info) {
+            min_x = std::min(min_x, info.x);
+            max_x = std::max(max_x, info.x);
+            min_y = std::min(min_y, info.y);
+            max_y = std::max(max_y, info.y);
+        }
         
-        // Ensure minimum visibility
-        if (radius < 1.0f) radius = 1.0f;
+        // Directional margins from the pads on each boundary
+        float left_margin = 0.0f, right_margin = 0.0f;
+        float bottom_margin = 0.0f, top_margin = 0.0f;
+        for (const auto& info : pins_info) {
+            if (info.x == min_x) left_margin = std::max(left_margin, info.extent_x);
+            if (info.x == max_x) right_margin = std::max(right_margin, info.extent_x);
+            if (info.y == min_y) bottom_margin = std::max(bottom_margin, info.extent_y);
+            if (info.y == max_y) top_margin = std::max(top_margin, info.extent_y);
+        }
         
-        // Check if this circle corresponds to a pin with cached data for color override
-        float r = circle.r, g = circle.g, b = circle.b, a = circle.a;
+        highlight_boxes.push_back({ min_x - left_margin, min_y - bottom_margin, max_x + right_margin, max_y + top_margin });
+    }
+}
+
+void PCBRenderer::RenderPartHighlighting(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
+    PCB_TRACE_SCOPE("RenderPartHighlighting");
+    // Boxes are computed once per selection in UpdateSelectionOverlay
+    ImU32 highlight_color = IM_COL32(255, 255, 179, 128); // Semi-transparent yellow
+    ImU32 highlight_border = IM_COL32(255, 255, 0, 200);  // More opaque yellow border
+    for (const auto& box : highlight_boxes) {
+        // Transform to screen coordinates
+        ImVec2 top_left(box.min_x * zoom + offset_x, offset_y - box.max_y * zoom);
+        ImVec2 bottom_right(box.max_x * zoom + offset_x, offset_y - box.min_y * zoom);
         
-        // Find pin that matches this circle using cache (much faster than linear search)
-        for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size() && pin_idx < pin_geometry_cache.size(); ++pin_idx) {
-            const auto& pin = pcb_data->pins[pin_idx];
-            const auto& cache = pin_geometry_cache[pin_idx];
+        draw_list->AddRectFilled(top_left, bottom_right, highlight_color);
+        draw_list->AddRect(top_left, bottom_right, highlight_border, 0.0f, 0, 2.0f);
+    }
+}
+
+// Unit-shape templates for the CPU pad passes. Built once; a pad is emitted by scaling,
+// rotating and translating its template, so the per-frame loop needs no trigonometry.
+// A template vertex is: segment_sign * (half_length, 0) + unit * (half_size + inset)
+struct PadTemplateVertex {
+    float unit_x, unit_y;
+    float segment_sign;  // -1/+1 for the two stadium caps, 0 otherwise
+};
+
+struct PadTemplateRange {
+    int first = 0;
+    int count = 0;
+};
+
+static const int kPadTemplateLevels = 6;
+static const int kCircleTemplateSegments[kPadTemplateLevels] = { 8, 12, 16, 24, 32, 48 };
+static const int kStadiumCapSegments[kPadTemplateLevels] = { 4, 6, 8, 12, 16, 24 };
+static const float kPadTemplateMaxRadius[kPadTemplateLevels - 1] = { 3.0f, 6.0f, 12.0f, 24.0f, 48.0f };
+static const int kPadTemplateMaxPoints = 2 * (24 + 1);
+
+struct PadTemplateSet {
+    std::vector<PadTemplateVertex> vertices;
+    PadTemplateRange circle[kPadTemplateLevels];
+    PadTemplateRange stadium[kPadTemplateLevels];  // Horizontal stadium; vertical ones are rotated by 90 degrees
+    PadTemplateRange rectangle;
+};
+
+static const PadTemplateSet& GetPadTemplates() {
+    static const PadTemplateSet templates = [] {
+        PadTemplateSet set;
+        const float pi = 3.14159265f;
+        for (int level = 0; level < kPadTemplateLevels; ++level) {
+            set.circle[level].first = static_cast<int>(set.vertices.size());
+            int segments = kCircleTemplateSegments[level];
+            for (int i = 0; i < segments; ++i) {
+                float angle = 2.0f * pi * i / segments;
+                set.vertices.push_back({ std::cos(angle), std::sin(angle), 0.0f });
+            }
+            set.circle[level].count = segments;
             
-            // Quick check using cached geometry index
-            if (cache.circle_index == circle_idx) {
-                // Use cached pin type checks
-                if (!selected_net.empty() && pin.net == selected_net) {
-                    // Highlight all pins on the same net
-                    r = 1.0f; g = 1.0f; b = 0.7f; a = 1.0f;
-                } else if (cache.is_nc) {
-                    // Use blue color for NC pins
-                    r = 0.0f; g = 0.3f; b = 0.3f; a = 1.0f;
-                } else if (cache.is_ground) {
-                    // Use grey color for ground pins
-                    r = 0.5f; g = 0.5f; b = 0.5f; a = 1.0f;
+            // Left cap from pi/2 to 3pi/2, then right cap from 3pi/2 to 5pi/2
+            set.stadium[level].first = static_cast<int>(set.vertices.size());
+            int cap_segments = kStadiumCapSegments[level];
+            for (int cap = 0; cap < 2; ++cap) {
+                float start = cap == 0 ? pi * 0.5f : pi * 1.5f;
+                for (int i = 0; i <= cap_segments; ++i) {
+                    float angle = start + pi * i / cap_segments;
+                    set.vertices.push_back({ std::cos(angle), std::sin(angle), cap == 0 ? -1.0f : 1.0f });
                 }
-                break;
             }
+            set.stadium[level].count = 2 * (cap_segments + 1);
         }
-        
-        // Convert color components to ImU32 format (0-255 range)
-        ImU32 fill_color = IM_COL32(
-            (int)(r * 255), 
-            (int)(g * 255), 
-            (int)(b * 255), 
-            (int)(a * 255)
-        );
-        
-        // Draw filled circle
-        draw_list->AddCircleFilled(ImVec2(x, y), radius, fill_color);
-        
-        // Optional: Add a darker outline for better visibility
-        ImU32 outline_color = IM_COL32(
-            (int)(r * 180), 
-            (int)(g * 180), 
-            (int)(b * 180), 
-            255
-        );
-        draw_list->AddCircle(ImVec2(x, y), radius, outline_color, 0, 1.0f);
-    }
+        set.rectangle.first = static_cast<int>(set.vertices.size());
+        set.vertices.push_back({ -1.0f, -1.0f, 0.0f });
+        set.vertices.push_back({  1.0f, -1.0f, 0.0f });
+        set.vertices.push_back({  1.0f,  1.0f, 0.0f });
+        set.vertices.push_back({ -1.0f,  1.0f, 0.0f });
+        set.rectangle.count = 4;
+        return set;
+    }();
+    return templates;
 }
 
-void PCBRenderer::RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
-    if (!pcb_data || pcb_data->rectangles.empty() || pin_geometry_cache.empty()) {
-        return;
+// Tessellation level for a curve of the given on-screen radius
+static int SelectPadTemplateLevel(float radius_px) {
+    int level = 0;
+    while (level < kPadTemplateLevels - 1 && radius_px > kPadTemplateMaxRadius[level]) {
+        ++level;
     }
-    
-    // Pre-calculate selected net for highlighting (avoid string operations in loop)
-    std::string selected_net;
-    if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pins.size()) {
-        selected_net = pcb_data->pins[selected_pin_index].net;
+    return level;
+}
+
+// Writes pads into a PadGeometryChunk: vertices and indices laid out in runs that each fit
+// 16-bit indices, ready to be spliced into the window draw list with one PrimReserve per run.
+// Each pad is a fill fan plus a one pixel outline ring, so it needs 3N vertices and 9N-6 indices.
+class PadBatchWriter {
+public:
+    PadBatchWriter(PadGeometryChunk& chunk, ImVec2 uv) : chunk(chunk), uv(uv) {
+        chunk.vertices.clear();
+        chunk.indices.clear();
+        chunk.run_ends.clear();
     }
+    ~PadBatchWriter() { CloseRun(); }
     
-    // Render all rectangles with optimized visibility culling
-    for (size_t rect_idx = 0; rect_idx < pcb_data->rectangles.size(); ++rect_idx) {
-        const auto& rectangle = pcb_data->rectangles[rect_idx];
-        
-        // Early visibility culling using approximate radius
-        float approx_radius = std::max(rectangle.width, rectangle.height) * 0.5f;
-        if (!IsElementVisible(rectangle.center.x, rectangle.center.y, approx_radius, zoom, offset_x, offset_y, window_width, window_height)) {
-            continue;
+    void Emit(const PadTemplateRange& shape, float center_x, float center_y, float half_x, float half_y,
+              float half_length, float cos_rot, float sin_rot, ImU32 fill_color, ImU32 outline_color) {
+        const int n = shape.count;
+        if (chunk.vertices.size() - run_vertex_start + 3 * n > kMaxRunVertices) {
+            CloseRun();
         }
         
-        // Transform rectangle center coordinates to screen space with Y-axis mirroring
-        float center_x = rectangle.center.x * zoom + offset_x;
-        float center_y = offset_y - rectangle.center.y * zoom;  // Mirror Y-axis
+        const PadTemplateVertex* vertices = &GetPadTemplates().vertices[shape.first];
+        const ImDrawIdx base = static_cast<ImDrawIdx>(chunk.vertices.size() - run_vertex_start);
         
-        // Scale dimensions by zoom factor
-        float width = rectangle.width * zoom;
-        float height = rectangle.height * zoom;
+        // Fill vertices (inset half a pixel), then the outline ring's inner and outer edges
+        WriteRing(vertices, n, center_x, center_y, half_x - 0.5f, half_y - 0.5f, half_length, cos_rot, sin_rot, fill_color);
+        WriteRing(vertices, n, center_x, center_y, half_x - 0.5f, half_y - 0.5f, half_length, cos_rot, sin_rot, outline_color);
+        WriteRing(vertices, n, center_x, center_y, half_x + 0.5f, half_y + 0.5f, half_length, cos_rot, sin_rot, outline_color);
         
-        // Ensure minimum visibility
-        if (width < 2.0f) width = 2.0f;
-        if (height < 2.0f) height = 2.0f;
-        
-        // Check if this rectangle corresponds to a pin with cached data for color override
-        float r = rectangle.r, g = rectangle.g, b = rectangle.b, a = rectangle.a;
-        
-        // Find pin that matches this rectangle using cache (much faster than linear search)
-        for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size() && pin_idx < pin_geometry_cache.size(); ++pin_idx) {
-            const auto& pin = pcb_data->pins[pin_idx];
-            const auto& cache = pin_geometry_cache[pin_idx];
-            
-            // Quick check using cached geometry index
-            if (cache.rectangle_index == rect_idx) {
-                // Use cached pin type checks
-                if (!selected_net.empty() && pin.net == selected_net) {
-                    // Highlight all pins on the same net
-                    r = 1.0f; g = 1.0f; b = 0.7f; a = 1.0f;
-                } else if (cache.is_nc) {
-                    // Use blue color for NC pins
-                    r = 0.0f; g = 0.3f; b = 0.3f; a = 1.0f;
-                } else if (cache.is_ground) {
-                    // Use grey color for ground pins
-                    r = 0.5f; g = 0.5f; b = 0.5f; a = 1.0f;
-                }
-                break;
-            }
+        auto& indices = chunk.indices;
+        for (int i = 1; i < n - 1; ++i) {
+            indices.push_back(base);
+            indices.push_back(static_cast<ImDrawIdx>(base + i));
+            indices.push_back(static_cast<ImDrawIdx>(base + i + 1));
         }
+        const ImDrawIdx inner = static_cast<ImDrawIdx>(base + n);
+        const ImDrawIdx outer = static_cast<ImDrawIdx>(base + 2 * n);
+        for (int i = 0; i < n; ++i) {
+            int j = (i + 1 == n) ? 0 : i + 1;
+            indices.push_back(static_cast<ImDrawIdx>(inner + i));
+            indices.push_back(static_cast<ImDrawIdx>(outer + i));
+            indices.push_back(static_cast<ImDrawIdx>(outer + j));
+            indices.push_back(static_cast<ImDrawIdx>(inner + i));
+            indices.push_back(static_cast<ImDrawIdx>(outer + j));
+            indices.push_back(static_cast<ImDrawIdx>(inner + j));
+        }
+    }
+    
+private:
+    static const size_t kMaxRunVertices = 65535;
+    
+    void CloseRun() {
+        if (chunk.vertices.size() > run_vertex_start) {
+            chunk.run_ends.push_back({ static_cast<unsigned int>(chunk.vertices.size()), static_cast<unsigned int>(chunk.indices.size()) });
+            run_vertex_start = chunk.vertices.size();
+        }
+    }
+    
+    void WriteRing(const PadTemplateVertex* vertices, int n, float center_x, float center_y, float half_x, float half_y,
+                   float half_length, float cos_rot, float sin_rot, ImU32 color) {
+        for (int i = 0; i < n; ++i) {
+            float local_x = vertices[i].segment_sign * half_length + vertices[i].unit_x * half_x;
+            float local_y = vertices[i].unit_y * half_y;
+            ImDrawVert vertex;
+            vertex.pos = ImVec2(center_x + local_x * cos_rot - local_y * sin_rot, center_y + local_x * sin_rot + local_y * cos_rot);
+            vertex.uv = uv;
+            vertex.col = color;
+            chunk.vertices.push_back(vertex);
+        }
+    }
+    
+    PadGeometryChunk& chunk;
+    ImVec2 uv;
+    size_t run_vertex_start = 0;
+};
+
+// Appends a chunk to the draw list: one PrimReserve + copy per run, indices rebased on the fly
+static void SplicePadChunk(ImDrawList* draw_list, const PadGeometryChunk& chunk) {
+    unsigned int vertex_begin = 0, index_begin = 0;
+    for (const auto& run : chunk.run_ends) {
+        int vertex_count = static_cast<int>(run.first - vertex_begin);
+        int index_count = static_cast<int>(run.second - index_begin);
+        
+        draw_list->PrimReserve(index_count, vertex_count);
+        std::memcpy(draw_list->_VtxWritePtr, chunk.vertices.data() + vertex_begin, vertex_count * sizeof(ImDrawVert));
+        const ImDrawIdx base = static_cast<ImDrawIdx>(draw_list->_VtxCurrentIdx);
+        const ImDrawIdx* source = chunk.indices.data() + index_begin;
+        for (int i = 0; i < index_count; ++i) {
+            draw_list->_IdxWritePtr[i] = static_cast<ImDrawIdx>(base + source[i]);
+        }
+        draw_list->_VtxWritePtr += vertex_count;
+        draw_list->_IdxWritePtr += index_count;
+        draw_list->_VtxCurrentIdx += vertex_count;
         
-        // Convert color components to ImU32 format (0-255 range)
-        ImU32 fill_color = IM_COL32(
-            (int)(r * 255), 
-            (int)(g * 255), 
-            (int)(b * 255), 
-            (int)(a * 255)
-        );
-        
-        if (rectangle.rotation == 0.0f) {
-            // No rotation - simple axis-aligned rectangle
-            float half_width = width / 2.0f;
-            float half_height = height / 2.0f;
+        vertex_begin = run.first;
+        index_begin = run.second;
+    }
+}
+
+// Boards smaller than this per thread are not worth splitting
+static const size_t kMinShapesPerChunk = 2048;
+
+template <typename EmitFn>
+void PCBRenderer::BuildPadGeometry(ImDrawList* draw_list, const CullElements& elements, size_t begin, size_t end,
+                                   const ScreenTransform& view, EmitFn&& emit) {
+    end = std::min(end, elements.Size());
+    if (begin >= end) {
+        return;
+    }
+    size_t element_count = end - begin;
+    
+    // Contiguous slices of the shape list: each is culled and tessellated by one thread
+    size_t threads = render_pool ? render_pool->GetConcurrency() : 1;
+    size_t chunk_count = std::max<size_t>(1, std::min(threads, (element_count + kMinShapesPerChunk - 1) / kMinShapesPerChunk));
+    if (pad_chunks.size() < chunk_count) {
+        pad_chunks.resize(chunk_count);
+    }
+    
+    const ImVec2 uv = ImGui::GetFontTexUvWhitePixel();
+    auto build_chunk = [&](size_t chunk_index) {
+        PCB_TRACE_SCOPE("pad chunk");
+        PadGeometryChunk& chunk = pad_chunks[chunk_index];
+        size_t chunk_begin = begin + element_count * chunk_index / chunk_count;
+        size_t chunk_end = begin + element_count * (chunk_index + 1) / chunk_count;
+        CullKernel::TransformAndCull(elements, chunk_begin, chunk_end, view, chunk.visible);
+        PadBatchWriter writer(chunk, uv);
+        emit(writer, chunk.visible);
+    };
+    
+    if (render_pool && chunk_count > 1) {
+        render_pool->ParallelFor(chunk_count, build_chunk);
+    } else {
+        build_chunk(0);
+    }
+    
+    // Splice in slice order so the output matches a single-threaded build exactly
+    for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        SplicePadChunk(draw_list, pad_chunks[chunk_index]);
+    }
+}
+
+void PCBRenderer::RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                                        size_t begin, size_t end) {
+    PCB_TRACE_SCOPE("RenderCirclePins");
+    if (!pcb_data || pcb_data->circles.empty() || pin_geometry_cache.empty()) {
+        return;
+    }
+    
+    const PadTemplateSet& templates = GetPadTemplates();
+    
+    // Slices of the shape list are culled and tessellated in parallel, then spliced in order
+    const ScreenTransform view = MakeScreenTransform(zoom, offset_x, offset_y, window_width, window_height);
+    BuildPadGeometry(draw_list, circle_cull, begin, end, view, [&](PadBatchWriter& writer, const VisibleSet& visible) {
+        for (size_t k = 0; k < visible.count; ++k) {
+            const size_t circle_idx = visible.index[k];
+            const auto& circle = pcb_data->circles[circle_idx];
             
-            ImVec2 top_left(center_x - half_width, center_y - half_height);
-            ImVec2 bottom_right(center_x + half_width, center_y + half_height);
+            // Screen-space centre (Y mirrored) comes from the kernel
+            float x = visible.screen_x[k];
+            float y = visible.screen_y[k];
             
-            draw_list->AddRectFilled(top_left, bottom_right, fill_color);
+            // Scale radius by zoom factor
+            float radius = pcb_data->GetPadStack(circle).GetRadius() * zoom;
             
-            // Optional: Add outline for better visibility
-            ImU32 outline_color = IM_COL32(
-                (int)(r * 180), 
-                (int)(g * 180), 
-                (int)(b * 180), 
-                255
-            );
-            draw_list->AddRect(top_left, bottom_right, outline_color, 0.0f, 0, 1.0f);
-        } else {
-            // Rotated rectangle - draw as quad with rotation
-            float half_width = width / 2.0f;
-            float half_height = height / 2.0f;
+            // Ensure minimum visibility
+            if (radius < 1.0f) radius = 1.0f;
+            
+            // Colour override from the owning pin's cached data
+            float r = kPadColor[0], g = kPadColor[1], b = kPadColor[2], a = kPadColor[3];
+            ResolvePadColor(static_cast<int>(circle.pin), r, g, b, a);
+            
+            ImU32 fill_color = IM_COL32((int)(r * 255), (int)(g * 255), (int)(b * 255), (int)(a * 255));
+            ImU32 outline_color = IM_COL32((int)(r * 180), (int)(g * 180), (int)(b * 180), 255);
+            
+            writer.Emit(templates.circle[SelectPadTemplateLevel(radius)], x, y, radius, radius, 0.0f, 1.0f, 0.0f,
+                        fill_color, outline_color);
+        }
+    });
+}
+
+void PCBRenderer::RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                                           size_t begin, size_t end) {
+    PCB_TRACE_SCOPE("RenderRectanglePins");
+    if (!pcb_data || pcb_data->rectangles.empty() || pin_geometry_cache.empty()) {
+        return;
+    }
+    
+    const PadTemplateSet& templates = GetPadTemplates();
+    
+    // Slices of the shape list are culled and tessellated in parallel, then spliced in order
+    const ScreenTransform view = MakeScreenTransform(zoom, offset_x, offset_y, window_width, window_height);
+    BuildPadGeometry(draw_list, rectangle_cull, begin, end, view, [&](PadBatchWriter& writer, const VisibleSet& visible) {
+        for (size_t k = 0; k < visible.count; ++k) {
+            const size_t rect_idx = visible.index[k];
+            const auto& rectangle = pcb_data->rectangles[rect_idx];
+            const BRDPadStack& stack = pcb_data->GetPadStack(rectangle);
             
-            // Convert rotation to radians
-            float rot_rad = rectangle.rotation * 3.14159265f / 180.0f;
-            float cos_rot = std::cos(rot_rad);
-            float sin_rot = std::sin(rot_rad);
+            // Screen-space centre (Y mirrored) comes from the kernel
+            float center_x = visible.screen_x[k];
+            float center_y = visible.screen_y[k];
             
-            // Calculate the four corners of the rotated rectangle
-            ImVec2 corners[4];
+            // Scale dimensions by zoom factor
+            float width = stack.width * zoom;
+            float height = stack.height * zoom;
             
-            // Corner offsets before rotation
-            float dx1 = -half_width, dy1 = -half_height; // Top-left
-            float dx2 = half_width,  dy2 = -half_height; // Top-right
-            float dx3 = half_width,  dy3 = half_height;  // Bottom-right
-            float dx4 = -half_width, dy4 = half_height;  // Bottom-left
+            // Ensure minimum visibility
+            if (width < 2.0f) width = 2.0f;
+            if (height < 2.0f) height = 2.0f;
             
-            // Apply rotation and translation
-            corners[0] = ImVec2(center_x + dx1 * cos_rot - dy1 * sin_rot, center_y + dx1 * sin_rot + dy1 * cos_rot);
-            corners[1] = ImVec2(center_x + dx2 * cos_rot - dy2 * sin_rot, center_y + dx2 * sin_rot + dy2 * cos_rot);
-            corners[2] = ImVec2(center_x + dx3 * cos_rot - dy3 * sin_rot, center_y + dx3 * sin_rot + dy3 * cos_rot);
-            corners[3] = ImVec2(center_x + dx4 * cos_rot - dy4 * sin_rot, center_y + dx4 * sin_rot + dy4 * cos_rot);
+            // Colour override from the owning pin's cached data
+            float r = kPadColor[0], g = kPadColor[1], b = kPadColor[2], a = kPadColor[3];
+            ResolvePadColor(static_cast<int>(rectangle.pin), r, g, b, a);
             
-            // Draw the quad as two triangles
-            draw_list->AddQuadFilled(corners[0], corners[1], corners[2], corners[3], fill_color);
+            ImU32 fill_color = IM_COL32((int)(r * 255), (int)(g * 255), (int)(b * 255), (int)(a * 255));
+            ImU32 outline_color = IM_COL32((int)(r * 180), (int)(g * 180), (int)(b * 180), 255);
             
-            // Optional: Add outline for better visibility
-            ImU32 outline_color = IM_COL32(
-                (int)(r * 180), 
-                (int)(g * 180), 
-                (int)(b * 180), 
-                255
-            );
-            draw_list->AddQuad(corners[0], corners[1], corners[2], corners[3], outline_color, 1.0f);
+            writer.Emit(templates.rectangle, center_x, center_y, width * 0.5f, height * 0.5f, 0.0f, stack.cos_rotation, stack.sin_rotation,
+                        fill_color, outline_color);
         }
-    }
+    });
 }
 
-void PCBRenderer::RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+void PCBRenderer::RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                                      size_t begin, size_t end) {
+    PCB_TRACE_SCOPE("RenderOvalPins");
     if (!pcb_data || pcb_data->ovals.empty() || pin_geometry_cache.empty()) {
         return;
     }
     
-    // Pre-calculate selected net for highlighting (avoid string operations in loop)
-    std::string selected_net;
-    if (selected_pin_index >= 0 && selected_pin_index < (int)pcb_data->pins.size()) {
-        selected_net = pcb_data->pins[selected_pin_index].net;
-    }
+    const PadTemplateSet& templates = GetPadTemplates();
     
-    // Render all ovals as stadium shapes (rounded rectangles) with optimized visibility culling
-    for (size_t oval_idx = 0; oval_idx < pcb_data->ovals.size(); ++oval_idx) {
-        const auto& oval = pcb_data->ovals[oval_idx];
-        
-        // Early visibility culling using approximate radius
-        float approx_radius = std::max(oval.width, oval.height) * 0.5f;
-        if (!IsElementVisible(oval.center.x, oval.center.y, approx_radius, zoom, offset_x, offset_y, window_width, window_height)) {
-            continue;
-        }
-        
-        // Transform oval center coordinates to screen space with Y-axis mirroring
-        float center_x = oval.center.x * zoom + offset_x;
-        float center_y = offset_y - oval.center.y * zoom;  // Mirror Y-axis
-        
-        // Scale dimensions by zoom factor
-        float width = oval.width * zoom;
-        float height = oval.height * zoom;
-        
-        // Ensure minimum visibility
-        if (width < 2.0f) width = 2.0f;
-        if (height < 2.0f) height = 2.0f;
-        
-        // Check if this oval corresponds to a pin with cached data for color override
-        float r = oval.r, g = oval.g, b = oval.b, a = oval.a;
-        
-        // Find pin that matches this oval using cache (much faster than linear search)
-        for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size() && pin_idx < pin_geometry_cache.size(); ++pin_idx) {
-            const auto& pin = pcb_data->pins[pin_idx];
-            const auto& cache = pin_geometry_cache[pin_idx];
+    // Slices of the shape list are culled and tessellated in parallel, then spliced in order
+    const ScreenTransform view = MakeScreenTransform(zoom, offset_x, offset_y, window_width, window_height);
+    BuildPadGeometry(draw_list, oval_cull, begin, end, view, [&](PadBatchWriter& writer, const VisibleSet& visible) {
+        for (size_t k = 0; k < visible.count; ++k) {
+            const size_t oval_idx = visible.index[k];
+            const auto& oval = pcb_data->ovals[oval_idx];
+            const BRDPadStack& stack = pcb_data->GetPadStack(oval);
             
-            // Quick check using cached geometry index
-            if (cache.oval_index == oval_idx) {
-                // Use cached pin type checks
-                if (!selected_net.empty() && pin.net == selected_net) {
-                    // Highlight all pins on the same net
-                    r = 1.0f; g = 1.0f; b = 0.7f; a = 1.0f;
-                } else if (cache.is_nc) {
-                    // Use blue color for NC pins
-                    r = 0.0f; g = 0.3f; b = 0.3f; a = 1.0f;
-                } else if (cache.is_ground) {
-                    // Use grey color for ground pins
-                    r = 0.5f; g = 0.5f; b = 0.5f; a = 1.0f;
-                }
-                break;
-            }
-        }
-        
-        // Convert color components to ImU32 format (0-255 range)
-        ImU32 fill_color = IM_COL32(
-            (int)(r * 255), 
-            (int)(g * 255), 
-            (int)(b * 255), 
-            (int)(a * 255)
-        );
-        
-        // Stadium shape: rectangle with semicircular ends
-        // The radius of the semicircles is half the smaller dimension
-        float radius = std::min(width, height) / 2.0f;
-        
-        // Convert rotation to radians
-        float rot_rad = oval.rotation * 3.14159265f / 180.0f;
-        float cos_rot = std::cos(rot_rad);
-        float sin_rot = std::sin(rot_rad);
-        
-        // Create stadium shape points
-        std::vector<ImVec2> stadium_points;
-        const int semicircle_segments = 12; // Segments per semicircle
-        
-        if (width > height) {
-            // Horizontal stadium: longer in width
-            float rect_width = width - 2.0f * radius;  // Width of central rectangle
-            float rect_height = height;
+            // Screen-space centre (Y mirrored) comes from the kernel
+            float center_x = visible.screen_x[k];
+            float center_y = visible.screen_y[k];
             
-            // Left semicircle (from bottom to top)
-            for (int i = 0; i <= semicircle_segments; ++i) {
-                float angle = 3.14159265f * 0.5f + 3.14159265f * i / semicircle_segments; // π/2 to 3π/2
-                float x_local = -rect_width / 2.0f + radius * std::cos(angle);
-                float y_local = radius * std::sin(angle);
-                
-                // Apply rotation
-                float x_rotated = x_local * cos_rot - y_local * sin_rot;
-                float y_rotated = x_local * sin_rot + y_local * cos_rot;
-                
-                stadium_points.push_back(ImVec2(center_x + x_rotated, center_y + y_rotated));
-            }
+            // Scale dimensions by zoom factor
+            float width = stack.width * zoom;
+            float height = stack.height * zoom;
             
-            // Right semicircle (from top to bottom)
-            for (int i = 0; i <= semicircle_segments; ++i) {
-                float angle = 3.14159265f * 1.5f + 3.14159265f * i / semicircle_segments; // 3π/2 to 5π/2
-                float x_local = rect_width / 2.0f + radius * std::cos(angle);
-                float y_local = radius * std::sin(angle);
-                
-                // Apply rotation
-                float x_rotated = x_local * cos_rot - y_local * sin_rot;
-                float y_rotated = x_local * sin_rot + y_local * cos_rot;
-                
-                stadium_points.push_back(ImVec2(center_x + x_rotated, center_y + y_rotated));
-            }
-        } else {
-            // Vertical stadium: longer in height
-            float rect_width = width;
-            float rect_height = height - 2.0f * radius;  // Height of central rectangle
+            // Ensure minimum visibility
+            if (width < 2.0f) width = 2.0f;
+            if (height < 2.0f) height = 2.0f;
             
-            // Bottom semicircle (from left to right)
-            for (int i = 0; i <= semicircle_segments; ++i) {
-                float angle = 3.14159265f + 3.14159265f * i / semicircle_segments; // π to 2π
-                float x_local = radius * std::cos(angle);
-                float y_local = -rect_height / 2.0f + radius * std::sin(angle);
-                
-                // Apply rotation
-                float x_rotated = x_local * cos_rot - y_local * sin_rot;
-                float y_rotated = x_local * sin_rot + y_local * cos_rot;
-                
-                stadium_points.push_back(ImVec2(center_x + x_rotated, center_y + y_rotated));
+            // Colour override from the owning pin's cached data
+            float r = kPadColor[0], g = kPadColor[1], b = kPadColor[2], a = kPadColor[3];
+            ResolvePadColor(static_cast<int>(oval.pin), r, g, b, a);
+            
+            ImU32 fill_color = IM_COL32((int)(r * 255), (int)(g * 255), (int)(b * 255), (int)(a * 255));
+            ImU32 outline_color = IM_COL32((int)(r * 180), (int)(g * 180), (int)(b * 180), 255);
+            
+            // Stadium shape: rectangle with semicircular ends
+            // The radius of the semicircles is half the smaller dimension
+            float radius = std::min(width, height) / 2.0f;
+            float half_length = std::max(width, height) / 2.0f - radius;
+            
+            // The template is a horizontal stadium; a vertical one is the same shape turned by 90 degrees
+            ImVec2 rotation(stack.cos_rotation, stack.sin_rotation);
+            if (height > width) {
+                rotation = ImVec2(-rotation.y, rotation.x);
             }
             
-            // Top semicircle (from right to left)
-            for (int i = 0; i <= semicircle_segments; ++i) {
-                float angle = 2.0f * 3.14159265f + 3.14159265f * i / semicircle_segments; // 2π to 3π
-                float x_local = radius * std::cos(angle);
-                float y_local = rect_height / 2.0f + radius * std::sin(angle);
-                
-                // Apply rotation
-                float x_rotated = x_local * cos_rot - y_local * sin_rot;
-                float y_rotated = x_local * sin_rot + y_local * cos_rot;
-                
-                stadium_points.push_back(ImVec2(center_x + x_rotated, center_y + y_rotated));
+            writer.Emit(templates.stadium[SelectPadTemplateLevel(radius)], center_x, center_y, radius, radius, half_length,
+                        rotation.x, rotation.y, fill_color, outline_color);
+        }
+    });
+}
+
+void PCBRenderer::RenderNetHighlightOverlay(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    PCB_TRACE_SCOPE("RenderNetHighlightOverlay");
+    if (!pcb_data || highlighted_pins.empty()) {
+        return;
+    }
+    
+    const float margin = 10.0f;
+    const ImU32 fill_color = IM_COL32(255, 255, 179, 255);
+    
+    // Below full detail the static layer has no individual pads, so the net is shown as points
+    bool full_shapes = (gpu_pads_ready && settings.gpu_pads && pad_instance_count > 0) ||
+                       pad_detail_level == PadDetailLevel::Full;
+    if (!full_shapes) {
+        for (int pin_idx : highlighted_pins) {
+            const auto& pin = pcb_data->pins[pin_idx];
+            float x = pin.pos.x * zoom + offset_x;
+            float y = offset_y - pin.pos.y * zoom;
+            if (x < -margin || x > window_width + margin || y < -margin || y > window_height + margin) {
+                continue;
             }
+            draw_list->AddRectFilled(ImVec2(x - 1.5f, y - 1.5f), ImVec2(x + 1.5f, y + 1.5f), fill_color);
         }
-        
-        // Draw filled stadium shape using convex polygon
-        if (stadium_points.size() >= 3) {
-            draw_list->AddConvexPolyFilled(stadium_points.data(), stadium_points.size(), fill_color);
-            
-            // Optional: Add outline for better visibility
-            ImU32 outline_color = IM_COL32(
-                (int)(r * 180), 
-                (int)(g * 180), 
-                (int)(b * 180), 
-                255
-            );
+        return;
+    }
+    
+    // Same tessellation as the CPU pad passes, in the highlight colour, over the cached pads
+    const PadTemplateSet& templates = GetPadTemplates();
+    const ImU32 outline_color = IM_COL32(180, 180, 126, 255);
+    {
+        // The writer closes its last run when it goes out of scope
+        PadBatchWriter writer(overlay_chunk, ImGui::GetFontTexUvWhitePixel());
+        
+        for (int pin_idx : highlighted_pins) {
+            if (pin_idx >= (int)pin_geometry_cache.size()) {
+                continue;
+            }
+            const auto& cache = pin_geometry_cache[pin_idx];
             
-            // Draw outline by connecting consecutive points
-            for (size_t i = 0; i < stadium_points.size(); ++i) {
-                size_t next_i = (i + 1) % stadium_points.size();
-                draw_list->AddLine(stadium_points[i], stadium_points[next_i], outline_color, 1.0f);
+            if (cache.circle_index != SIZE_MAX) {
+                const auto& circle = pcb_data->circles[cache.circle_index];
+                float x = circle.center.x * zoom + offset_x;
+                float y = offset_y - circle.center.y * zoom;
+                float radius = std::max(1.0f, pcb_data->GetPadStack(circle).GetRadius() * zoom);
+                if (x + radius < -margin || x - radius > window_width + margin ||
+                    y + radius < -margin || y - radius > window_height + margin) {
+                    continue;
+                }
+                writer.Emit(templates.circle[SelectPadTemplateLevel(radius)], x, y, radius, radius, 0.0f, 1.0f, 0.0f,
+                            fill_color, outline_color);
+            } else if (cache.rectangle_index != SIZE_MAX) {
+                const auto& rectangle = pcb_data->rectangles[cache.rectangle_index];
+                const BRDPadStack& stack = pcb_data->GetPadStack(rectangle);
+                float x = rectangle.center.x * zoom + offset_x;
+                float y = offset_y - rectangle.center.y * zoom;
+                float width = std::max(2.0f, stack.width * zoom);
+                float height = std::max(2.0f, stack.height * zoom);
+                float reach = std::max(width, height);
+                if (x + reach < -margin || x - reach > window_width + margin ||
+                    y + reach < -margin || y - reach > window_height + margin) {
+                    continue;
+                }
+                writer.Emit(templates.rectangle, x, y, width * 0.5f, height * 0.5f, 0.0f, stack.cos_rotation, stack.sin_rotation,
+                            fill_color, outline_color);
+            } else if (cache.oval_index != SIZE_MAX) {
+                const auto& oval = pcb_data->ovals[cache.oval_index];
+                const BRDPadStack& stack = pcb_data->GetPadStack(oval);
+                float x = oval.center.x * zoom + offset_x;
+                float y = offset_y - oval.center.y * zoom;
+                float width = std::max(2.0f, stack.width * zoom);
+                float height = std::max(2.0f, stack.height * zoom);
+                float reach = std::max(width, height);
+                if (x + reach < -margin || x - reach > window_width + margin ||
+                    y + reach < -margin || y - reach > window_height + margin) {
+                    continue;
+                }
+                float radius = std::min(width, height) / 2.0f;
+                float half_length = std::max(width, height) / 2.0f - radius;
+                ImVec2 rotation(stack.cos_rotation, stack.sin_rotation);
+                if (height > width) {
+                    rotation = ImVec2(-rotation.y, rotation.x);
+                }
+                writer.Emit(templates.stadium[SelectPadTemplateLevel(radius)], x, y, radius, radius, half_length,
+                            rotation.x, rotation.y, fill_color, outline_color);
             }
         }
     }
+    
+    SplicePadChunk(draw_list, overlay_chunk);
+}
+
+void PCBRenderer::RenderHoverRing(ImDrawList* draw_list, float zoom, float offset_x, float offset_y) {
+    if (!pcb_data || hovered_pin_index < 0 || hovered_pin_index >= (int)pcb_data->pins.size()) {
+        return;
+    }
+    
+    const auto& pin = pcb_data->pins[hovered_pin_index];
+    float extent = 5.0f;
+    if (hovered_pin_index < (int)pin_geometry_cache.size() && pin_geometry_cache[hovered_pin_index].has_geometry) {
+        const auto& cache = pin_geometry_cache[hovered_pin_index];
+        extent = cache.circle_index != SIZE_MAX ? cache.radius : std::max(cache.extent_x, cache.extent_y);
+    }
+    
+    ImVec2 center(pin.pos.x * zoom + offset_x, offset_y - pin.pos.y * zoom);
+    draw_list->AddCircle(center, extent * zoom + 3.0f, IM_COL32(255, 255, 255, 200), 0, 1.5f);
 }
 
 bool PCBRenderer::IsGroundPin(const BRDPin& pin) {
     // Check if pin is a ground pin based on net name
     if (pin.net.empty()) return false;
     
-    std::string net_upper = pin.net;
+    std::string net_upper(pcb_data->GetString(pin.net));
     // Convert to uppercase for case-insensitive comparison
     std::transform(net_upper.begin(), net_upper.end(), net_upper.begin(), ::toupper);
     
@@ -1195,7 +1999,7 @@ bool PCBRenderer::IsNCPin(const BRDPin& pin) {
     // Check if pin is a No Connect (NC) pin based on net name
     if (pin.net.empty()) return false;
     
-    std::string net_upper = pin.net;
+    std::string net_upper(pcb_data->GetString(pin.net));
     // Convert to uppercase for case-insensitive comparison
     std::transform(net_upper.begin(), net_upper.end(), net_upper.begin(), ::toupper);
     
@@ -1209,15 +2013,47 @@ bool PCBRenderer::IsNCPin(const BRDPin& pin) {
 }
 
 // Performance optimization methods
-void PCBRenderer::BuildPinGeometryCache() {
+void PCBRenderer::BuildPinGeometryCache(const BoardCacheCounts& from) {
+    PCB_TRACE_SCOPE("BuildPinGeometryCache");
     if (!pcb_data) return;
     
-    pin_geometry_cache.clear();
+    pin_geometry_cache.resize(from.pins);
     pin_geometry_cache.resize(pcb_data->pins.size());
     
-    LOG_INFO("Building pin geometry cache for " + std::to_string(pcb_data->pins.size()) + " pins");
+    LOG_INFO("Building pin geometry cache for " + std::to_string(pcb_data->pins.size() - from.pins) + " pins");
+    
+    // Every pad names its pin; a pin with several pads keeps the first circle, then rectangle, then oval
+    auto attach_pads = [&](const std::vector<BRDPad>& pads, size_t first) {
+        for (size_t pad_idx = first; pad_idx < pads.size(); ++pad_idx) {
+            const BRDPad& pad = pads[pad_idx];
+            if (pad.pin >= pin_geometry_cache.size() || pin_geometry_cache[pad.pin].has_geometry) {
+                continue;
+            }
+            auto& cache = pin_geometry_cache[pad.pin];
+            const BRDPadStack& stack = pcb_data->GetPadStack(pad);
+            switch (stack.shape) {
+                case BRDPadShape::Circle:
+                    cache.circle_index = pad_idx;
+                    cache.radius = stack.GetRadius();
+                    break;
+                case BRDPadShape::Rectangle:
+                    cache.rectangle_index = pad_idx;
+                    break;
+                case BRDPadShape::Oval:
+                    cache.oval_index = pad_idx;
+                    break;
+            }
+            cache.pad_stack = pad.stack;
+            cache.extent_x = stack.extent_x;
+            cache.extent_y = stack.extent_y;
+            cache.has_geometry = true;
+        }
+    };
+    attach_pads(pcb_data->circles, from.circles);
+    attach_pads(pcb_data->rectangles, from.rectangles);
+    attach_pads(pcb_data->ovals, from.ovals);
     
-    for (size_t pin_idx = 0; pin_idx < pcb_data->pins.size(); ++pin_idx) {
+    for (size_t pin_idx = from.pins; pin_idx < pcb_data->pins.size(); ++pin_idx) {
         const auto& pin = pcb_data->pins[pin_idx];
         auto& cache = pin_geometry_cache[pin_idx];
         
@@ -1225,54 +2061,209 @@ void PCBRenderer::BuildPinGeometryCache() {
         cache.is_ground = IsGroundPin(pin);
         cache.is_nc = IsNCPin(pin);
         
-        // Find geometry for this pin
-        bool found_geometry = false;
-        
-        // Check circles
-        for (size_t circle_idx = 0; circle_idx < pcb_data->circles.size(); ++circle_idx) {
-            const auto& circle = pcb_data->circles[circle_idx];
-            if (circle.center.x == pin.pos.x && circle.center.y == pin.pos.y) {
-                cache.circle_index = circle_idx;
-                cache.radius = circle.radius;
-                found_geometry = true;
-                break;
+        // Fallback radius if no geometry found
+        if (!cache.has_geometry) {
+            cache.radius = static_cast<float>(pin.radius);
+            if (cache.radius < 1.0f) {
+                cache.radius = 6.5f;
             }
         }
+    }
+    
+    LOG_INFO("Pin geometry cache built successfully");
+}
+
+void PCBRenderer::BuildPartBoundsCache(const BoardCacheCounts& from) {
+    PCB_TRACE_SCOPE("BuildPartBoundsCache");
+    if (from.pins == 0) {
+        part_bounds_cache.clear();
+        pad_sizes.clear();
+    }
+    typical_pad_size = 0.0f;
+    if (!pcb_data) return;
+    
+    // Pad sizes (smaller dimension) used to pick the typical on-screen pad size for LOD
+    pad_sizes.reserve(pcb_data->pins.size());
+    
+    for (size_t pin_idx = from.pins; pin_idx < pcb_data->pins.size() && pin_idx < pin_geometry_cache.size(); ++pin_idx) {
+        const auto& pin = pcb_data->pins[pin_idx];
+        const auto& cache = pin_geometry_cache[pin_idx];
+        if (!cache.has_geometry) {
+            continue;
+        }
         
-        // Check rectangles if no circle found
-        if (!found_geometry) {
-            for (size_t rect_idx = 0; rect_idx < pcb_data->rectangles.size(); ++rect_idx) {
-                const auto& rect = pcb_data->rectangles[rect_idx];
-                if (rect.center.x == pin.pos.x && rect.center.y == pin.pos.y) {
-                    cache.rectangle_index = rect_idx;
-                    found_geometry = true;
-                    break;
-                }
+        const BRDPadStack& stack = pcb_data->pad_stacks[cache.pad_stack];
+        pad_sizes.push_back(std::min(stack.width, stack.height));
+        
+        if (pin.part >= part_bounds_cache.size()) {
+            part_bounds_cache.resize(pin.part + 1);
+        }
+        auto& bounds = part_bounds_cache[pin.part];
+        float min_x = pin.pos.x - cache.extent_x;
+        float max_x = pin.pos.x + cache.extent_x;
+        float min_y = pin.pos.y - cache.extent_y;
+        float max_y = pin.pos.y + cache.extent_y;
+        if (bounds.pad_count == 0) {
+            bounds.min_x = min_x; bounds.max_x = max_x;
+            bounds.min_y = min_y; bounds.max_y = max_y;
+        } else {
+            bounds.min_x = std::min(bounds.min_x, min_x);
+            bounds.max_x = std::max(bounds.max_x, max_x);
+            bounds.min_y = std::min(bounds.min_y, min_y);
+            bounds.max_y = std::max(bounds.max_y, max_y);
+        }
+        bounds.pad_count++;
+    }
+    
+    if (!pad_sizes.empty()) {
+        // Reorders the samples, which are only ever used as a set
+        auto median = pad_sizes.begin() + pad_sizes.size() / 2;
+        std::nth_element(pad_sizes.begin(), median, pad_sizes.end());
+        typical_pad_size = *median;
+    }
+}
+
+void PCBRenderer::UpdatePadDetailLevel(float zoom) {
+    if (!settings.pad_lod || typical_pad_size <= 0.0f) {
+        pad_detail_level = PadDetailLevel::Full;
+        return;
+    }
+    
+    // Thresholds are widened by the hysteresis band in the direction of travel,
+    // so a zoom hovering around a threshold does not flip the level every frame
+    float pad_px = typical_pad_size * zoom;
+    float enter_full = settings.lod_full_shape_px * (1.0f + settings.lod_hysteresis);
+    float leave_full = settings.lod_full_shape_px * (1.0f - settings.lod_hysteresis);
+    float enter_clusters = settings.lod_cluster_px * (1.0f + settings.lod_hysteresis);
+    float leave_clusters = settings.lod_cluster_px * (1.0f - settings.lod_hysteresis);
+    
+    switch (pad_detail_level) {
+        case PadDetailLevel::Full:
+            if (pad_px < leave_full) {
+                pad_detail_level = pad_px < leave_clusters ? PadDetailLevel::Density : PadDetailLevel::Clusters;
+            }
+            break;
+        case PadDetailLevel::Clusters:
+            if (pad_px >= enter_full) {
+                pad_detail_level = PadDetailLevel::Full;
+            } else if (pad_px < leave_clusters) {
+                pad_detail_level = PadDetailLevel::Density;
             }
+            break;
+        case PadDetailLevel::Density:
+            if (pad_px >= enter_full) {
+                pad_detail_level = PadDetailLevel::Full;
+            } else if (pad_px >= enter_clusters) {
+                pad_detail_level = PadDetailLevel::Clusters;
+            }
+            break;
+    }
+}
+
+void PCBRenderer::RenderPadClustersImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    PCB_TRACE_SCOPE("RenderPadClusters");
+    if (!pcb_data || pin_geometry_cache.empty()) {
+        return;
+    }
+    
+    ImU32 pad_color = IM_COL32(178, 0, 0, 255);
+    
+    // Parts with several pads collapse into a single box covering the pad cluster
+    for (size_t part = 0; part < part_bounds_cache.size(); ++part) {
+        const auto& bounds = part_bounds_cache[part];
+        if (bounds.pad_count < 2) {
+            continue;
         }
         
-        // Check ovals if no other geometry found
-        if (!found_geometry) {
-            for (size_t oval_idx = 0; oval_idx < pcb_data->ovals.size(); ++oval_idx) {
-                const auto& oval = pcb_data->ovals[oval_idx];
-                if (oval.center.x == pin.pos.x && oval.center.y == pin.pos.y) {
-                    cache.oval_index = oval_idx;
-                    found_geometry = true;
-                    break;
-                }
-            }
+        ImVec2 top_left(bounds.min_x * zoom + offset_x, offset_y - bounds.max_y * zoom);
+        ImVec2 bottom_right(bounds.max_x * zoom + offset_x, offset_y - bounds.min_y * zoom);
+        if (bottom_right.x < 0 || top_left.x > window_width || bottom_right.y < 0 || top_left.y > window_height) {
+            continue;
         }
         
-        // Fallback radius if no geometry found
-        if (!found_geometry) {
-            cache.radius = static_cast<float>(pin.radius);
-            if (cache.radius < 1.0f) {
-                cache.radius = 6.5f;
-            }
+        // Keep at least one pixel so small parts do not disappear
+        if (bottom_right.x - top_left.x < 1.0f) bottom_right.x = top_left.x + 1.0f;
+        if (bottom_right.y - top_left.y < 1.0f) bottom_right.y = top_left.y + 1.0f;
+        draw_list->AddRectFilled(top_left, bottom_right, pad_color);
+    }
+    
+    // Lone pads (test pads, single-pin parts) become point sprites
+    CullKernel::TransformAndCull(pin_cull, MakeScreenTransform(zoom, offset_x, offset_y, window_width, window_height), visible_pins);
+    
+    for (size_t k = 0; k < visible_pins.count; ++k) {
+        const size_t pin_idx = pin_cull_order[visible_pins.index[k]];
+        const auto& pin = pcb_data->pins[pin_idx];
+        const auto& cache = pin_geometry_cache[pin_idx];
+        if (!cache.has_geometry) {
+            continue;
+        }
+        
+        bool lone = pin.part >= part_bounds_cache.size() || part_bounds_cache[pin.part].pad_count < 2;
+        if (!lone) {
+            continue;
+        }
+        
+        float x = visible_pins.screen_x[k];
+        float y = visible_pins.screen_y[k];
+        if (x < -2.0f || x > window_width + 2.0f || y < -2.0f || y > window_height + 2.0f) {
+            continue;
         }
+        
+        draw_list->AddRectFilled(ImVec2(x - 1.0f, y - 1.0f), ImVec2(x + 1.0f, y + 1.0f), pad_color);
+    }
+}
+
+void PCBRenderer::RenderPadDensityImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    PCB_TRACE_SCOPE("RenderPadDensity");
+    if (!pcb_data || pin_geometry_cache.empty() || window_width <= 0 || window_height <= 0) {
+        return;
     }
     
-    LOG_INFO("Pin geometry cache built successfully");
+    float tile_px = std::max(2.0f, settings.lod_density_tile_px);
+    
+    // Tiles are aligned to the window, not to the region being drawn, so pan-cache strips
+    // produce exactly the tiles a full redraw would (the clip rect trims the edge tiles)
+    float grid_x = static_region.active ? static_cast<float>(static_region.x) : 0.0f;
+    float grid_y = static_region.active ? static_cast<float>(static_region.y) : 0.0f;
+    int first_col = static_cast<int>(std::floor(grid_x / tile_px));
+    int first_row = static_cast<int>(std::floor(grid_y / tile_px));
+    int cols = static_cast<int>(std::floor((grid_x + window_width) / tile_px)) - first_col + 1;
+    int rows = static_cast<int>(std::floor((grid_y + window_height) / tile_px)) - first_row + 1;
+    float origin_x = first_col * tile_px - grid_x;  // Top-left of the first tile in local coordinates
+    float origin_y = first_row * tile_px - grid_y;
+    density_tiles.assign(static_cast<size_t>(cols) * rows, 0.0f);
+    
+    // Accumulate pad counts per screen tile
+    CullKernel::TransformAndCull(pin_cull, MakeScreenTransform(zoom, offset_x, offset_y, window_width, window_height), visible_pins);
+    for (size_t k = 0; k < visible_pins.count; ++k) {
+        if (!pin_geometry_cache[pin_cull_order[visible_pins.index[k]]].has_geometry) {
+            continue;
+        }
+        
+        float x = visible_pins.screen_x[k];
+        float y = visible_pins.screen_y[k];
+        int col = static_cast<int>(std::floor((x - origin_x) / tile_px));
+        int row = static_cast<int>(std::floor((y - origin_y) / tile_px));
+        if (col < 0 || col >= cols || row < 0 || row >= rows) {
+            continue;
+        }
+        density_tiles[static_cast<size_t>(row) * cols + col] += 1.0f;
+    }
+    
+    // One quad per occupied tile; opacity follows how much of the tile the pads would cover
+    float full_coverage = std::max(1.0f, tile_px * tile_px / 4.0f);
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            float count = density_tiles[static_cast<size_t>(row) * cols + col];
+            if (count <= 0.0f) {
+                continue;
+            }
+            float coverage = std::min(1.0f, 0.25f + 0.75f * count / full_coverage);
+            ImVec2 tile_min(origin_x + col * tile_px, origin_y + row * tile_px);
+            ImVec2 tile_max(tile_min.x + tile_px, tile_min.y + tile_px);
+            draw_list->AddRectFilled(tile_min, tile_max, IM_COL32(178, 0, 0, static_cast<int>(coverage * 255)));
+        }
+    }
 }
 
 bool PCBRenderer::IsElementVisible(float x, float y, float radius, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
@@ -1303,7 +2294,8 @@ bool PCBRenderer::HandleMouseClick(float screen_x, float screen_y, int window_wi
     ScreenToWorld(screen_x, screen_y, world_x, world_y, window_width, window_height);
     
     // Check if click is near any pin using cached geometry data
-    for (size_t i = 0; i < pcb_data->pins.size() && i < pin_geometry_cache.size(); ++i) {
+    CollectHitCandidates(world_x, world_y);
+    for (size_t i : hit_candidates) {
         const auto& pin = pcb_data->pins[i];
         const auto& cache = pin_geometry_cache[i];
         
@@ -1315,15 +2307,12 @@ bool PCBRenderer::HandleMouseClick(float screen_x, float screen_y, int window_wi
         // Use cached geometry data for hit testing
         if (cache.rectangle_index != SIZE_MAX) {
             // Rectangle pin: check if click is inside the rectangle (with rotation)
-            const auto& rect = pcb_data->rectangles[cache.rectangle_index];
+            const BRDPadStack& rect = pcb_data->pad_stacks[cache.pad_stack];
             float dx = world_x - pin.pos.x;
             float dy = world_y - pin.pos.y;
-            // Undo rotation
-            float angle_rad = -rect.rotation * 3.14159265f / 180.0f;
-            float cos_a = std::cos(angle_rad);
-            float sin_a = std::sin(angle_rad);
-            float local_x = dx * cos_a - dy * sin_a;
-            float local_y = dx * sin_a + dy * cos_a;
+            // Undo rotation (the stack's precomputed cos/sin)
+            float local_x = dx * rect.cos_rotation + dy * rect.sin_rotation;
+            float local_y = -dx * rect.sin_rotation + dy * rect.cos_rotation;
             float half_w = rect.width / 2.0f;
             float half_h = rect.height / 2.0f;
             if (std::abs(local_x) <= half_w && std::abs(local_y) <= half_h) {
@@ -1339,14 +2328,11 @@ bool PCBRenderer::HandleMouseClick(float screen_x, float screen_y, int window_wi
 
         if (cache.oval_index != SIZE_MAX) {
             // Oval pin: check if click is inside the rotated ellipse (approximate)
-            const auto& oval = pcb_data->ovals[cache.oval_index];
+            const BRDPadStack& oval = pcb_data->pad_stacks[cache.pad_stack];
             float dx = world_x - pin.pos.x;
             float dy = world_y - pin.pos.y;
-            float angle_rad = -oval.rotation * 3.14159265f / 180.0f;
-            float cos_a = std::cos(angle_rad);
-            float sin_a = std::sin(angle_rad);
-            float local_x = dx * cos_a - dy * sin_a;
-            float local_y = dx * sin_a + dy * cos_a;
+            float local_x = dx * oval.cos_rotation + dy * oval.sin_rotation;
+            float local_y = -dx * oval.sin_rotation + dy * oval.cos_rotation;
             float rx = oval.width / 2.0f;
             float ry = oval.height / 2.0f;
             if ((local_x * local_x) / (rx * rx) + (local_y * local_y) / (ry * ry) <= 1.0f) {
@@ -1385,6 +2371,30 @@ bool PCBRenderer::HandleMouseClick(float screen_x, float screen_y, int window_wi
     return false; // Click not consumed
 }
 
+void PCBRenderer::CollectHitCandidates(float world_x, float world_y) {
+    hit_candidates.clear();
+    
+    // A zero-sized view at the point in board units; the margin covers the 5-unit minimum
+    // radius of the circle test
+    ScreenTransform view;
+    view.zoom = 1.0f;
+    view.offset_x = -world_x;
+    view.offset_y = world_y;
+    view.width = 0.0f;
+    view.height = 0.0f;
+    view.margin = 5.0f;
+    CullKernel::TransformAndCull(pin_cull, view, visible_hits);
+    
+    for (size_t k = 0; k < visible_hits.count; ++k) {
+        uint32_t pin = pin_cull_order[visible_hits.index[k]];
+        if (pin < pin_geometry_cache.size()) {
+            hit_candidates.push_back(pin);
+        }
+    }
+    // Pins are tested in index order so overlapping pads resolve as before
+    std::sort(hit_candidates.begin(), hit_candidates.end());
+}
+
 void PCBRenderer::ClearSelection() {
     selected_pin_index = -1;
 }
@@ -1398,7 +2408,8 @@ int PCBRenderer::GetHoveredPin(float screen_x, float screen_y, int window_width,
     float world_x, world_y;
     ScreenToWorld(screen_x, screen_y, world_x, world_y, window_width, window_height);
     
-    for (size_t i = 0; i < pcb_data->pins.size() && i < pin_geometry_cache.size(); ++i) {
+    CollectHitCandidates(world_x, world_y);
+    for (size_t i : hit_candidates) {
         const auto& pin = pcb_data->pins[i];
         const auto& cache = pin_geometry_cache[i];
         
@@ -1410,15 +2421,12 @@ int PCBRenderer::GetHoveredPin(float screen_x, float screen_y, int window_width,
         // Use cached geometry data for hit testing
         if (cache.rectangle_index != SIZE_MAX) {
             // Rectangle pin: check if mouse is inside the rectangle (with rotation)
-            const auto& rect = pcb_data->rectangles[cache.rectangle_index];
+            const BRDPadStack& rect = pcb_data->pad_stacks[cache.pad_stack];
             float dx = world_x - pin.pos.x;
             float dy = world_y - pin.pos.y;
-            // Undo rotation
-            float angle_rad = -rect.rotation * 3.14159265f / 180.0f;
-            float cos_a = std::cos(angle_rad);
-            float sin_a = std::sin(angle_rad);
-            float local_x = dx * cos_a - dy * sin_a;
-            float local_y = dx * sin_a + dy * cos_a;
+            // Undo rotation (the stack's precomputed cos/sin)
+            float local_x = dx * rect.cos_rotation + dy * rect.sin_rotation;
+            float local_y = -dx * rect.sin_rotation + dy * rect.cos_rotation;
             float half_w = rect.width / 2.0f;
             float half_h = rect.height / 2.0f;
             if (std::abs(local_x) <= half_w && std::abs(local_y) <= half_h) {
@@ -1429,14 +2437,11 @@ int PCBRenderer::GetHoveredPin(float screen_x, float screen_y, int window_width,
 
         if (cache.oval_index != SIZE_MAX) {
             // Oval pin: check if mouse is inside the rotated ellipse (approximate)
-            const auto& oval = pcb_data->ovals[cache.oval_index];
+            const BRDPadStack& oval = pcb_data->pad_stacks[cache.pad_stack];
             float dx = world_x - pin.pos.x;
             float dy = world_y - pin.pos.y;
-            float angle_rad = -oval.rotation * 3.14159265f / 180.0f;
-            float cos_a = std::cos(angle_rad);
-            float sin_a = std::sin(angle_rad);
-            float local_x = dx * cos_a - dy * sin_a;
-            float local_y = dx * sin_a + dy * cos_a;
+            float local_x = dx * oval.cos_rotation + dy * oval.sin_rotation;
+            float local_y = -dx * oval.sin_rotation + dy * oval.cos_rotation;
             float rx = oval.width / 2.0f;
             float ry = oval.height / 2.0f;
             if ((local_x * local_x) / (rx * rx) + (local_y * local_y) / (ry * ry) <= 1.0f) {
@@ -1479,6 +2484,7 @@ void PCBRenderer::WorldToScreen(float world_x, float world_y, float& screen_x, f
 }
 
 void PCBRenderer::RenderPartNamesOnTop(ImDrawList* draw_list) {
+    PCB_TRACE_SCOPE("RenderPartNames");
     // Render all collected part names on top of all other graphics
     for (const auto& part_name_info : part_names_to_render) {
         // Clip text rendering to component boundaries
@@ -1492,7 +2498,8 @@ void PCBRenderer::RenderPartNamesOnTop(ImDrawList* draw_list) {
         }
         
         // Render the part name text (no scaling - text already fits within bounds)
-        draw_list->AddText(part_name_info.position, part_name_info.color, part_name_info.text.c_str());
+        draw_list->AddText(part_name_info.position, part_name_info.color,
+                           part_name_info.text.data(), part_name_info.text.data() + part_name_info.text.size());
         
         // Restore clipping
         draw_list->PopClipRect();
@@ -1502,7 +2509,73 @@ void PCBRenderer::RenderPartNamesOnTop(ImDrawList* draw_list) {
     part_names_to_render.clear();
 }
 
+void PCBRenderer::BuildPartLabelCache(const BoardCacheCounts& from) {
+    PCB_TRACE_SCOPE("BuildPartLabelCache");
+    part_label_cache.resize(from.parts);
+    if (!pcb_data) return;
+    
+    // Pin bounds per new part in one pass over the new pins (parts are 1-indexed in
+    // BRDPin::part); appended pins belong to appended parts only
+    struct PinBounds {
+        float min_x, min_y, max_x, max_y;
+        size_t count = 0;
+    };
+    std::vector<PinBounds> pin_bounds(pcb_data->parts.size() - from.parts);
+    for (size_t pin_idx = from.pins; pin_idx < pcb_data->pins.size(); ++pin_idx) {
+        const auto& pin = pcb_data->pins[pin_idx];
+        if (pin.part <= from.parts || pin.part > pcb_data->parts.size()) {
+            continue;
+        }
+        PinBounds& bounds = pin_bounds[pin.part - 1 - from.parts];
+        float x = static_cast<float>(pin.pos.x);
+        float y = static_cast<float>(pin.pos.y);
+        if (bounds.count == 0) {
+            bounds.min_x = bounds.max_x = x;
+            bounds.min_y = bounds.max_y = y;
+        } else {
+            bounds.min_x = std::min(bounds.min_x, x);
+            bounds.max_x = std::max(bounds.max_x, x);
+            bounds.min_y = std::min(bounds.min_y, y);
+            bounds.max_y = std::max(bounds.max_y, y);
+        }
+        bounds.count++;
+    }
+    
+    part_label_cache.resize(pcb_data->parts.size());
+    for (size_t part_index = from.parts; part_index < pcb_data->parts.size(); ++part_index) {
+        const auto& part = pcb_data->parts[part_index];
+        const PinBounds& bounds = pin_bounds[part_index - from.parts];
+        PartLabelCache& label = part_label_cache[part_index];
+        
+        // Parts without names and single-pin parts do not get a label
+        label.show = !part.name.empty() && bounds.count != 1;
+        if (!label.show) {
+            continue;
+        }
+        
+        if (bounds.count == 0) {
+            // Use part bounds if no pins
+            label.min_x = static_cast<float>(part.p1.x);
+            label.max_x = static_cast<float>(part.p2.x);
+            label.min_y = static_cast<float>(part.p1.y);
+            label.max_y = static_cast<float>(part.p2.y);
+            continue;
+        }
+        
+        // Add some margin around the pins
+        float width = bounds.max_x - bounds.min_x;
+        float height = bounds.max_y - bounds.min_y;
+        float margin = DeterminePinMargin(part, bounds.count, std::sqrt(width * width + height * height));
+        label.min_x = bounds.min_x - margin;
+        label.max_x = bounds.max_x + margin;
+        label.min_y = bounds.min_y - margin;
+        label.max_y = bounds.max_y + margin;
+    }
+}
+
 void PCBRenderer::CollectPartNamesForRendering(float zoom, float offset_x, float offset_y) {
+    PCB_ALLOC_SCOPE(Labels);
+    PCB_TRACE_SCOPE("CollectPartNames");
     if (!pcb_data || pcb_data->parts.empty()) {
         return;
     }
@@ -1514,127 +2587,51 @@ void PCBRenderer::CollectPartNamesForRendering(float zoom, float offset_x, float
 
     // Clear any existing part names from previous frame
     part_names_to_render.clear();
+    
+    const ImVec2 display_size = ImGui::GetIO().DisplaySize;
 
-    for (size_t part_index = 0; part_index < pcb_data->parts.size(); ++part_index) {
-        const auto& part = pcb_data->parts[part_index];
-        
-        // Skip parts without names
-        if (part.name.empty()) {
-            continue;
-        }
-
-        // Get pins for this part to calculate bounds
-        std::vector<BRDPin> part_pins;
-        for (const auto& pin : pcb_data->pins) {
-            if (pin.part == part_index + 1) { // Parts are 1-indexed
-                part_pins.push_back(pin);
-            }
-        }
-
-        // If part has only one pin, do not show the part name
-        if (part_pins.size() == 1) {
-            continue;
-        }
-
-        if (part_pins.empty()) {
-            // Use part bounds if no pins
-            float center_x = (part.p1.x + part.p2.x) * 0.5f;
-            float center_y = (part.p1.y + part.p2.y) * 0.5f;
-            
-            // Transform to screen coordinates
-            float screen_x = center_x * zoom + offset_x;
-            float screen_y = offset_y - center_y * zoom;
-            
-            // Calculate text size
-            ImVec2 text_size = ImGui::CalcTextSize(part.name.c_str());
-            
-            // Check if text fits within part bounds
-            float part_width = std::abs(part.p2.x - part.p1.x) * zoom;
-            float part_height = std::abs(part.p2.y - part.p1.y) * zoom;
-            
-            // Only show if text fits completely within the part boundaries
-            if (text_size.x > part_width || text_size.y > part_height) {
-                continue; // Skip if text doesn't fit
-            }
-            
-            PartNameInfo info;
-            info.text = part.name;
-            info.position = ImVec2(screen_x - text_size.x * 0.5f, screen_y - text_size.y * 0.5f);
-            info.size = text_size;
-            info.color = IM_COL32(255, 255, 255, 255); // White text
-            info.background_color = IM_COL32(0, 0, 0, 128); // Semi-transparent black background
-            
-            // Set clipping bounds (use part bounds)
-            float min_x = part.p1.x * zoom + offset_x;
-            float max_x = part.p2.x * zoom + offset_x;
-            float min_y = offset_y - part.p2.y * zoom;
-            float max_y = offset_y - part.p1.y * zoom;
-            
-            info.clip_min = ImVec2(min_x, min_y);
-            info.clip_max = ImVec2(max_x, max_y);
-            
-            part_names_to_render.push_back(info);
+    for (size_t part_index = 0; part_index < pcb_data->parts.size() && part_index < part_label_cache.size(); ++part_index) {
+        const auto& label = part_label_cache[part_index];
+        if (!label.show) {
             continue;
         }
-
-        // Calculate part bounds from pins
-        float min_x = part_pins[0].pos.x, max_x = part_pins[0].pos.x;
-        float min_y = part_pins[0].pos.y, max_y = part_pins[0].pos.y;
+        const auto& part = pcb_data->parts[part_index];
         
-        for (const auto& pin : part_pins) {
-            min_x = std::min(min_x, static_cast<float>(pin.pos.x));
-            max_x = std::max(max_x, static_cast<float>(pin.pos.x));
-            min_y = std::min(min_y, static_cast<float>(pin.pos.y));
-            max_y = std::max(max_y, static_cast<float>(pin.pos.y));
+        // Label box in screen coordinates (Y mirrored)
+        float screen_min_x = label.min_x * zoom + offset_x;
+        float screen_max_x = label.max_x * zoom + offset_x;
+        float screen_min_y = offset_y - label.max_y * zoom;
+        float screen_max_y = offset_y - label.min_y * zoom;
+        if (std::max(screen_min_x, screen_max_x) < 0.0f || std::min(screen_min_x, screen_max_x) > display_size.x ||
+            std::max(screen_min_y, screen_max_y) < 0.0f || std::min(screen_min_y, screen_max_y) > display_size.y) {
+            continue;
         }
-
-        // Add some margin around the pins
-        float margin = DeterminePinMargin(part, part_pins, 
-                                        std::sqrt((max_x - min_x) * (max_x - min_x) + (max_y - min_y) * (max_y - min_y)));
-        
-        min_x -= margin;
-        max_x += margin;
-        min_y -= margin;
-        max_y += margin;
-
-        // Calculate center position in world coordinates
-        float center_x = (min_x + max_x) * 0.5f;
-        float center_y = (min_y + max_y) * 0.5f;
-        
-        // Transform to screen coordinates
-        float screen_center_x = center_x * zoom + offset_x;
-        float screen_center_y = offset_y - center_y * zoom;
         
         // Calculate text size
-        ImVec2 text_size = ImGui::CalcTextSize(part.name.c_str());
-        
-        // Check if text fits within component bounds (screen coordinates)
-        float component_width = (max_x - min_x) * zoom;
-        float component_height = (max_y - min_y) * zoom;
+        std::string_view name = pcb_data->GetString(part.name);
+        const char* text_begin = name.data();
+        const char* text_end = text_begin + name.size();
+        ImVec2 text_size = ImGui::CalcTextSize(text_begin, text_end);
         
         // Only show if text fits completely within the component boundaries
+        float component_width = std::abs(screen_max_x - screen_min_x);
+        float component_height = std::abs(screen_max_y - screen_min_y);
         if (text_size.x > component_width || text_size.y > component_height) {
-            // Text too large to fit inside component, skip
             continue;
         }
         
-        // Use original text size (no artificial scaling)
-        ImVec2 scaled_text_size = text_size;
+        float screen_center_x = (screen_min_x + screen_max_x) * 0.5f;
+        float screen_center_y = (screen_min_y + screen_max_y) * 0.5f;
 
         PartNameInfo info;
-        info.text = part.name;
-        info.position = ImVec2(screen_center_x - scaled_text_size.x * 0.5f, screen_center_y - scaled_text_size.y * 0.5f);
-        info.size = scaled_text_size;
+        info.text = name;
+        info.position = ImVec2(screen_center_x - text_size.x * 0.5f, screen_center_y - text_size.y * 0.5f);
+        info.size = text_size;
         info.color = IM_COL32(255, 255, 255, 255);
         // Semi-transparent black background for better visibility
-        info.background_color = IM_COL32(0, 0, 0, 128); // Semi-transparent black background
+        info.background_color = IM_COL32(0, 0, 0, 128);
         
         // Set clipping bounds to component area
-        float screen_min_x = min_x * zoom + offset_x;
-        float screen_max_x = max_x * zoom + offset_x;
-        float screen_min_y = offset_y - max_y * zoom;
-        float screen_max_y = offset_y - min_y * zoom;
-        
         info.clip_min = ImVec2(screen_min_x, screen_min_y);
         info.clip_max = ImVec2(screen_max_x, screen_max_y);
         
@@ -1642,7 +2639,24 @@ void PCBRenderer::CollectPartNamesForRendering(float zoom, float offset_x, float
     }
 }
 
+// Text helpers for string_view labels (no terminator needed, nothing copied)
+static ImVec2 CalcTextSize(std::string_view text) {
+    return ImGui::CalcTextSize(text.data(), text.data() + text.size());
+}
+
+static void AddText(ImDrawList* draw_list, const ImVec2& position, ImU32 color, std::string_view text) {
+    draw_list->AddText(position, color, text.data(), text.data() + text.size());
+}
+
+// Lines of a wrapped label, stored in the frame arena
+struct TextLines {
+    const std::string_view* line = nullptr;
+    size_t count = 0;
+};
+
 void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height) {
+    PCB_ALLOC_SCOPE(Labels);
+    PCB_TRACE_SCOPE("RenderPinLabels");
     if (!pcb_data || pcb_data->pins.empty() || pin_geometry_cache.empty()) {
         return;
     }
@@ -1652,39 +2666,26 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
         return;
     }
 
-    for (size_t pin_index = 0; pin_index < pcb_data->pins.size() && pin_index < pin_geometry_cache.size(); ++pin_index) {
+    // Batched transform + visibility culling for pins
+    CullKernel::TransformAndCull(pin_cull, MakeScreenTransform(zoom, offset_x, offset_y, window_width, window_height), visible_pin_labels);
+    
+    for (size_t k = 0; k < visible_pin_labels.count; ++k) {
+        const size_t pin_index = pin_cull_order[visible_pin_labels.index[k]];
         const auto& pin = pcb_data->pins[pin_index];
         const auto& cache = pin_geometry_cache[pin_index];
         
-        // Early visibility culling for pins
-        float approx_radius = cache.radius > 0 ? cache.radius : 10.0f;
-        if (!IsElementVisible(pin.pos.x, pin.pos.y, approx_radius, zoom, offset_x, offset_y, window_width, window_height)) {
-            continue;
-        }
-        
-        // Transform pin coordinates to screen space with Y-axis mirroring
-        float x = pin.pos.x * zoom + offset_x;
-        float y = offset_y - pin.pos.y * zoom;
+        // Screen-space pin position (Y mirrored) comes from the kernel
+        float x = visible_pin_labels.screen_x[k];
+        float y = visible_pin_labels.screen_y[k];
         
         // Calculate pin dimensions using cached geometry data
         float pin_width = 0.0f, pin_height = 0.0f;
         
-        if (cache.rectangle_index != SIZE_MAX) {
-            // Rectangle pin
-            const auto& rect = pcb_data->rectangles[cache.rectangle_index];
-            pin_width = rect.width * zoom;
-            pin_height = rect.height * zoom;
-        } else if (cache.oval_index != SIZE_MAX) {
-            // Oval pin
-            const auto& oval = pcb_data->ovals[cache.oval_index];
-            pin_width = oval.width * zoom;
-            pin_height = oval.height * zoom;
-        } else if (cache.circle_index != SIZE_MAX) {
-            // Circle pin
-            const auto& circle = pcb_data->circles[cache.circle_index];
-            float radius = circle.radius * zoom;
-            pin_width = radius * 2.0f;
-            pin_height = radius * 2.0f;
+        if (cache.has_geometry) {
+            // Pad stack dimensions (a circle's are its diameter)
+            const BRDPadStack& stack = pcb_data->pad_stacks[cache.pad_stack];
+            pin_width = stack.width * zoom;
+            pin_height = stack.height * zoom;
         } else {
             // Fallback using cached radius
             float radius = cache.radius * zoom;
@@ -1704,29 +2705,17 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
             continue;
         }
         
-        // Get pin number
-        std::string pin_number = "";
-        if (!pin.snum.empty()) {
-            pin_number = pin.snum;
-        } else if (!pin.name.empty()) {
-            pin_number = pin.name;
-        }
+        // Get pin number (boards loaded with lazy text read it back here, once per part)
+        std::string_view pin_number = pcb_data->GetPinNumber(pin_index);
         
-        // Get net name (prefer meaningful names)
-        std::string net_name = "";
-        if (!pin.net.empty() && pin.net != "UNCONNECTED" && pin.net != "") {
-            if (pin.net.substr(0, 4) != "NET_") {
-                net_name = pin.net;  // Meaningful names (VCC, GND, etc.)
-            } else {
-                net_name = pin.net;  // Show generic NET_ names too
-            }
+        // Get net name (meaningful names like VCC/GND and generic NET_ names alike)
+        std::string_view net_name;
+        if (!pin.net.empty() && pcb_data->GetString(pin.net) != "UNCONNECTED") {
+            net_name = pcb_data->GetString(pin.net);
         }
         
         // Get diode reading (voltage reading) from pin comment - this is the priority display
-        std::string diode_reading = "";
-        if (!pin.comment.empty()) {
-            diode_reading = pin.comment;
-        }
+        std::string_view diode_reading = pcb_data->GetPinComment(pin_index);
         
         // Skip if no pin number available
         if (pin_number.empty()) {
@@ -1734,9 +2723,7 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
         }
         
         // Calculate base text sizes (including diode reading)
-        ImVec2 pin_text_size = ImGui::CalcTextSize(pin_number.c_str());
-        ImVec2 net_text_size = net_name.empty() ? ImVec2(0,0) : ImGui::CalcTextSize(net_name.c_str());
-        ImVec2 diode_text_size = diode_reading.empty() ? ImVec2(0,0) : ImGui::CalcTextSize(diode_reading.c_str());
+        ImVec2 diode_text_size = diode_reading.empty() ? ImVec2(0,0) : CalcTextSize(diode_reading);
         
         // **DIODE READING POSITIONING** - Position slightly above pin number
         if (!diode_reading.empty()) {
@@ -1756,33 +2743,36 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
             draw_list->AddRect(bg_min, bg_max, IM_COL32(0, 0, 0, 100));
             
             // Black text on white background for maximum contrast
-            draw_list->AddText(diode_pos, IM_COL32(0, 0, 0, 255), diode_reading.c_str());
+            AddText(draw_list, diode_pos, IM_COL32(0, 0, 0, 255), diode_reading);
         }
         
         // Calculate maximum text dimensions that fit in pin area (with margin)
         float max_text_width = pin_width * 0.95f;   // Use ~95% of pin width for text
         float max_text_height = pin_height * 0.95f; // Use ~95% of pin height for text
         
-        // Helper function to break text into multiple lines if needed
-        auto breakTextIntoLines = [&](const std::string& text, float max_width) -> std::vector<std::string> {
-            std::vector<std::string> lines;
+        // Helper function to break text into multiple lines if needed (lines live in the frame arena)
+        auto breakTextIntoLines = [&](std::string_view text, float max_width) -> TextLines {
+            TextLines lines;
             if (text.empty()) return lines;
             
-            ImVec2 text_size = ImGui::CalcTextSize(text.c_str());
+            // A text never splits into more lines than it has characters
+            std::string_view* storage = frame_arena.AllocateArray<std::string_view>(text.size());
+            lines.line = storage;
+            
+            ImVec2 text_size = CalcTextSize(text);
             if (text_size.x <= max_width) {
-                lines.push_back(text);
+                storage[lines.count++] = text;
                 return lines;
             }
             
             // Text is too wide, try to break it intelligently
-            std::string remaining = text;
+            std::string_view remaining = text;
             while (!remaining.empty()) {
-                // Find the longest substring that fits
+                // Find the longest prefix that fits
                 size_t best_break = 0;
                 for (size_t i = 1; i <= remaining.length(); ++i) {
-                    std::string substr = remaining.substr(0, i);
-                    ImVec2 substr_size = ImGui::CalcTextSize(substr.c_str());
-                    if (substr_size.x <= max_width) {
+                    ImVec2 prefix_size = CalcTextSize(remaining.substr(0, i));
+                    if (prefix_size.x <= max_width) {
                         best_break = i;
                     } else {
                         break;
@@ -1807,24 +2797,24 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
                     best_break = last_good_break;
                 }
                 
-                lines.push_back(remaining.substr(0, best_break));
-                remaining = remaining.substr(best_break);
+                storage[lines.count++] = remaining.substr(0, best_break);
+                remaining.remove_prefix(best_break);
             }
             
             return lines;
         };
         
         // Break texts into lines if needed
-        std::vector<std::string> pin_lines = breakTextIntoLines(pin_number, max_text_width);
-        std::vector<std::string> net_lines = breakTextIntoLines(net_name, max_text_width);
+        TextLines pin_lines = breakTextIntoLines(pin_number, max_text_width);
+        TextLines net_lines = breakTextIntoLines(net_name, max_text_width);
         
         // Calculate total heights for multiline text
-        float pin_text_height = pin_lines.empty() ? 0.0f : pin_lines.size() * ImGui::GetTextLineHeight();
-        float net_text_height = net_lines.empty() ? 0.0f : net_lines.size() * ImGui::GetTextLineHeight();
+        float pin_text_height = pin_lines.count * ImGui::GetTextLineHeight();
+        float net_text_height = net_lines.count * ImGui::GetTextLineHeight();
         
         // Check if texts fit within the pin
-        bool show_pin_text = !pin_lines.empty() && pin_text_height <= max_text_height;
-        bool show_net_text = !net_lines.empty() && net_text_height <= max_text_height;
+        bool show_pin_text = pin_lines.count > 0 && pin_text_height <= max_text_height;
+        bool show_net_text = net_lines.count > 0 && net_text_height <= max_text_height;
         
         // If we have both texts, check if they fit stacked vertically
         if (show_pin_text && show_net_text) {
@@ -1862,20 +2852,22 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
             
             // Position pin number lines
             float current_y = pin_start_y;
-            for (const auto& line : pin_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
+            for (size_t line_index = 0; line_index < pin_lines.count; ++line_index) {
+                std::string_view line = pin_lines.line[line_index];
+                ImVec2 line_size = CalcTextSize(line);
                 ImVec2 pin_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(pin_text_pos, IM_COL32(255, 255, 255, 255), line.c_str());
+                AddText(draw_list, pin_text_pos, IM_COL32(255, 255, 255, 255), line);
                 current_y += ImGui::GetTextLineHeight();
             }
             
             current_y += text_spacing;
             
             // Position net name lines at BOTTOM of circle (YELLOW text for visibility)
-            for (const auto& line : net_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
+            for (size_t line_index = 0; line_index < net_lines.count; ++line_index) {
+                std::string_view line = net_lines.line[line_index];
+                ImVec2 line_size = CalcTextSize(line);
                 ImVec2 net_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(net_text_pos, IM_COL32(255, 255, 0, 255), line.c_str());
+                AddText(draw_list, net_text_pos, IM_COL32(255, 255, 0, 255), line);
                 current_y += ImGui::GetTextLineHeight();
             }
         }
@@ -1884,20 +2876,22 @@ void PCBRenderer::RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, floa
             float pin_start_y = y - pin_text_height * 0.5f;
             
             float current_y = pin_start_y;
-            for (const auto& line : pin_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
+            for (size_t line_index = 0; line_index < pin_lines.count; ++line_index) {
+                std::string_view line = pin_lines.line[line_index];
+                ImVec2 line_size = CalcTextSize(line);
                 ImVec2 pin_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(pin_text_pos, IM_COL32(255, 255, 255, 255), line.c_str());
+                AddText(draw_list, pin_text_pos, IM_COL32(255, 255, 255, 255), line);
                 current_y += ImGui::GetTextLineHeight();
             }
         }
         else if (show_net_text) {
             // Only net name - center it (diode reading can still be above)
             float current_y = y - net_text_height * 0.5f;
-            for (const auto& line : net_lines) {
-                ImVec2 line_size = ImGui::CalcTextSize(line.c_str());
+            for (size_t line_index = 0; line_index < net_lines.count; ++line_index) {
+                std::string_view line = net_lines.line[line_index];
+                ImVec2 line_size = CalcTextSize(line);
                 ImVec2 net_text_pos(x - line_size.x * 0.5f, current_y);
-                draw_list->AddText(net_text_pos, IM_COL32(255, 255, 0, 255), line.c_str());
+                AddText(draw_list, net_text_pos, IM_COL32(255, 255, 0, 255), line);
                 current_y += ImGui::GetTextLineHeight();
             }
         }
@@ -1,10 +1,55 @@
 #pragma once
 
 #include "BRDFileBase.h"
+#include "CullKernel.h"
+#include "FrameArena.h"
+#include "FrameProfiler.h"
+#include "PanCache.h"
 #include <GL/glew.h>
+#include <cstdint>
 #include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <imgui.h>
 
+class ThreadPool;
+
+// Pad level-of-detail, chosen from the on-screen size of a typical pad
+enum class PadDetailLevel {
+    Density,   // Sub-pixel pads: per-tile density quads
+    Clusters,  // Few-pixel pads: part bounding boxes, lone pads as point sprites
+    Full       // Full pad shapes
+};
+
+// Pad shape kinds understood by the instanced pad shader
+enum class PadShapeKind : unsigned int {
+    Circle = 0,
+    Rectangle = 1,
+    Oval = 2      // Stadium (rectangle with semicircular ends)
+};
+
+// CPU pad geometry for one slice of a shape list, built on a worker thread and spliced into
+// the window draw list in slice order. Runs split the buffers so each fits 16-bit indices.
+struct PadGeometryChunk {
+    VisibleSet visible;
+    std::vector<ImDrawVert> vertices;
+    std::vector<ImDrawIdx> indices;                               // Relative to the start of their run
+    std::vector<std::pair<unsigned int, unsigned int>> run_ends;  // (vertex end, index end) per run
+};
+
+// Element counts of a board that the renderer's caches cover. Index-only boards only ever
+// append parts, pins, pads and part outlines, so a batch of pending parts extends the caches
+// from these counts instead of rebuilding them.
+struct BoardCacheCounts {
+    size_t parts = 0;
+    size_t pins = 0;
+    size_t circles = 0;
+    size_t rectangles = 0;
+    size_t ovals = 0;
+    size_t part_outline_segments = 0;
+};
+
 struct Camera {
     float x = 0.0f;
     float y = 0.0f;
@@ -23,6 +68,26 @@ struct RenderSettings {
     float pin_alpha = 1.0f;
     float outline_alpha = 1.0f;
     float part_outline_alpha = 1.0f;
+
+    // Pad level-of-detail (thresholds are the typical pad size in screen pixels)
+    bool pad_lod = true;
+    float lod_full_shape_px = 4.0f;    // Full shapes at or above this size
+    float lod_cluster_px = 1.0f;       // Part boxes / point sprites at or above this size
+    float lod_hysteresis = 0.25f;      // Fractional dead band around each threshold
+    float lod_density_tile_px = 6.0f;  // Tile size of the density quads
+    
+    // Draw pads with the retained instanced GL renderer when it is available
+    bool gpu_pads = true;
+    
+    // Threads used to build the CPU draw lists (0 = one per core, 1 = main thread only)
+    int render_threads = 0;
+    
+    // Keep the static layers in an offscreen image and only redraw exposed strips while panning
+    bool pan_cache = true;
+    
+    // Time budget for drawing the static layers each frame (0 = draw everything every frame).
+    // Work that does not fit is continued on the next frames; needs the pan cache.
+    float frame_budget_ms = 12.0f;
     
     struct {
         float r = 0.2f, g = 0.8f, b = 0.2f;  // Green
@@ -45,10 +110,11 @@ struct RenderSettings {
 };
 
 // Structure to hold part name rendering information
+// (text points into the board data, so a record is cheap to rebuild every frame)
 struct PartNameInfo {
     ImVec2 position;
     ImVec2 size;
-    std::string text;
+    std::string_view text;
     ImU32 color;
     ImVec2 clip_min;
     ImVec2 clip_max;
@@ -59,8 +125,8 @@ struct PartNameInfo {
 struct PinNumberInfo {
     ImVec2 position;
     ImVec2 size;
-    std::string pin_number;
-    std::string net_name;
+    std::string_view pin_number;
+    std::string_view net_name;
     ImU32 pin_color;
     ImU32 net_color;
     ImU32 background_color;
@@ -78,13 +144,22 @@ public:
     
     void SetPCBData(std::shared_ptr<BRDFileBase> pcb_data);
     void Render(int window_width, int window_height);
+    const FrameProfiler& GetFrameProfiler() const { return frame_profiler; }
     
     // ImGui-based rendering methods (like original OpenBoardView)
-    void RenderOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
-    void RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
-    void RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
-    void RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
-    void RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
+    // Static layer passes; [begin, end) restricts a pass to part of its element list (progressive rendering)
+    void RenderOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                            size_t begin = 0, size_t end = SIZE_MAX);
+    void RenderPartOutlineImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                                size_t begin = 0, size_t end = SIZE_MAX);
+    void RenderCirclePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                               size_t begin = 0, size_t end = SIZE_MAX);
+    void RenderRectanglePinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                                  size_t begin = 0, size_t end = SIZE_MAX);
+    void RenderOvalPinsImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                             size_t begin = 0, size_t end = SIZE_MAX);
+    void RenderPadClustersImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height); // LOD: part boxes + point sprites
+    void RenderPadDensityImGui(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);  // LOD: per-tile density quads
     void RenderPartNamesOnTop(ImDrawList* draw_list);  // Render collected part names on top
     void RenderPinNumbersAsText(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height); // Render pin numbers as text overlays
     void CollectPartNamesForRendering(float zoom, float offset_x, float offset_y); // Collect part names for rendering
@@ -109,12 +184,103 @@ public:
     // Settings
     RenderSettings& GetSettings() { return settings; }
     const Camera& GetCamera() const { return camera; }
+    PadDetailLevel GetPadDetailLevel() const { return pad_detail_level; }
+    
+    // True while a frame-budgeted redraw of the static layers is still being completed
+    bool IsRefining() const { return !IsStaticCursorDone(static_cursor); }
 
 private:
-    // OpenGL objects
+    // Benchmarks time the cache builds directly (benchmarks/RendererBenchmarks.cpp)
+    friend class RendererBenchmarkAccess;
+
+    // OpenGL objects (instanced pad renderer)
     GLuint shader_program = 0;
     GLuint vao = 0;
-    GLuint vbo = 0;
+    GLuint vbo = 0;            // Unit quad corners
+    GLuint instance_vbo = 0;   // Per-pad instance data, uploaded once per board and appended to
+    GLuint style_texture = 0;  // Per-pin RGBA colour, built once per board
+    GLint transform_loc = -1;
+    GLint viewport_loc = -1;
+    GLint style_loc = -1;
+    bool gpu_pads_ready = false;
+    GLsizei pad_instance_count = 0;
+    GLsizei pad_instance_capacity = 0;  // Instances instance_vbo has room for
+    int style_texture_height = 0;
+    
+    // Per-pad instance layout in instance_vbo
+    struct PadInstance {
+        float center_x, center_y;   // Board units
+        float half_width, half_height;
+        float rotation;             // Radians, applied in screen space like the CPU passes
+        unsigned int shape;         // PadShapeKind
+        unsigned int style;         // Texel index in style_texture (pin index + 1, or the default slot 0)
+    };
+    
+    // Screen transform captured for the draw-list callback of the current frame
+    struct GPUFrameState {
+        float zoom = 1.0f;
+        float offset_x = 0.0f;
+        float offset_y = 0.0f;
+        int width = 0;
+        int height = 0;
+        int viewport_x = 0;       // Framebuffer viewport for the draw; width 0 keeps the backend's
+        int viewport_y = 0;
+        int viewport_width = 0;
+        int viewport_height = 0;
+    } gpu_frame;
+    
+    // Static layer cache (outlines + pads) reused across pans. Selection and hover are drawn
+    // as overlays on top of it, so they never invalidate the cached image.
+    PanCache pan_cache;
+    std::unique_ptr<ImDrawList> static_draw_list;
+    ImDrawData static_draw_data;
+    struct StaticLayerKey {
+        float zoom = 0.0f;
+        int window_width = 0;
+        int window_height = 0;
+        unsigned int data_generation = 0;
+        PadDetailLevel detail = PadDetailLevel::Full;
+        bool part_outlines = false;
+        bool gpu_pads = false;
+        
+        bool operator==(const StaticLayerKey& other) const {
+            return zoom == other.zoom && window_width == other.window_width && window_height == other.window_height &&
+                   data_generation == other.data_generation &&
+                   detail == other.detail && part_outlines == other.part_outlines && gpu_pads == other.gpu_pads;
+        }
+    } static_cache_key;
+    bool static_cache_valid = false;
+    bool pan_cache_failed = false;
+    float static_cache_offset_x = 0.0f;   // Screen offset the cached image was drawn with
+    float static_cache_offset_y = 0.0f;
+    unsigned int data_generation = 0;
+    // Pending parts parsed per frame on index-only boards; doubles while parts keep streaming in
+    size_t pending_part_batch = 0;
+    
+    // Progress through the static layers in priority order: board outline, part outlines
+    // (longest segments first), then pads. Pads count as one element per shape at full detail
+    // (circles, then rectangles, then ovals) and as a single element on the GPU/LOD paths.
+    enum class StaticStage : int {
+        Outline = 0,
+        PartOutlines,
+        Pads,
+        Done
+    };
+    struct StaticCursor {
+        StaticStage stage = StaticStage::Outline;
+        size_t element = 0;
+    };
+    StaticCursor static_cursor = { StaticStage::Done, 0 };  // How much of the cached image is drawn
+    std::vector<uint32_t> part_outline_order;                // Cull slot -> part outline segment
+    double frame_start_time = 0.0;                            // Seconds, for the frame budget
+    
+    // Region of the window currently being drawn into the cache (GPU pads need its viewport)
+    struct {
+        bool active = false;
+        int x = 0, y = 0;
+        int width = 0, height = 0;
+        int window_height = 0;
+    } static_region;
     
     // Data
     std::shared_ptr<BRDFileBase> pcb_data;
@@ -125,17 +291,100 @@ private:
     int selected_pin_index = -1;  // -1 means no selection
     int hovered_pin_index = -1;   // -1 means no hover
     
+    // Selection overlay, rebuilt only when the selected pin changes
+    struct HighlightBox {
+        float min_x, min_y, max_x, max_y;  // Board units
+    };
+    int overlay_selection = -2;               // Selection the overlay was built for (-2 = never built)
+    std::vector<int> highlighted_pins;        // Pins on the selected net
+    std::vector<HighlightBox> highlight_boxes; // Parts with pins on the selected net
+    PadGeometryChunk overlay_chunk;
+    
     // Performance optimization caches
     struct PinGeometryCache {
         size_t circle_index = SIZE_MAX;
         size_t rectangle_index = SIZE_MAX;
         size_t oval_index = SIZE_MAX;
+        uint32_t pad_stack = UINT32_MAX;  // Index into pcb_data->pad_stacks
         float radius = 0.0f;
+        float extent_x = 0.0f;  // Half extents of the pad (rotation applied)
+        float extent_y = 0.0f;
+        bool has_geometry = false;
         bool is_ground = false;
         bool is_nc = false;
     };
     std::vector<PinGeometryCache> pin_geometry_cache;
     
+    // Pad-cluster bounds per part (indexed by BRDPin::part), used by the LOD passes
+    struct PartBoundsCache {
+        float min_x = 0.0f, min_y = 0.0f;
+        float max_x = 0.0f, max_y = 0.0f;
+        unsigned int pad_count = 0;
+    };
+    std::vector<PartBoundsCache> part_bounds_cache;
+    
+    // Label box per part (indexed like pcb_data->parts), board units with the pin margin applied
+    struct PartLabelCache {
+        float min_x = 0.0f, min_y = 0.0f;
+        float max_x = 0.0f, max_y = 0.0f;
+        bool show = false;  // Named and not a single-pin part
+    };
+    std::vector<PartLabelCache> part_label_cache;
+    
+    // Element counts the caches above (and the cull sets and pad instances) were built for
+    BoardCacheCounts cached_counts;
+    std::vector<float> pad_sizes;   // Smaller dimension of every pad with geometry (typical_pad_size)
+    
+    // Per-frame scratch memory and allocation/timing checks
+    FrameArena frame_arena;
+    FrameProfiler frame_profiler;
+    struct FrameInputs {
+        float camera_x = 0.0f, camera_y = 0.0f, zoom = 0.0f;
+        int window_width = 0, window_height = 0;
+        unsigned int data_generation = 0;
+        int selected_pin = -1;
+        int hovered_pin = -1;
+        bool refining = false;
+        bool part_outlines = false, gpu_pads = false, pan_cache = false;
+        float frame_budget_ms = 0.0f;
+        PadDetailLevel detail = PadDetailLevel::Full;
+        
+        bool operator==(const FrameInputs& other) const {
+            return camera_x == other.camera_x && camera_y == other.camera_y && zoom == other.zoom &&
+                   window_width == other.window_width && window_height == other.window_height &&
+                   data_generation == other.data_generation && selected_pin == other.selected_pin &&
+                   hovered_pin == other.hovered_pin && refining == other.refining &&
+                   part_outlines == other.part_outlines && gpu_pads == other.gpu_pads && pan_cache == other.pan_cache &&
+                   frame_budget_ms == other.frame_budget_ms && detail == other.detail;
+        }
+    } last_frame_inputs;
+    int unchanged_frames = 0;  // Consecutive frames with identical inputs
+    
+    // Worker pool for draw-list construction (null when running single-threaded)
+    std::unique_ptr<ThreadPool> render_pool;
+    std::vector<PadGeometryChunk> pad_chunks;
+    
+    // SoA copies of element centres/cull radii and the per-pass visible lists produced from them
+    // (pad passes keep their visible lists in pad_chunks)
+    CullElements circle_cull;
+    CullElements rectangle_cull;
+    CullElements oval_cull;
+    CullElements pin_cull;                     // Pins in Z-order, see pin_cull_order
+    CullElements outline_cull;
+    CullElements part_outline_cull;
+    VisibleSet visible_pins;
+    VisibleSet visible_pin_labels;
+    VisibleSet visible_outline;
+    VisibleSet visible_part_outline;
+    std::vector<uint32_t> pin_cull_order;      // Cull slot -> pin index
+    VisibleSet visible_hits;
+    std::vector<uint32_t> hit_candidates;      // Pins near the cursor, for hover and click tests
+    
+    // Level-of-detail state
+    PadDetailLevel pad_detail_level = PadDetailLevel::Full;
+    float typical_pad_size = 0.0f;       // Median pad size in world units
+    std::vector<float> density_tiles;    // Reused per-frame tile accumulator
+    
     // Part name rendering (collected during rendering, drawn on top)
     std::vector<PartNameInfo> part_names_to_render;
     
@@ -146,6 +395,42 @@ private:
     bool CreateShaderProgram();
     GLuint CompileShader(const char* source, GLenum type);
     
+    // Instanced pad renderer. The upload and the style texture cover the pads / pins from the
+    // given counts on; zero counts rebuild them.
+    void UploadPadInstances(const BoardCacheCounts& from = BoardCacheCounts());
+    void UpdatePadStyleTexture(size_t first_pin = 0);
+    void RenderPadsGPU(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
+    void DrawPadInstances();
+    static void DrawPadInstancesCallback(const ImDrawList* parent_list, const ImDrawCmd* cmd);
+    
+    // Frame body; Render wraps it with the frame profiler
+    void RenderFrame(int window_width, int window_height);
+    
+    // Static layers and the pan cache
+    void RenderStaticLayers(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
+    void RenderStaticLayers(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height,
+                            const StaticCursor& from, const StaticCursor& to);
+    bool UpdatePanCache(float zoom, float offset_x, float offset_y, int window_width, int window_height);
+    void RenderStaticRegion(int x, int y, int region_width, int region_height, float zoom, float offset_x, float offset_y,
+                            int window_width, int window_height, const StaticCursor& from, const StaticCursor& to);
+    ImDrawList* BeginStaticRegion(int x, int y, int region_width, int region_height, int window_height);
+    void EndStaticRegion(int x, int y, int window_width, int window_height);
+    void RefineStaticLayers(float zoom, float offset_x, float offset_y, int window_width, int window_height);
+    
+    // Static layer cursor helpers
+    size_t GetStaticStageSize(StaticStage stage) const;
+    StaticCursor NormalizeStaticCursor(StaticCursor cursor) const;
+    bool IsStaticCursorDone(const StaticCursor& cursor) const { return NormalizeStaticCursor(cursor).stage == StaticStage::Done; }
+    
+    // Pad colour resolution shared by the GPU style texture and the CPU passes
+    StringRef GetSelectedNet() const;   // Empty when no pin or an unconnected pin is selected
+    void ResolvePadColor(int pin_index, float& r, float& g, float& b, float& a) const;
+    
+    // Selection and hover overlays drawn over the static layers
+    void UpdateSelectionOverlay();
+    void RenderNetHighlightOverlay(ImDrawList* draw_list, float zoom, float offset_x, float offset_y, int window_width, int window_height);
+    void RenderHoverRing(ImDrawList* draw_list, float zoom, float offset_x, float offset_y);
+    
     // Rendering methods
     void RenderBackground();
     void RenderOutline();
@@ -153,13 +438,24 @@ private:
     void RenderPins();
     // Enhanced rendering methods
     void RenderPartOutline(const BRDPart& part, const std::vector<BRDPin>& part_pins);
-    float DeterminePinMargin(const BRDPart& part, const std::vector<BRDPin>& part_pins, float distance);
+    float DeterminePinMargin(const BRDPart& part, size_t pin_count, float distance);
     float DeterminePinSize(const BRDPart& part, const std::vector<BRDPin>& part_pins);
     void RenderGenericComponentOutline(float min_x, float min_y, float max_x, float max_y, float margin);
     void RenderConnectorComponentImGui(ImDrawList* draw_list, const BRDPart& part, const std::vector<BRDPin>& part_pins, float zoom, float offset_x, float offset_y);
     
-    // Performance optimization methods
-    void BuildPinGeometryCache();
+    // Performance optimization methods: each builds its cache for the elements from `from` on
+    // and keeps what it built for earlier ones (zero counts rebuild it)
+    void BuildPinGeometryCache(const BoardCacheCounts& from = BoardCacheCounts());
+    void BuildPartBoundsCache(const BoardCacheCounts& from = BoardCacheCounts());
+    void BuildPartLabelCache(const BoardCacheCounts& from = BoardCacheCounts());
+    void BuildCullElements(const BoardCacheCounts& from = BoardCacheCounts());
+    BoardCacheCounts CountCachedElements() const;
+    // Index-only boards: parses the pending parts around the view and extends the caches.
+    // Called between frames.
+    void LoadVisiblePendingParts(int window_width, int window_height);
+    template <typename EmitFn>
+    void BuildPadGeometry(ImDrawList* draw_list, const CullElements& elements, size_t begin, size_t end, const ScreenTransform& view, EmitFn&& emit);
+    void UpdatePadDetailLevel(float zoom);
     bool IsElementVisible(float x, float y, float radius, float zoom, float offset_x, float offset_y, int window_width, int window_height);
     
     // Pin utilities
@@ -173,6 +469,8 @@ private:
                       int window_width, int window_height);
     void ScreenToWorld(float screen_x, float screen_y, float& world_x, float& world_y,
                       int window_width, int window_height);
+    // Pins whose cull box contains the world point, ascending, into hit_candidates
+    void CollectHitCandidates(float world_x, float world_y);
     
     // Utility
     void SetProjectionMatrix(int window_width, int window_height);
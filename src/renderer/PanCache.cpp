@@ -0,0 +1,113 @@
+#include "PanCache.h"
+#include "Utils.h"
+
+PanCache::~PanCache() {
+    Release();
+}
+
+bool PanCache::EnsureSize(int framebuffer_width, int framebuffer_height) {
+    if (framebuffer_width <= 0 || framebuffer_height <= 0) {
+        return false;
+    }
+    if (IsValid() && framebuffer_width == width && framebuffer_height == height) {
+        return true;
+    }
+
+    Release();
+
+    GLint previous_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
+    glGenFramebuffers(2, framebuffers);
+    glGenRenderbuffers(2, colorbuffers);
+    bool complete = true;
+    for (int i = 0; i < 2; ++i) {
+        glBindRenderbuffer(GL_RENDERBUFFER, colorbuffers[i]);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, framebuffer_width, framebuffer_height);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[i]);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorbuffers[i]);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            complete = false;
+        }
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer);
+
+    if (!complete) {
+        LOG_ERROR("Pan cache framebuffer is incomplete - panning will redraw every frame");
+        Release();
+        return false;
+    }
+
+    width = framebuffer_width;
+    height = framebuffer_height;
+    front = 0;
+    return true;
+}
+
+void PanCache::Release() {
+    if (framebuffers[0]) {
+        glDeleteFramebuffers(2, framebuffers);
+        framebuffers[0] = framebuffers[1] = 0;
+    }
+    if (colorbuffers[0]) {
+        glDeleteRenderbuffers(2, colorbuffers);
+        colorbuffers[0] = colorbuffers[1] = 0;
+    }
+    width = height = 0;
+    front = 0;
+}
+
+void PanCache::Scroll(int dx, int dy, float clear_r, float clear_g, float clear_b) {
+    if (!IsValid()) {
+        return;
+    }
+    int back = 1 - front;
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[back]);
+    glDisable(GL_SCISSOR_TEST);
+    glClearColor(clear_r, clear_g, clear_b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // GL rows grow upwards, screen rows downwards
+    int gl_dy = -dy;
+    int src_x0 = dx < 0 ? -dx : 0;
+    int src_y0 = gl_dy < 0 ? -gl_dy : 0;
+    int copy_width = width - (dx < 0 ? -dx : dx);
+    int copy_height = height - (gl_dy < 0 ? -gl_dy : gl_dy);
+    if (copy_width > 0 && copy_height > 0) {
+        int dst_x0 = src_x0 + dx;
+        int dst_y0 = src_y0 + gl_dy;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[front]);
+        glBlitFramebuffer(src_x0, src_y0, src_x0 + copy_width, src_y0 + copy_height,
+                          dst_x0, dst_y0, dst_x0 + copy_width, dst_y0 + copy_height,
+                          GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    front = back;
+}
+
+void PanCache::ClearRegion(int x, int y, int region_width, int region_height, float clear_r, float clear_g, float clear_b) {
+    if (!IsValid() || region_width <= 0 || region_height <= 0) {
+        return;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[front]);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(x, height - (y + region_height), region_width, region_height);
+    glClearColor(clear_r, clear_g, clear_b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void PanCache::PresentToScreen() {
+    if (!IsValid()) {
+        return;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[front]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glDisable(GL_SCISSOR_TEST);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// Offscreen copy of the static board layers, used to make panning cheap.
+// Two colour targets are kept: scrolling copies the front image into the back one at an
+// offset (glBlitFramebuffer), then the back becomes the front and only the exposed strips
+// need to be drawn again.
+class PanCache {
+public:
+    PanCache() = default;
+    ~PanCache();
+
+    PanCache(const PanCache&) = delete;
+    PanCache& operator=(const PanCache&) = delete;
+
+    // (Re)creates the targets when the framebuffer size changes; false if FBOs are unusable
+    bool EnsureSize(int framebuffer_width, int framebuffer_height);
+    void Release();
+
+    bool IsValid() const { return framebuffers[0] != 0; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+    // Framebuffer holding the current cached image
+    GLuint GetFrontFramebuffer() const { return framebuffers[front]; }
+
+    // Moves the cached image by (dx, dy) framebuffer pixels (screen orientation, +y down).
+    // Pixels that scroll in are cleared to the given colour.
+    void Scroll(int dx, int dy, float clear_r, float clear_g, float clear_b);
+
+    // Clears a region (screen orientation, framebuffer pixels) of the front image
+    void ClearRegion(int x, int y, int region_width, int region_height, float clear_r, float clear_g, float clear_b);
+
+    // Copies the cached image to the default framebuffer
+    void PresentToScreen();
+
+private:
+    GLuint framebuffers[2] = { 0, 0 };
+    GLuint colorbuffers[2] = { 0, 0 };
+    int front = 0;
+    int width = 0;
+    int height = 0;
+};
@@ -0,0 +1,125 @@
+// board_index_test: per-part pin lookups (BoardIndex and the C API) on a generated board
+// whose part sizes are known. Exits non-zero on the first mismatch.
+#include "BoardIndex.h"
+#include "XZZPCBFile.h"
+#include "XZZPCBGenerator.h"
+#include "Log.h"
+#include "pcbcore.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    int failures = 0;
+
+    void Check(bool condition, const std::string& what) {
+        if (!condition) {
+            std::fprintf(stderr, "FAIL: %s\n", what.c_str());
+            failures++;
+        }
+    }
+
+    XZZPCBGenerator::Options BoardOptions() {
+        XZZPCBGenerator::Options options;
+        options.pin_count = 3000;
+        options.net_count = 300;
+        options.test_pad_count = 40;
+        options.ic_fraction = 0.2;     // Plenty of parts much larger than their neighbours
+        options.max_ic_pins = 64;
+        options.seed = 7;
+        return options;
+    }
+
+    // Parts in file order, then one single-pin part per test pad
+    std::vector<uint32_t> ExpectedPartPins(const XZZPCBGenerator::Stats& stats) {
+        std::vector<uint32_t> expected = stats.part_pins;
+        expected.insert(expected.end(), stats.test_pads, 1);
+        return expected;
+    }
+
+    void CheckIndex(const XZZPCBFile& board, const std::vector<uint32_t>& expected) {
+        Check(board.parts.size() == expected.size(), "part count");
+        BoardIndex index(board);
+        for (uint32_t part = 0; part < board.parts.size() && part < expected.size(); ++part) {
+            BoardIndex::PinRange pins = index.GetPartPins(part);
+            std::string name(board.GetString(board.parts[part].name));
+            Check(pins.count == expected[part], "pin count of part " + std::to_string(part) + " (" + name + "): " +
+                  std::to_string(pins.count) + ", expected " + std::to_string(expected[part]));
+            for (uint32_t i = 0; i < pins.count; ++i) {
+                Check(board.pins[pins.pins[i]].part == part + 1, "pin of part " + name + " belongs to another part");
+            }
+        }
+    }
+
+    void CheckApi(const std::vector<char>& file, const std::vector<uint32_t>& expected) {
+        pcb_board* board = pcb_open_memory(file.data(), file.size());
+        Check(pcb_is_loaded(board) == 1, "pcb_open_memory");
+        Check(pcb_get_part_count(board) == expected.size(), "pcb_get_part_count");
+        for (uint32_t part = 0; part < pcb_get_part_count(board) && part < expected.size(); ++part) {
+            pcb_part_info info;
+            Check(pcb_get_part(board, part, &info) == 1, "pcb_get_part");
+            Check(info.pin_count == expected[part], std::string("pcb_get_part pin_count of ") + info.name);
+
+            const uint32_t* pins = nullptr;
+            uint32_t count = pcb_get_part_pins(board, part, &pins);
+            Check(count == expected[part], std::string("pcb_get_part_pins of ") + info.name);
+            for (uint32_t i = 0; i < count; ++i) {
+                pcb_pin_info pin;
+                Check(pcb_get_pin(board, pins[i], &pin) == 1 && pin.part == part,
+                      std::string("pcb_get_pin part of a pin of ") + info.name);
+                Check(pin.x >= info.x1 && pin.x <= info.x2 && pin.y >= info.y1 && pin.y <= info.y2,
+                      std::string("pin outside the box of ") + info.name);
+            }
+        }
+        pcb_close(board);
+    }
+}
+
+int main() {
+    Log::SetLevel(LogLevel::Off);
+
+    XZZPCBGenerator generator(BoardOptions());
+    std::vector<char> file = generator.Generate();
+    std::vector<uint32_t> expected = ExpectedPartPins(generator.GetStats());
+
+    XZZPCBFile board;
+    Check(board.Load(file), "load");
+    CheckIndex(board, expected);
+    CheckApi(file, expected);
+
+    // Index-only loads append parts as they are parsed, but every pin still names its part
+    XZZPCBFile::LoadOptions options;
+    options.mode = XZZPCBFile::LoadMode::IndexOnly;
+    XZZPCBFile deferred;
+    deferred.SetLoadOptions(options);
+    Check(deferred.Load(file), "index-only load");
+    // Names read before the deferred parts are parsed stay valid afterwards
+    Check(!deferred.parts.empty(), "index-only parts");
+    const char* first_name = deferred.parts.empty() ? "" : deferred.GetCString(deferred.parts[0].name);
+    std::string first_copy = first_name;
+    // A name lookup decrypts the pending names and parses only the part that carries it
+    std::string wanted(board.GetString(board.parts[board.parts.size() / 2].name));
+    size_t pending = deferred.GetPendingPartCount();
+    Check(deferred.LoadPendingPartsNamed(wanted) == 1, "LoadPendingPartsNamed of " + wanted);
+    Check(deferred.GetPendingPartCount() == pending - 1 && deferred.GetString(deferred.parts.back().name) == wanted,
+          "LoadPendingPartsNamed parsed " + wanted);
+    deferred.LoadAllPendingParts();
+    Check(first_copy == first_name, "part name changed by deferred parsing");
+    BoardIndex index(deferred);
+    uint32_t total = 0;
+    for (uint32_t part = 0; part < deferred.parts.size(); ++part) {
+        BoardIndex::PinRange pins = index.GetPartPins(part);
+        for (uint32_t i = 0; i < pins.count; ++i) {
+            Check(deferred.pins[pins.pins[i]].part == part + 1, "index-only pin of another part");
+        }
+        total += pins.count;
+    }
+    Check(total == deferred.pins.size(), "every index-only pin in a part");
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("board_index_test: %zu parts, %zu pins OK\n", board.parts.size(), board.pins.size());
+    return 0;
+}
@@ -0,0 +1,115 @@
+// inspect_inventory_test: runs pcb_inspect --inventory on a generated board and checks the
+// pin count of every listed part against the generator's plan.
+// Usage: inspect_inventory_test <pcb_inspect executable> <scratch directory>
+#include "XZZPCBGenerator.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    // Pin counts of the inventory's part list, in order
+    bool ReadInventoryPins(const std::string& path, std::vector<uint32_t>& pins) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream text;
+        text << file.rdbuf();
+        std::string record = text.str();
+
+        size_t begin = record.find("\"inventory\":{\"parts\":[");
+        size_t end = record.find("],\"nets\":[", begin);
+        if (begin == std::string::npos || end == std::string::npos) {
+            return false;
+        }
+        const std::string key = "\"pins\":";
+        for (size_t pos = record.find(key, begin); pos != std::string::npos && pos < end; pos = record.find(key, pos)) {
+            pos += key.size();
+            pins.push_back(static_cast<uint32_t>(std::strtoul(record.c_str() + pos, nullptr, 10)));
+        }
+        return true;
+    }
+
+    bool Inspect(const std::string& inspect, const std::string& board, const std::string& output, const char* flags,
+                 std::vector<uint32_t>& pins) {
+        std::string command = "\"" + inspect + "\" --inventory " + flags + " -o \"" + output + "\" \"" + board + "\"";
+        if (std::system(command.c_str()) != 0) {
+            std::fprintf(stderr, "FAIL: %s\n", command.c_str());
+            return false;
+        }
+        if (!ReadInventoryPins(output, pins)) {
+            std::fprintf(stderr, "FAIL: no inventory in %s\n", output.c_str());
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::fprintf(stderr, "Usage: inspect_inventory_test <pcb_inspect> <scratch directory>\n");
+        return 1;
+    }
+    const std::string inspect = argv[1];
+    const std::string board = std::string(argv[2]) + "/inventory_test.xzzpcb";
+    const std::string output = std::string(argv[2]) + "/inventory_test.jsonl";
+
+    XZZPCBGenerator::Options options;
+    options.pin_count = 2000;
+    options.net_count = 200;
+    options.test_pad_count = 20;
+    options.ic_fraction = 0.2;
+    options.max_ic_pins = 64;
+    options.seed = 11;
+    XZZPCBGenerator generator(options);
+    if (!generator.WriteToFile(board)) {
+        std::fprintf(stderr, "FAIL: cannot write %s\n", board.c_str());
+        return 1;
+    }
+    // Parts in file order, then one single-pin part per test pad
+    std::vector<uint32_t> expected = generator.GetStats().part_pins;
+    expected.insert(expected.end(), generator.GetStats().test_pads, 1);
+
+    int failures = 0;
+    std::vector<uint32_t> pins;
+    if (!Inspect(inspect, board, output, "", pins)) {
+        return 1;
+    }
+    if (pins != expected) {
+        size_t part = std::mismatch(pins.begin(), pins.end(), expected.begin(), expected.end()).first - pins.begin();
+        std::fprintf(stderr, "FAIL: inventory lists %zu parts (expected %zu); first wrong pin count at part %zu\n",
+                     pins.size(), expected.size(), part);
+        failures++;
+    }
+
+    // Index-only loads list the parts in the order they were parsed. The first one writes the
+    // part index file, the second takes the part boxes from it.
+    const std::string part_index = board + ".pcbindex";
+    std::remove(part_index.c_str());
+    std::sort(expected.begin(), expected.end());
+    for (const char* run : {"first", "second"}) {
+        pins.clear();
+        if (!Inspect(inspect, board, output, "--index-only", pins)) {
+            return 1;
+        }
+        std::sort(pins.begin(), pins.end());
+        if (pins != expected) {
+            std::fprintf(stderr, "FAIL: %s index-only inventory pin counts differ\n", run);
+            failures++;
+        }
+    }
+    if (!std::ifstream(part_index).is_open()) {
+        std::fprintf(stderr, "FAIL: no part index file %s\n", part_index.c_str());
+        failures++;
+    }
+
+    std::remove(part_index.c_str());
+    std::remove(board.c_str());
+    std::remove(output.c_str());
+    if (failures > 0) {
+        return 1;
+    }
+    std::printf("inspect_inventory_test: %zu parts OK\n", expected.size());
+    return 0;
+}
@@ -0,0 +1,631 @@
+#include "XZZPCBGenerator.h"
+#include "des.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    const uint32_t kScale = 10000;           // Raw coordinates are board units * 10000
+    const uint32_t kHeaderSize = 0x40;
+    const uint32_t kOutlineLayer = 28;
+    const uint32_t kTraceLayer = 1;
+
+    // Same key the parser derives in XZZPCBFile::des_decrypt
+    const uint64_t kDesKey = 0xDCFC12AC00000000ULL;
+
+    const uint8_t kPostV6Marker[] = {0x76, 0x36, 0x76, 0x36, 0x35, 0x35, 0x35, 0x76, 0x36, 0x76, 0x36};
+    const uint8_t kJsonMarker[] = {0x3D, 0x3D, 0x3D, 0x50, 0x43, 0x42, 0xB8, 0xBD, 0xBC, 0xD3, 0x0A};
+
+    void PutU8(std::vector<uint8_t>& out, uint8_t value) {
+        out.push_back(value);
+    }
+
+    void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+        uint8_t bytes[4] = {
+            static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)
+        };
+        out.insert(out.end(), bytes, bytes + 4);
+    }
+
+    void PutString(std::vector<uint8_t>& out, const std::string& text) {
+        out.insert(out.end(), text.begin(), text.end());
+    }
+
+    void PutZeros(std::vector<uint8_t>& out, size_t count) {
+        out.insert(out.end(), count, 0);
+    }
+
+    void PatchU32(std::vector<uint8_t>& out, size_t offset, uint32_t value) {
+        out[offset] = static_cast<uint8_t>(value);
+        out[offset + 1] = static_cast<uint8_t>(value >> 8);
+        out[offset + 2] = static_cast<uint8_t>(value >> 16);
+        out[offset + 3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    std::string GetNetName(uint32_t index) {
+        if (index == 0) {
+            return "NC";
+        }
+        if (index == 1) {
+            return "GND";
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "NET%05u", index);
+        return name;
+    }
+
+    uint32_t Raw(int value) {
+        return static_cast<uint32_t>(value) * kScale;
+    }
+
+    // Line payload shared by main 0x05 blocks and part outline sub-blocks
+    void PutLine(std::vector<uint8_t>& out, uint32_t layer, int x1, int y1, int x2, int y2) {
+        PutU32(out, layer);
+        PutU32(out, Raw(x1));
+        PutU32(out, Raw(y1));
+        PutU32(out, Raw(x2));
+        PutU32(out, Raw(y2));
+        PutU32(out, kScale);
+    }
+
+    // The parser reads each 8-byte block as a big-endian word, decrypts it and stores the
+    // result big-endian; encryption is the mirror image
+    void EncryptInPlace(std::vector<uint8_t>& data) {
+        for (size_t offset = 0; offset + 8 <= data.size(); offset += 8) {
+            uint64_t plain = 0;
+            for (int i = 0; i < 8; ++i) {
+                plain = (plain << 8) | data[offset + i];
+            }
+            uint64_t cipher = des(plain, kDesKey, 'e');
+            for (int i = 7; i >= 0; --i) {
+                data[offset + i] = static_cast<uint8_t>(cipher);
+                cipher >>= 8;
+            }
+        }
+    }
+}
+
+// Output with XOR obfuscation of everything before the post-v6 marker and
+// back-patching of sizes/offsets that are only known later
+class XZZPCBGenerator::Sink {
+public:
+    virtual ~Sink() = default;
+
+    void SetXorKey(uint8_t key) { xor_key = key; }
+
+    void Write(const uint8_t* data, size_t size) {
+        if (xor_key == 0) {
+            WriteRaw(data, size);
+            return;
+        }
+        uint8_t chunk[4096];
+        while (size > 0) {
+            size_t count = std::min(size, sizeof(chunk));
+            for (size_t i = 0; i < count; ++i) {
+                chunk[i] = data[i] ^ xor_key;
+            }
+            WriteRaw(chunk, count);
+            data += count;
+            size -= count;
+        }
+    }
+    void Write(const std::vector<uint8_t>& data) { Write(data.data(), data.size()); }
+
+    void PatchU32(uint64_t offset, uint32_t value) {
+        uint8_t bytes[4] = {
+            static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)
+        };
+        for (uint8_t& byte : bytes) {
+            byte ^= xor_key;
+        }
+        PatchRaw(offset, bytes, 4);
+    }
+
+    virtual uint64_t Tell() const = 0;
+    virtual bool Finish() { return true; }
+
+protected:
+    virtual void WriteRaw(const uint8_t* data, size_t size) = 0;
+    virtual void PatchRaw(uint64_t offset, const uint8_t* data, size_t size) = 0;
+
+private:
+    uint8_t xor_key = 0;
+};
+
+class XZZPCBGenerator::VectorSink : public XZZPCBGenerator::Sink {
+public:
+    explicit VectorSink(std::vector<char>& target) : out(target) {}
+
+    uint64_t Tell() const override { return out.size(); }
+
+protected:
+    void WriteRaw(const uint8_t* data, size_t size) override {
+        out.insert(out.end(), reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + size);
+    }
+    void PatchRaw(uint64_t offset, const uint8_t* data, size_t size) override {
+        std::memcpy(&out[static_cast<size_t>(offset)], data, size);
+    }
+
+private:
+    std::vector<char>& out;
+};
+
+class XZZPCBGenerator::FileSink : public XZZPCBGenerator::Sink {
+public:
+    explicit FileSink(const std::string& path) : file(path, std::ios::binary | std::ios::trunc) {
+        buffer.reserve(kBufferSize);
+    }
+
+    bool IsOpen() const { return file.is_open(); }
+    uint64_t Tell() const override { return flushed + buffer.size(); }
+
+    bool Finish() override {
+        Flush();
+        file.close();
+        return !file.fail();
+    }
+
+protected:
+    void WriteRaw(const uint8_t* data, size_t size) override {
+        if (buffer.size() + size > kBufferSize) {
+            Flush();
+        }
+        if (size > kBufferSize) {
+            file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            flushed += size;
+            return;
+        }
+        buffer.insert(buffer.end(), data, data + size);
+    }
+
+    void PatchRaw(uint64_t offset, const uint8_t* data, size_t size) override {
+        if (offset >= flushed) {
+            std::memcpy(&buffer[static_cast<size_t>(offset - flushed)], data, size);
+            return;
+        }
+        Flush();
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        file.seekp(0, std::ios::end);
+    }
+
+private:
+    static const size_t kBufferSize = 1 << 20;
+
+    void Flush() {
+        if (!buffer.empty()) {
+            file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            flushed += buffer.size();
+            buffer.clear();
+        }
+    }
+
+    std::ofstream file;
+    std::vector<uint8_t> buffer;
+    uint64_t flushed = 0;
+};
+
+XZZPCBGenerator::XZZPCBGenerator(const Options& generator_options) : options(generator_options) {
+    options.net_count = std::max<uint32_t>(options.net_count, 3);
+    if (options.circle_weight + options.oval_weight + options.rectangle_weight == 0) {
+        options.rectangle_weight = 1;
+    }
+}
+
+std::vector<char> XZZPCBGenerator::Generate() {
+    std::vector<char> out;
+    VectorSink sink(out);
+    Run(sink);
+    return out;
+}
+
+bool XZZPCBGenerator::WriteToFile(const std::string& path) {
+    FileSink sink(path);
+    if (!sink.IsOpen()) {
+        return false;
+    }
+    Run(sink);
+    return sink.Finish();
+}
+
+uint32_t XZZPCBGenerator::NextRandom() {
+    // splitmix64
+    rng_state += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = rng_state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<uint32_t>((z ^ (z >> 31)) >> 32);
+}
+
+uint32_t XZZPCBGenerator::RandomNet() {
+    uint32_t roll = NextRandom() % 100;
+    if (roll < 3) {
+        return 0;   // NC
+    }
+    if (roll < 18) {
+        return 1;   // GND
+    }
+    return 2 + NextRandom() % (options.net_count - 2);
+}
+
+uint8_t XZZPCBGenerator::RandomShape(uint32_t& width, uint32_t& height) {
+    uint32_t total = options.circle_weight + options.oval_weight + options.rectangle_weight;
+    uint32_t roll = NextRandom() % total;
+    if (roll < options.circle_weight) {
+        width = height = 6 + NextRandom() % 6;
+        return 1;
+    }
+    if (roll < options.circle_weight + options.oval_weight) {
+        width = 6 + NextRandom() % 6;
+        height = width + 4 + NextRandom() % 6;
+        return 1;
+    }
+    width = 6 + NextRandom() % 10;
+    height = 6 + NextRandom() % 10;
+    return 2;
+}
+
+std::string XZZPCBGenerator::GetPartName(uint32_t part_index) const {
+    uint32_t pin_count = parts[part_index].pin_count;
+    const char* prefix = pin_count > 4 ? "U" : (pin_count > 2 ? "Q" : (part_index % 2 ? "C" : "R"));
+    return prefix + std::to_string(part_index + 1);
+}
+
+void XZZPCBGenerator::PlanParts() {
+    parts.clear();
+    uint64_t remaining = options.pin_count;
+    while (remaining > 0) {
+        PartPlan plan;
+        double roll = (NextRandom() & 0xFFFFFF) / static_cast<double>(0x1000000);
+        if (roll < options.ic_fraction && options.max_ic_pins >= 8) {
+            plan.pin_count = 8 + 4 * (NextRandom() % ((options.max_ic_pins - 8) / 4 + 1));
+            plan.pitch = 10;
+        } else {
+            plan.pin_count = (NextRandom() % 4 == 0) ? 3 + NextRandom() % 2 : 2;
+            plan.pitch = 20;
+        }
+        plan.pin_count = static_cast<uint32_t>(std::min<uint64_t>(plan.pin_count, remaining));
+        remaining -= plan.pin_count;
+        parts.push_back(plan);
+    }
+
+    // Shelf packing into a roughly 4:3 board
+    auto footprint = [](const PartPlan& plan, int& w, int& h) {
+        if (plan.pin_count > 4) {
+            int side = static_cast<int>((plan.pin_count + 3) / 4) * plan.pitch + 2 * plan.pitch;
+            w = h = side;
+        } else {
+            w = static_cast<int>(plan.pin_count) * plan.pitch;
+            h = plan.pitch;
+        }
+    };
+    const int spacing = 20;
+    double area = 0.0;
+    for (const auto& plan : parts) {
+        int w, h;
+        footprint(plan, w, h);
+        area += static_cast<double>(w + spacing) * (h + spacing);
+    }
+    int row_width = std::max(200, static_cast<int>(std::sqrt(area * 4.0 / 3.0)));
+    const int margin = 100;
+    int x = margin;
+    int y = margin;
+    int row_height = 0;
+    for (auto& plan : parts) {
+        int w, h;
+        footprint(plan, w, h);
+        if (x + w > margin + row_width && x > margin) {
+            x = margin;
+            y += row_height + spacing;
+            row_height = 0;
+        }
+        plan.x = x;
+        plan.y = y;
+        x += w + spacing;
+        row_height = std::max(row_height, h);
+    }
+    board_width = row_width + 2 * margin;
+    board_height = y + row_height + margin;
+}
+
+void XZZPCBGenerator::Run(Sink& sink) {
+    stats = Stats();
+    rng_state = options.seed;
+    PlanParts();
+
+    // Header; byte 0x10 is 0 before obfuscation so it reads back as the XOR key
+    std::vector<uint8_t> header;
+    PutString(header, "XZZPCB");
+    PutZeros(header, kHeaderSize - header.size());
+    header[6] = 0x06;
+    PatchU32(header, 0x20, kHeaderSize - 0x20);   // Main data right after the header
+    sink.SetXorKey(options.xor_key);
+    sink.Write(header);
+
+    // Main blocks
+    uint64_t main_size_offset = sink.Tell();
+    std::vector<uint8_t> scratch;
+    PutU32(scratch, 0);
+    sink.Write(scratch);
+    WriteOutline(sink);
+    for (uint32_t i = 0; i < parts.size(); ++i) {
+        WritePart(sink, i, parts[i]);
+    }
+    for (uint32_t i = 0; i < options.test_pad_count; ++i) {
+        WriteTestPad(sink, i);
+    }
+    uint64_t main_end = sink.Tell();
+    sink.PatchU32(main_size_offset, static_cast<uint32_t>(main_end - main_size_offset - 4));
+
+    // Net block
+    sink.PatchU32(0x28, static_cast<uint32_t>(main_end - 0x20));
+    WriteNetBlock(sink);
+
+    if (options.json_trailer) {
+        WriteJsonTrailer(sink);
+    }
+    if (options.diode_trailer != DiodeTrailer::None) {
+        WriteDiodeTrailer(sink);
+    }
+
+    stats.parts = static_cast<uint32_t>(parts.size());
+    for (const auto& plan : parts) {
+        stats.part_pins.push_back(plan.pin_count);
+    }
+    stats.test_pads = options.test_pad_count;
+    stats.nets = options.net_count;
+    stats.file_bytes = sink.Tell();
+}
+
+void XZZPCBGenerator::WriteNetBlock(Sink& sink) {
+    std::vector<uint8_t> block;
+    PutU32(block, 0);
+    for (uint32_t i = 0; i < options.net_count; ++i) {
+        std::string name = GetNetName(i);
+        PutU32(block, static_cast<uint32_t>(name.size() + 8));
+        PutU32(block, i);
+        PutString(block, name);
+    }
+    PatchU32(block, 0, static_cast<uint32_t>(block.size() - 4));
+    sink.Write(block);
+}
+
+void XZZPCBGenerator::WriteOutline(Sink& sink) {
+    std::vector<uint8_t> block;
+    auto emit = [&](uint8_t type, const std::vector<uint8_t>& payload) {
+        block.clear();
+        PutU8(block, type);
+        PutU32(block, static_cast<uint32_t>(payload.size()));
+        block.insert(block.end(), payload.begin(), payload.end());
+        sink.Write(block);
+        stats.outline_blocks++;
+    };
+
+    // Rectangle with rounded corners: four lines and four quarter arcs
+    const int r = 40;
+    const int w = board_width;
+    const int h = board_height;
+    std::vector<uint8_t> payload;
+    int lines[4][4] = {{r, 0, w - r, 0}, {w, r, w, h - r}, {w - r, h, r, h}, {0, h - r, 0, r}};
+    for (auto& line : lines) {
+        payload.clear();
+        PutLine(payload, kOutlineLayer, line[0], line[1], line[2], line[3]);
+        PutU32(payload, 0);   // Net index
+        emit(0x05, payload);
+    }
+    int arcs[4][4] = {{r, r, 180, 270}, {w - r, r, 270, 360}, {w - r, h - r, 0, 90}, {r, h - r, 90, 180}};
+    for (auto& arc : arcs) {
+        payload.clear();
+        PutU32(payload, kOutlineLayer);
+        PutU32(payload, Raw(arc[0]));
+        PutU32(payload, Raw(arc[1]));
+        PutU32(payload, Raw(r));
+        PutU32(payload, Raw(arc[2]));
+        PutU32(payload, Raw(arc[3]));
+        PutU32(payload, kScale);
+        PutU32(payload, 0);
+        emit(0x01, payload);
+    }
+
+    // Copper traces on an inner layer: the parser reads and skips them, like on real boards
+    uint64_t trace_count = options.trace_count >= 0 ? static_cast<uint64_t>(options.trace_count) : options.pin_count / 2;
+    for (uint64_t i = 0; i < trace_count; ++i) {
+        int x1 = static_cast<int>(NextRandom() % static_cast<uint32_t>(w));
+        int y1 = static_cast<int>(NextRandom() % static_cast<uint32_t>(h));
+        int x2 = std::min(w, x1 + static_cast<int>(NextRandom() % 200));
+        payload.clear();
+        PutLine(payload, kTraceLayer, x1, y1, x2, y1);
+        PutU32(payload, RandomNet());
+        block.clear();
+        PutU8(block, 0x05);
+        PutU32(block, static_cast<uint32_t>(payload.size()));
+        block.insert(block.end(), payload.begin(), payload.end());
+        sink.Write(block);
+    }
+}
+
+void XZZPCBGenerator::WritePart(Sink& sink, uint32_t part_index, const PartPlan& plan) {
+    std::vector<uint8_t>& plain = part_plain;
+    plain.clear();
+    std::string name = GetPartName(part_index);
+    std::string group = plan.pin_count > 4 ? "QFN" : "0402";
+
+    PutU32(plain, 0);                  // Part size, patched below
+    PutZeros(plain, 18);
+    PutU32(plain, static_cast<uint32_t>(group.size()));
+    PutString(plain, group);
+
+    // 0x06 label sub-block carrying the part name (always first)
+    PutU8(plain, 0x06);
+    PutU32(plain, static_cast<uint32_t>(26 + 4 + name.size()));
+    PutZeros(plain, 26);
+    PutU32(plain, static_cast<uint32_t>(name.size()));
+    PutString(plain, name);
+
+    // ICs carry an opaque 0x01 sub-block the parser skips
+    if (plan.pin_count > 4) {
+        PutU8(plain, 0x01);
+        PutU32(plain, 8);
+        PutZeros(plain, 8);
+    }
+
+    // Pin positions: passives in a row, ICs on the four sides of a square
+    int w, h;
+    std::vector<std::pair<int, int>> positions;
+    positions.reserve(plan.pin_count);
+    if (plan.pin_count > 4) {
+        uint32_t per_side = (plan.pin_count + 3) / 4;
+        w = h = static_cast<int>(per_side) * plan.pitch + 2 * plan.pitch;
+        for (uint32_t i = 0; i < plan.pin_count; ++i) {
+            int side = static_cast<int>(i / per_side);
+            int step = static_cast<int>(i % per_side + 1) * plan.pitch;
+            switch (side) {
+                case 0: positions.push_back({plan.x + step, plan.y}); break;
+                case 1: positions.push_back({plan.x + w, plan.y + step}); break;
+                case 2: positions.push_back({plan.x + w - step, plan.y + h}); break;
+                default: positions.push_back({plan.x, plan.y + h - step}); break;
+            }
+        }
+    } else {
+        w = static_cast<int>(plan.pin_count) * plan.pitch;
+        h = plan.pitch;
+        for (uint32_t i = 0; i < plan.pin_count; ++i) {
+            positions.push_back({plan.x + plan.pitch / 2 + static_cast<int>(i) * plan.pitch, plan.y + h / 2});
+        }
+    }
+
+    // 0x05 outline sub-blocks
+    int box[4][4] = {{plan.x, plan.y, plan.x + w, plan.y}, {plan.x + w, plan.y, plan.x + w, plan.y + h},
+                     {plan.x + w, plan.y + h, plan.x, plan.y + h}, {plan.x, plan.y + h, plan.x, plan.y}};
+    for (auto& line : box) {
+        PutU8(plain, 0x05);
+        PutU32(plain, 24);
+        PutLine(plain, kOutlineLayer, line[0], line[1], line[2], line[3]);
+    }
+
+    // 0x09 pin sub-blocks
+    char pin_name[16];
+    for (uint32_t i = 0; i < plan.pin_count; ++i) {
+        std::snprintf(pin_name, sizeof(pin_name), "%u", i + 1);
+        size_t name_length = std::strlen(pin_name);
+        uint32_t pad_width = 0;
+        uint32_t pad_height = 0;
+        uint8_t shape = RandomShape(pad_width, pad_height);
+        bool rotated = plan.pin_count > 4 && (i / ((plan.pin_count + 3) / 4)) % 2 == 1;
+
+        PutU8(plain, 0x09);
+        PutU32(plain, static_cast<uint32_t>(60 + name_length));
+        PutU32(plain, 0);
+        PutU32(plain, Raw(positions[i].first));
+        PutU32(plain, Raw(positions[i].second));
+        PutU32(plain, 0);
+        PutU32(plain, Raw(rotated ? 90 : 0));
+        PutU32(plain, static_cast<uint32_t>(name_length));
+        plain.insert(plain.end(), pin_name, pin_name + name_length);
+        PutU32(plain, Raw(static_cast<int>(pad_height)));
+        PutU32(plain, Raw(static_cast<int>(pad_width)));
+        PutZeros(plain, 18);
+        PutU8(plain, shape);
+        PutZeros(plain, 5);
+        PutU32(plain, RandomNet());
+    }
+    stats.pins += plan.pin_count;
+
+    PatchU32(plain, 0, static_cast<uint32_t>(plain.size()));
+    plain.resize((plain.size() + 7) & ~static_cast<size_t>(7), 0);
+    EncryptInPlace(plain);
+
+    std::vector<uint8_t> block_header;
+    PutU8(block_header, 0x07);
+    PutU32(block_header, static_cast<uint32_t>(plain.size()));
+    sink.Write(block_header);
+    sink.Write(plain);
+}
+
+void XZZPCBGenerator::WriteTestPad(Sink& sink, uint32_t pad_index) {
+    std::vector<uint8_t> payload;
+    std::string name = "TP" + std::to_string(pad_index + 1);
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint8_t shape = RandomShape(width, height);
+
+    PutU32(payload, pad_index + 1);
+    PutU32(payload, Raw(static_cast<int>(NextRandom() % static_cast<uint32_t>(board_width))));
+    PutU32(payload, Raw(static_cast<int>(NextRandom() % static_cast<uint32_t>(board_height))));
+    PutU32(payload, Raw(4));           // Inner diameter
+    PutU32(payload, 0);                // Rotation
+    PutU32(payload, static_cast<uint32_t>(name.size()));
+    PutString(payload, name);
+    PutU32(payload, Raw(static_cast<int>(width)));
+    PutU32(payload, Raw(static_cast<int>(height)));
+    PutU8(payload, shape);
+    PutZeros(payload, 3);
+    PutU32(payload, RandomNet());      // Read from 12 bytes before the end
+    PutZeros(payload, 8);
+
+    std::vector<uint8_t> block;
+    PutU8(block, 0x09);
+    PutU32(block, static_cast<uint32_t>(payload.size()));
+    block.insert(block.end(), payload.begin(), payload.end());
+    sink.Write(block);
+}
+
+void XZZPCBGenerator::WriteJsonTrailer(Sink& sink) {
+    std::string json = "{\"part\":[";
+    bool first = true;
+    // Every 10th part gets an alias and diode readings for its first pins
+    for (uint32_t i = 0; i < parts.size() && stats.aliases < 10000; i += 10) {
+        std::string name = GetPartName(i);
+        json += first ? "" : ",";
+        json += "{\"reference\":\"" + name + "\",\"alias\":\"" + name + "_A\",\"pad\":[";
+        uint32_t pads = std::min<uint32_t>(parts[i].pin_count, 4);
+        for (uint32_t pin = 0; pin < pads; ++pin) {
+            char reading[16];
+            std::snprintf(reading, sizeof(reading), "0.%03u", 300 + NextRandom() % 500);
+            json += (pin ? "," : "");
+            json += "{\"name\":\"" + std::to_string(pin + 1) + "\",\"diode\":\"" + reading + "\"}";
+            stats.diode_readings++;
+        }
+        json += "]}";
+        stats.aliases++;
+        first = false;
+    }
+    json += "]}";
+
+    sink.Write(kJsonMarker, sizeof(kJsonMarker));
+    sink.Write(reinterpret_cast<const uint8_t*>(json.data()), json.size());
+}
+
+void XZZPCBGenerator::WriteDiodeTrailer(Sink& sink) {
+    // Everything from the marker on is stored in the clear
+    sink.SetXorKey(0);
+    std::vector<uint8_t> trailer(kPostV6Marker, kPostV6Marker + sizeof(kPostV6Marker));
+    PutZeros(trailer, 7);   // Bytes the parser skips after the marker
+
+    char line[96];
+    if (options.diode_trailer == DiodeTrailer::ByPart) {
+        PutU8(trailer, 0x0A);
+        for (uint32_t i = 0; i < parts.size() && stats.diode_readings < 100000; i += 5) {
+            std::string name = GetPartName(i);
+            for (uint32_t pin = 0; pin < std::min<uint32_t>(parts[i].pin_count, 2); ++pin) {
+                std::snprintf(line, sizeof(line), "=0.%03u=%s(%u)\n", 300 + NextRandom() % 500, name.c_str(), pin + 1);
+                PutString(trailer, line);
+                stats.diode_readings++;
+            }
+        }
+    } else {
+        PutU8(trailer, 0xCD);
+        PutU8(trailer, 0xBC);
+        for (uint32_t net = 1; net < options.net_count && net <= 100000; net += 3) {
+            std::snprintf(line, sizeof(line), "\r\n%s=0.%03u", GetNetName(net).c_str(), 300 + NextRandom() % 500);
+            PutString(trailer, line);
+            stats.diode_readings++;
+        }
+        PutString(trailer, "\r\n\r\n");
+    }
+    sink.Write(trailer);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Writes synthetic but structurally valid XZZPCB files for benchmarks and parser testing:
+// XOR-obfuscated header with the main/net offsets, a net block, 0x01 arc and 0x05 line
+// board outline blocks, DES-encrypted 0x07 part blocks (0x06 label, 0x05 outline and
+// 0x09 pin sub-blocks), 0x09 test pad blocks and optional JSON and post-v6 diode trailers.
+// The same options and seed always produce the same bytes.
+class XZZPCBGenerator {
+public:
+    enum class DiodeTrailer {
+        None,
+        ByPart,     // Post-v6 type 1: "=reading=PART(pin)"
+        ByNet       // Post-v6 type 2: "NET=reading"
+    };
+
+    struct Options {
+        uint64_t pin_count = 10000;      // Pins in parts (test pads come on top)
+        uint32_t net_count = 2000;
+        uint32_t test_pad_count = 500;
+        int64_t trace_count = -1;        // Inner-layer line blocks the parser skips; -1 = pin_count / 2
+        uint64_t seed = 1;
+
+        // Relative weights of the pad shapes
+        uint32_t circle_weight = 3;
+        uint32_t oval_weight = 1;
+        uint32_t rectangle_weight = 6;
+
+        // Fraction of parts that are many-pin ICs; the rest are 2-4 pin passives
+        double ic_fraction = 0.05;
+        uint32_t max_ic_pins = 256;
+
+        uint8_t xor_key = 0x5A;          // 0 writes a plain (non-obfuscated) file
+        bool json_trailer = false;       // Part aliases and per-pin diode readings
+        DiodeTrailer diode_trailer = DiodeTrailer::None;
+    };
+
+    struct Stats {
+        uint64_t file_bytes = 0;
+        uint32_t parts = 0;
+        uint64_t pins = 0;
+        uint32_t test_pads = 0;
+        uint32_t nets = 0;
+        uint32_t outline_blocks = 0;
+        uint32_t aliases = 0;
+        uint32_t diode_readings = 0;
+        std::vector<uint32_t> part_pins;    // Pins of each part, in file order (test pads excluded)
+    };
+
+    explicit XZZPCBGenerator(const Options& options);
+
+    // Builds the whole file in memory
+    std::vector<char> Generate();
+
+    // Streams the file to disk (boards with millions of pins do not need to fit in memory twice)
+    bool WriteToFile(const std::string& path);
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    class Sink;
+    class VectorSink;
+    class FileSink;
+
+    struct PartPlan {
+        uint32_t pin_count = 0;
+        int x = 0;
+        int y = 0;
+        int pitch = 0;
+    };
+
+    void Run(Sink& sink);
+    void PlanParts();
+    void WriteNetBlock(Sink& sink);
+    void WriteOutline(Sink& sink);
+    void WritePart(Sink& sink, uint32_t part_index, const PartPlan& plan);
+    void WriteTestPad(Sink& sink, uint32_t pad_index);
+    void WriteJsonTrailer(Sink& sink);
+    void WriteDiodeTrailer(Sink& sink);
+
+    uint32_t NextRandom();
+    uint32_t RandomNet();
+    uint8_t RandomShape(uint32_t& width, uint32_t& height);
+    std::string GetPartName(uint32_t part_index) const;
+
+    Options options;
+    Stats stats;
+    uint64_t rng_state = 0;
+    std::vector<PartPlan> parts;
+    int board_width = 0;
+    int board_height = 0;
+    std::vector<uint8_t> part_plain;    // Scratch for one part block before encryption
+};
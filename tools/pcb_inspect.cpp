@@ -0,0 +1,392 @@
+// pcb_inspect: loads many XZZPCB boards in parallel without a window and writes one summary
+// record per file (JSON lines or CSV). Bad files are reported and skipped.
+#include "BoardIndex.h"
+#include "XZZPCBFile.h"
+#include "LoadReport.h"
+#include "Log.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Peak memory of one load relative to the file size: files are streamed, so this is the
+    // parsed board (plus the fixed read window and block buffer)
+    const uint64_t kMemoryPerFileByte = 2;
+
+    enum class OutputFormat { JsonLines, Csv };
+
+    struct InspectOptions {
+        size_t jobs = 0;                        // 0 = one per core
+        uint64_t max_inflight_bytes = 1024ull * 1024 * 1024;
+        OutputFormat format = OutputFormat::JsonLines;
+        bool inventory = false;                 // Part and net lists (JSON only)
+        XZZPCBFile::LoadOptions load;           // --index-only, --lazy-text, --stream-cap-mb
+        bool progress = false;
+    };
+
+    // Admits loads while their estimated memory fits the cap; a file larger than the cap
+    // still runs, but alone
+    class MemoryBudget {
+    public:
+        explicit MemoryBudget(uint64_t limit_bytes) : limit(limit_bytes) {}
+
+        void Acquire(uint64_t bytes) {
+            std::unique_lock<std::mutex> lock(mutex);
+            released.wait(lock, [&] { return in_flight == 0 || in_flight + bytes <= limit; });
+            in_flight += bytes;
+            peak = std::max(peak, in_flight);
+        }
+
+        void Release(uint64_t bytes) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                in_flight -= bytes;
+            }
+            released.notify_all();
+        }
+
+        uint64_t GetPeak() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return peak;
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable released;
+        uint64_t limit = 0;
+        uint64_t in_flight = 0;
+        uint64_t peak = 0;
+    };
+
+    std::string EscapeJson(const std::string& text) {
+        std::string out;
+        out.reserve(text.size() + 2);
+        for (char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                        out += escaped;
+                    } else {
+                        out += c;
+                    }
+                    break;
+            }
+        }
+        return out;
+    }
+
+    std::string EscapeCsv(const std::string& text) {
+        if (text.find_first_of(",\"\r\n") == std::string::npos) {
+            return text;
+        }
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"') {
+                out += '"';
+            }
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    bool HasBoardExtension(const fs::path& path) {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return ext == ".xzz" || ext == ".pcb" || ext == ".xzzpcb";
+    }
+
+    // Files are taken as given; directories are searched recursively for board extensions
+    void CollectInputs(const std::string& input, std::vector<std::string>& files) {
+        std::error_code error;
+        if (!fs::is_directory(input, error)) {
+            files.push_back(input);
+            return;
+        }
+        for (fs::recursive_directory_iterator it(input, fs::directory_options::skip_permission_denied, error), end;
+             !error && it != end; it.increment(error)) {
+            if (it->is_regular_file(error) && HasBoardExtension(it->path())) {
+                files.push_back(it->path().string());
+            }
+        }
+        if (error) {
+            std::cerr << "Error reading directory " << input << ": " << error.message() << std::endl;
+        }
+    }
+
+    std::string GetCsvHeader() {
+        std::string header = "file,success,error,file_bytes,parts,pins,nets,pad_shapes,part_aliases,diode_readings,total_ms";
+        for (size_t i = 0; i < static_cast<size_t>(LoadPhase::Count); ++i) {
+            header += std::string(",") + LoadReport::GetPhaseName(static_cast<LoadPhase>(i)) + "_ms";
+        }
+        return header + "\n";
+    }
+
+    std::string FormatCsv(const LoadReport& report) {
+        std::ostringstream out;
+        out << EscapeCsv(report.file_path) << ',' << (report.success ? 1 : 0) << ',' << EscapeCsv(report.error) << ','
+            << report.file_bytes << ',' << report.parts << ',' << report.pins << ',' << report.nets << ','
+            << report.pad_shapes << ',' << report.part_aliases << ',' << report.diode_readings;
+        char number[32];
+        std::snprintf(number, sizeof(number), ",%.3f", report.total_ms);
+        out << number;
+        for (double ms : report.phase_ms) {
+            std::snprintf(number, sizeof(number), ",%.3f", ms);
+            out << number;
+        }
+        out << '\n';
+        return out.str();
+    }
+
+    // Part names with pin counts, and net names with pin counts (sorted by name)
+    std::string FormatInventory(const BRDFileBase& board) {
+        BoardIndex index(board);
+        std::ostringstream out;
+        out << ",\"inventory\":{\"parts\":[";
+        for (size_t i = 0; i < board.parts.size(); ++i) {
+            out << (i ? "," : "") << "{\"name\":\"" << EscapeJson(std::string(board.GetString(board.parts[i].name)))
+                << "\",\"pins\":" << index.GetPartPins(static_cast<uint32_t>(i)).count << '}';
+        }
+        out << "],\"nets\":[";
+        for (uint32_t net = 0; net < index.GetNetCount(); ++net) {
+            out << (net ? "," : "") << "{\"name\":\"" << EscapeJson(index.GetNetName(net))
+                << "\",\"pins\":" << index.GetNetPins(net).count << '}';
+        }
+        out << "]}";
+        return out.str();
+    }
+
+    std::string FormatJsonLine(const LoadReport& report, const BRDFileBase* board, bool inventory) {
+        std::string line = "{\"load\":" + report.ToJson(0);
+        if (inventory && board) {
+            line += FormatInventory(*board);
+        }
+        return line + "}\n";
+    }
+
+    // Loads one file and formats its record; never throws
+    std::string InspectFile(const std::string& path, const InspectOptions& options, bool& success) {
+        LoadReport report;
+        std::unique_ptr<XZZPCBFile> board;
+        try {
+            board = XZZPCBFile::LoadFromFile(path, &report, options.load);
+            if (board && options.inventory) {
+                // The inventory lists every part: parse the deferred ones after the timed load
+                board->LoadAllPendingParts();
+            }
+        } catch (const std::exception& e) {
+            board.reset();
+            report.file_path = path;
+            report.success = false;
+            report.error = std::string("Exception: ") + e.what();
+        }
+        success = board != nullptr && report.success;
+        if (report.file_path.empty()) {
+            report.file_path = path;
+        }
+        if (!success && report.error.empty()) {
+            report.error = "Load failed";
+        }
+
+        try {
+            if (options.format == OutputFormat::Csv) {
+                return FormatCsv(report);
+            }
+            return FormatJsonLine(report, board.get(), options.inventory);
+        } catch (const std::exception& e) {
+            success = false;
+            return options.format == OutputFormat::Csv
+                ? EscapeCsv(path) + ",0," + EscapeCsv(e.what()) + "\n"
+                : "{\"load\":{\"file\":\"" + EscapeJson(path) + "\",\"success\":false,\"error\":\"" + EscapeJson(e.what()) + "\"}}\n";
+        }
+    }
+
+    void PrintUsage() {
+        std::printf(
+            "Usage: pcb_inspect [options] <file|directory>...\n"
+            "  --list <path>          Read input paths from a file (one per line)\n"
+            "  -o, --output <path>    Write records to a file instead of stdout\n"
+            "  --format <jsonl|csv>   Record format (default jsonl)\n"
+            "  --inventory            Add part and net lists to JSON records\n"
+            "  --index-only           Index part blocks without parsing them (time to first frame)\n"
+            "  --lazy-text            Keep no pin text; read it back from the file when asked for\n"
+            "  -j, --jobs <n>         Parallel loads (default: one per core)\n"
+            "  --max-inflight-mb <n>  Memory cap for boards being loaded (default 1024)\n"
+            "  --stream-cap-mb <n>    Largest block/trailer one load buffers (default 64)\n"
+            "  --progress             Print progress to stderr\n"
+            "  --log-level <debug|info|warning|error|off>  Loader log output (default off)\n"
+            "Directories are searched recursively for .xzz, .pcb and .xzzpcb files.\n"
+            "Exit status: 0 all files loaded, 2 some files failed, 1 usage or output error.\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    InspectOptions options;
+    std::vector<std::string> inputs;
+    std::string output_path;
+    Log::SetLevel(LogLevel::Off);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if ((arg == "-o" || arg == "--output") && has_value) {
+            output_path = argv[++i];
+        } else if (arg == "--list" && has_value) {
+            std::ifstream list(argv[++i]);
+            if (!list.is_open()) {
+                std::fprintf(stderr, "Cannot read list %s\n", argv[i]);
+                return 1;
+            }
+            std::string line;
+            while (std::getline(list, line)) {
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (!line.empty()) {
+                    inputs.push_back(line);
+                }
+            }
+        } else if (arg == "--format" && has_value) {
+            std::string format = argv[++i];
+            if (format == "jsonl" || format == "json") {
+                options.format = OutputFormat::JsonLines;
+            } else if (format == "csv") {
+                options.format = OutputFormat::Csv;
+            } else {
+                std::fprintf(stderr, "Invalid --format value: %s\n", format.c_str());
+                return 1;
+            }
+        } else if (arg == "--index-only") {
+            options.load.mode = XZZPCBFile::LoadMode::IndexOnly;
+        } else if (arg == "--lazy-text") {
+            options.load.lazy_text = true;
+        } else if (arg == "--inventory") {
+            options.inventory = true;
+        } else if ((arg == "-j" || arg == "--jobs") && has_value) {
+            options.jobs = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--max-inflight-mb" && has_value) {
+            options.max_inflight_bytes = std::strtoull(argv[++i], nullptr, 10) * 1024 * 1024;
+        } else if (arg == "--stream-cap-mb" && has_value) {
+            options.load.stream_memory_cap = std::strtoull(argv[++i], nullptr, 10) * 1024 * 1024;
+        } else if (arg == "--progress") {
+            options.progress = true;
+        } else if (arg == "--log-level" && has_value) {
+            LogLevel level;
+            if (!Log::ParseLevel(argv[++i], level)) {
+                std::fprintf(stderr, "Invalid --log-level value: %s\n", argv[i]);
+                return 1;
+            }
+            Log::SetLevel(level);
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+            PrintUsage();
+            return 1;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) {
+        CollectInputs(input, files);
+    }
+    if (files.empty()) {
+        PrintUsage();
+        return 1;
+    }
+    if (options.inventory && options.format == OutputFormat::Csv) {
+        std::fprintf(stderr, "--inventory is only written in JSON records\n");
+    }
+
+    std::ofstream output_file;
+    std::ostream* output = &std::cout;
+    if (!output_path.empty()) {
+        output_file.open(output_path, std::ios::binary);
+        if (!output_file.is_open()) {
+            std::fprintf(stderr, "Cannot write %s\n", output_path.c_str());
+            return 1;
+        }
+        output = &output_file;
+    }
+    if (options.format == OutputFormat::Csv) {
+        *output << GetCsvHeader();
+    }
+
+    size_t jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    ThreadPool pool(jobs);
+    MemoryBudget budget(options.max_inflight_bytes);
+    std::mutex output_mutex;
+    std::atomic<size_t> done{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<uint64_t> total_bytes{0};
+    auto start = std::chrono::steady_clock::now();
+
+    // The producer waits for memory before queueing, so at most the cap is in flight and the
+    // queue never holds more than the files that fit
+    for (const std::string& path : files) {
+        std::error_code error;
+        uint64_t file_bytes = fs::file_size(path, error);
+        if (error) {
+            file_bytes = 0;
+        }
+        uint64_t estimate = file_bytes * kMemoryPerFileByte;
+        budget.Acquire(estimate);
+        pool.Enqueue([&, path, file_bytes, estimate] {
+            bool success = false;
+            std::string record = InspectFile(path, options, success);
+            budget.Release(estimate);
+
+            total_bytes += file_bytes;
+            if (!success) {
+                failed++;
+            }
+            size_t finished = ++done;
+            std::lock_guard<std::mutex> lock(output_mutex);
+            *output << record;
+            if (options.progress && (finished % 100 == 0 || finished == files.size())) {
+                std::fprintf(stderr, "\r%zu / %zu files (%zu failed)", finished, files.size(), failed.load());
+            }
+        });
+    }
+    pool.WaitIdle();
+    output->flush();
+    Log::Flush();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double megabytes = total_bytes.load() / (1024.0 * 1024.0);
+    std::fprintf(stderr, "%s%zu files, %zu failed, %.1f MB in %.2f s (%.1f MB/s, %.1f files/s, %zu jobs, peak in-flight estimate %.0f MB)\n",
+                 options.progress ? "\n" : "", files.size(), failed.load(), megabytes, seconds,
+                 seconds > 0.0 ? megabytes / seconds : 0.0, seconds > 0.0 ? files.size() / seconds : 0.0, jobs,
+                 budget.GetPeak() / (1024.0 * 1024.0));
+
+    if (!output->good()) {
+        std::fprintf(stderr, "Error writing records\n");
+        return 1;
+    }
+    return failed.load() ? 2 : 0;
+}
@@ -0,0 +1,99 @@
+// Command line front end for XZZPCBGenerator: writes synthetic XZZPCB boards of any size
+#include "XZZPCBGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void PrintUsage() {
+    std::printf(
+        "Usage: xzzpcb_generator [options] -o <output.xzzpcb>\n"
+        "  --pins <n>           Pins in parts (default 10000; 1k..5M is the intended range)\n"
+        "  --nets <n>           Net count (default 2000)\n"
+        "  --test-pads <n>      Test pad blocks (default 500)\n"
+        "  --traces <n>         Inner-layer line blocks (default pins / 2)\n"
+        "  --shapes <c:o:r>     Circle:oval:rectangle pad weights (default 3:1:6)\n"
+        "  --ic-fraction <f>    Fraction of parts that are ICs (default 0.05)\n"
+        "  --seed <n>           Random seed (default 1)\n"
+        "  --xor-key <n>        Header XOR key, 0 for a plain file (default 90)\n"
+        "  --json               Add a JSON trailer with part aliases and diode readings\n"
+        "  --diodes <none|part|net>  Add a post-v6 diode reading trailer (default none)\n");
+}
+
+int main(int argc, char* argv[]) {
+    XZZPCBGenerator::Options options;
+    std::string output_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if ((arg == "-o" || arg == "--output") && has_value) {
+            output_path = argv[++i];
+        } else if (arg == "--pins" && has_value) {
+            options.pin_count = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--nets" && has_value) {
+            options.net_count = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--test-pads" && has_value) {
+            options.test_pad_count = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--traces" && has_value) {
+            options.trace_count = std::strtoll(argv[++i], nullptr, 10);
+        } else if (arg == "--shapes" && has_value) {
+            unsigned circle = 0, oval = 0, rectangle = 0;
+            if (std::sscanf(argv[++i], "%u:%u:%u", &circle, &oval, &rectangle) != 3) {
+                std::fprintf(stderr, "Invalid --shapes value: %s\n", argv[i]);
+                return 1;
+            }
+            options.circle_weight = circle;
+            options.oval_weight = oval;
+            options.rectangle_weight = rectangle;
+        } else if (arg == "--ic-fraction" && has_value) {
+            options.ic_fraction = std::atof(argv[++i]);
+        } else if (arg == "--seed" && has_value) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--xor-key" && has_value) {
+            options.xor_key = static_cast<uint8_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (arg == "--json") {
+            options.json_trailer = true;
+        } else if (arg == "--diodes" && has_value) {
+            std::string mode = argv[++i];
+            if (mode == "none") {
+                options.diode_trailer = XZZPCBGenerator::DiodeTrailer::None;
+            } else if (mode == "part") {
+                options.diode_trailer = XZZPCBGenerator::DiodeTrailer::ByPart;
+            } else if (mode == "net") {
+                options.diode_trailer = XZZPCBGenerator::DiodeTrailer::ByNet;
+            } else {
+                std::fprintf(stderr, "Invalid --diodes value: %s\n", mode.c_str());
+                return 1;
+            }
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (output_path.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    XZZPCBGenerator generator(options);
+    if (!generator.WriteToFile(output_path)) {
+        std::fprintf(stderr, "Failed to write %s\n", output_path.c_str());
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const XZZPCBGenerator::Stats& stats = generator.GetStats();
+    std::printf("Wrote %s: %.1f MB, %u parts, %llu pins, %u test pads, %u nets, %u aliases, %u diode readings (%.2f s)\n",
+                output_path.c_str(), stats.file_bytes / (1024.0 * 1024.0), stats.parts,
+                static_cast<unsigned long long>(stats.pins), stats.test_pads, stats.nets, stats.aliases,
+                stats.diode_readings, seconds);
+    return 0;
+}